@@ -260,6 +260,15 @@ export default function MainPage({ centerAlign, emergencyEjection }: MainPagePro
       handleSaveToFirebase(lastMessage.record);
     } else if (lastMessage.type === 'command_success') {
       toast.success(lastMessage.message);
+    } else if (lastMessage.type === 'command_ack') {
+      // 지상국 업링크 재전송 결과 (로켓 텔레메트리 ack 기준)
+      const { code, result, tries, latencyMs } = lastMessage.data;
+      const name = code === 'E' ? '비상 사출' : '중앙 정렬';
+      if (result === 'acked') {
+        toast.success(`${name} 명령 로켓 수신 확인 (${latencyMs}ms, ${tries}회 송신)`);
+      } else {
+        toast.error(`${name} 명령 확인 실패 (${tries}회 송신)`);
+      }
     } else if (lastMessage.type === 'error') {
       toast.error(lastMessage.message);
     }
@@ -1,64 +1,47 @@
+// server.js 테스트용 가짜 지상국: 랜덤 값으로 TELEM 프레임 (groundLink.h, rocket/libraries/RocketCommon)
+#include <groundLink.h>
 
+GlTx tx;
 
-struct __attribute__((packed)) FlightDataPacket {
-  // 시작을 알리는 Sync Byte (1 byte)
-  const uint8_t start_byte = 0xAA;
-
-  // 데이터 필드 (42 bytes)
-  float roll;
-  float pitch;
-  float yaw;
-  float lat;
-  float lon;
-  float alt;
-  float temp;
-  float hum;
-  float speed;
-  float pressure;
-  uint8_t para;  // 0 or 1
-  uint8_t phase; // FlightState enum 값
-
-  // 간단한 체크섬 (모든 데이터 바이트를 더한 값) (1 byte)
-  uint8_t checksum;
-}; // 총 44 바이트
-
-// 패킷 생성 및 전송
+// 패킷 생성 및 전송 (지상국처럼 100ms 샘플 5개를 프레임 하나로)
 void sendData() {
-  FlightDataPacket packet;
-
-  // 랜덤 값으로 센서 데이터 채우기
-  packet.roll = random(-18000, 18000) / 100.0;
-  packet.pitch = random(-18000, 18000) / 100.0;
-  packet.yaw = random(0, 36000) / 100.0;
-  packet.lat = random(37000000, 38000000) / 1000000.0;
-  packet.lon = random(126000000, 127000000) / 1000000.0;
-  packet.alt = random(0, 50000) / 100.0;
-  packet.temp = random(1000, 3000) / 100.0;
-  packet.hum = random(2000, 8000) / 100.0;
-  packet.para = random(0, 2);   // 0 or 1
-  packet.phase = random(0, 7);  // 0 to 6 (FlightState)
-  packet.pressure = random(500, 1000);   
-  packet.speed = random(0, 100); 
-
-  // 체크섬 계산
-  packet.checksum = 0;
-  uint8_t* bytes = (uint8_t*)&packet;
-  // start_byte는 제외하고 checksum 필드 전까지 더합니다.
-  for (size_t i = 1; i < sizeof(packet) - 1; ++i) {
-    packet.checksum += bytes[i];
+  const uint8_t n = 5;
+  glBegin(tx, GL_MSG_TELEM);
+  uint8_t* f = tx.frame;
+  int& i = tx.n;
+
+  push_u32_le(f, i, millis());
+  f[i++] = 10;                                   // 간격 100ms
+  f[i++] = n;
+  f[i++] = 0;                                    // 버튼 플래그
+  push_u32_le(f, i, random(370000000, 380000000));  // lat E7
+  push_u32_le(f, i, random(1260000000, 1270000000)); // lon E7
+  push_i16_le(f, i, random(1000, 3000));         // temp 0.01C
+  push_u16_le(f, i, random(9500, 10300));        // 기압 0.1hPa
+  push_u16_le(f, i, random(0, 10000));           // 속도 cm/s
+  f[i++] = random(0, 2);                         // connect
+  push_i16_le(f, i, random(-120, -30));          // RSSI
+  f[i++] = (uint8_t)(int8_t)random(-10, 12);     // SNR
+
+  for (uint8_t k = 0; k < n; k++) {
+    push_i16_le(f, i, random(-18000, 18000));    // roll 0.01deg
+    push_i16_le(f, i, random(-18000, 18000));    // pitch
+    push_i16_le(f, i, random(0, 36000));         // yaw
+    push_u16_le(f, i, random(0, 5000));          // alt 0.1m
+    f[i++] = random(0, 7) * 10 + random(0, 2);   // phase*10 + para
   }
 
-  // 시리얼 포트로 패킷 전송
-  Serial.write((uint8_t*)&packet, sizeof(packet));
+  // 시리얼 포트로 프레임 전송
+  Serial.write(tx.wire, glFinish(tx));
 }
 
 void setup() {
   // 효율을 위해 통신 속도를 높입니다. server.js와 동일하게 맞춰야 합니다.
-  Serial.begin(115200); 
+  Serial.begin(115200);
   randomSeed(analogRead(0));
 }
 
 void loop() {
   sendData();
-  delay(100); // 0.1초마다 전송
+  delay(500); // 0.5초마다 전송
 }
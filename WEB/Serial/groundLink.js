@@ -0,0 +1,192 @@
+// 지상국(groundMain) -> PC USB 프레임 디코더
+// 형식은 rocket/libraries/RocketCommon/src/groundLink.h 참고
+//  - 0x00으로 끝나는 COBS 블록 = 프레임 하나
+//  - 프레임: VER MSG SEQ(u16) | PAYLOAD | CRC16(CCITT-FALSE), little-endian
+
+const GL_VER = 1;
+const GL_MSG_TELEM = 0x01;
+const GL_MSG_TEXT = 0x02;
+const GL_MSG_CMD = 0x03;
+const GL_MSG_POS = 0x04;
+const GL_POS_LEN = 21;
+const GL_TELEM_HDR_LEN = 25;
+const GL_SAMPLE_LEN = 9;
+const GL_FLAG_EJECT_BTN = 0x01;
+const GL_FLAG_SOUND_BTN = 0x02;
+const GL_CMD_RESULTS = ['acked', 'timeout', 'replaced'];
+const GL_WIRE_MAX = 512; // 이보다 긴데 0x00이 없으면 쓰레기로 보고 버림
+
+const CRC16_TABLE = (() => {
+  const t = new Uint16Array(256);
+  for (let i = 0; i < 256; i++) {
+    let c = i << 8;
+    for (let b = 0; b < 8; b++) c = (c & 0x8000) ? ((c << 1) ^ 0x1021) & 0xFFFF : (c << 1) & 0xFFFF;
+    t[i] = c;
+  }
+  return t;
+})();
+
+const crc16 = (buf, len) => {
+  let crc = 0xFFFF;
+  for (let i = 0; i < len; i++) crc = ((crc << 8) & 0xFFFF) ^ CRC16_TABLE[((crc >> 8) ^ buf[i]) & 0xFF];
+  return crc;
+};
+
+// 실패 시 null
+const cobsDecode = (src) => {
+  const out = Buffer.alloc(src.length);
+  let o = 0;
+  let i = 0;
+  while (i < src.length) {
+    const code = src[i++];
+    if (code === 0 || i + code - 1 > src.length) return null;
+    for (let j = 1; j < code; j++) out[o++] = src[i++];
+    if (code < 0xFF && i < src.length) out[o++] = 0;
+  }
+  return out.subarray(0, o);
+};
+
+// 샘플마다 프론트엔드 telemetry 객체 하나
+const decodeTelem = (p, seq) => {
+  if (p.length < GL_TELEM_HDR_LEN) return null;
+  const n = p[5];
+  if (p.length !== GL_TELEM_HDR_LEN + n * GL_SAMPLE_LEN) return null;
+
+  const t0 = p.readUInt32LE(0);
+  const dtMs = p[4] * 10;
+  const flags = p[6];
+  const connect = p[21];
+  const now = Date.now();
+  const samples = [];
+  for (let i = 0; i < n; i++) {
+    const s = GL_TELEM_HDR_LEN + i * GL_SAMPLE_LEN;
+    const phaseChute = p[s + 8];
+    let sampleConnect = connect;
+    let para = phaseChute % 10;
+    // 지상국 버튼은 첫 샘플에만 표시 (예전 44B 패킷과 같은 값)
+    if (i === 0 && (flags & GL_FLAG_SOUND_BTN)) sampleConnect = connect === 1 ? 3 : 2;
+    if (i === 0 && (flags & GL_FLAG_EJECT_BTN)) para = 2;
+    samples.push({
+      timestamp: now - (n - 1 - i) * dtMs,
+      rocketTimeMs: t0 ? t0 + i * dtMs : null,
+      seq,
+      roll: p.readInt16LE(s) / 100,
+      pitch: p.readInt16LE(s + 2) / 100,
+      yaw: p.readInt16LE(s + 4) / 100,
+      latitude: p.readInt32LE(7) / 1e7,
+      longitude: p.readInt32LE(11) / 1e7,
+      altitude: p.readUInt16LE(s + 6) / 10,
+      temperature: p.readInt16LE(15) / 100,
+      pressure: p.readUInt16LE(17) / 10,
+      speed: p.readUInt16LE(19) / 100,
+      connect: sampleConnect,
+      parachuteStatus: para,
+      flightPhase: Math.floor(phaseChute / 10),
+      rssi: p.readInt16LE(22),
+      snr: p.readInt8(24),
+      battery: 100, // 임시
+    });
+  }
+  return samples;
+};
+
+// 착지 후 위치 (자세/기압 없음). 화면에는 마지막 텔레메트리에 덮어써서 씀
+const decodePos = (p, seq) => {
+  if (p.length !== GL_POS_LEN) return null;
+  const phaseChute = p[17];
+  return {
+    timestamp: Date.now(),
+    rocketTimeMs: p.readUInt32LE(0),
+    seq,
+    latitude: p.readInt32LE(4) / 1e7,
+    longitude: p.readInt32LE(8) / 1e7,
+    gpsAltitude: p.readInt16LE(12),
+    sats: p[14],
+    gpsFix: p[15] === 1,
+    connect: p[16],
+    parachuteStatus: phaseChute % 10,
+    flightPhase: Math.floor(phaseChute / 10),
+    rssi: p.readInt16LE(18),
+    snr: p.readInt8(20),
+  };
+};
+
+// onTelem(samples), onText(line), onCmd(결과), onPos(위치). stats는 외부에서 읽음
+const createGroundLinkParser = ({ onTelem, onText, onCmd, onPos }) => {
+  const stats = {
+    framesOk: 0,
+    crcFail: 0,
+    badFrames: 0,   // COBS/VER/길이 불량
+    seqGaps: 0,
+    framesLost: 0,  // SEQ로 센 빠진 프레임 수
+    bytesSkipped: 0,
+  };
+  let lastSeq = null;
+  let pending = Buffer.alloc(0);
+
+  const onFrame = (wire) => {
+    const f = cobsDecode(wire);
+    if (!f || f.length < 6 || f[0] !== GL_VER) {
+      stats.badFrames++;
+      stats.bytesSkipped += wire.length;
+      return;
+    }
+    const bodyLen = f.length - 2;
+    if (crc16(f, bodyLen) !== f.readUInt16LE(bodyLen)) {
+      stats.crcFail++;
+      return;
+    }
+    const msg = f[1];
+    const seq = f.readUInt16LE(2);
+    if (lastSeq !== null) {
+      const gap = (seq - ((lastSeq + 1) & 0xFFFF)) & 0xFFFF;
+      if (gap !== 0) {
+        stats.seqGaps++;
+        if (gap < 0x8000) stats.framesLost += gap;  // 반 바퀴 이상이면 지상국 리셋으로 봄
+      }
+    }
+    lastSeq = seq;
+    stats.framesOk++;
+
+    const payload = f.subarray(4, bodyLen);
+    if (msg === GL_MSG_TELEM) {
+      const samples = decodeTelem(payload, seq);
+      if (samples) onTelem(samples);
+      else stats.badFrames++;
+    } else if (msg === GL_MSG_POS) {
+      const pos = decodePos(payload, seq);
+      if (!pos) stats.badFrames++;
+      else if (onPos) onPos(pos);
+    } else if (msg === GL_MSG_TEXT) {
+      onText(payload.toString('ascii'));
+    } else if (msg === GL_MSG_CMD && payload.length === 8) {
+      // 업링크 명령 결과: 지연은 지상국 첫 송신 -> 로켓 ack가 실린 텔레메트리 수신
+      if (onCmd) onCmd({
+        code: String.fromCharCode(payload[0]),
+        id: payload[1],
+        result: GL_CMD_RESULTS[payload[2]] || 'unknown',
+        tries: payload[3],
+        latencyMs: payload.readUInt32LE(4),
+      });
+    }
+  };
+
+  const push = (chunk) => {
+    let buf = pending.length ? Buffer.concat([pending, chunk]) : chunk;
+    let start = 0;
+    let z;
+    while ((z = buf.indexOf(0, start)) >= 0) {
+      if (z > start) onFrame(buf.subarray(start, z));
+      start = z + 1;
+    }
+    pending = Buffer.from(buf.subarray(start));
+    if (pending.length > GL_WIRE_MAX) {
+      stats.bytesSkipped += pending.length;
+      pending = Buffer.alloc(0);
+    }
+  };
+
+  return { push, stats };
+};
+
+module.exports = { createGroundLinkParser, cobsDecode, crc16 };
@@ -11,6 +11,7 @@ const { SerialPort } = require('serialport');
 const { ReadlineParser } = require('@serialport/parser-readline');
 const fs = require('fs');
 const path = require('path');
+const { createGroundLinkParser } = require('./groundLink');
 
 const app = express();
 app.use(cors()); // CORS 미들웨어 적용
@@ -175,9 +176,36 @@ const BAUD_RATE = 115200; // 아두이노와 동일하게 설정
 
 let serialPort;
 
-let rxBuffer = Buffer.alloc(0);
-const EXPECTED_PACKET_LEN = 44;
-const SYNC_BYTE = 0xAA;
+// 샘플마다 브로드캐스트, 빠진 프레임은 SEQ로 정확히 셈
+let lastTelemetry = null;
+const groundLink = createGroundLinkParser({
+  onTelem: (samples) => samples.forEach((s) => {
+    lastTelemetry = s;
+    broadcastData(s);
+  }),
+  // 착지 후에는 위치만 옴: 마지막 자세/고도는 그대로 두고 위치/상태만 바꿔서
+  onPos: (pos) => {
+    lastTelemetry = { ...(lastTelemetry || { roll: 0, pitch: 0, yaw: 0, altitude: 0, battery: 100 }), ...pos };
+    broadcastData(lastTelemetry);
+  },
+  onText: (line) => console.log('[지상국]', line),
+  onCmd: (cmd) => {
+    console.log('[지상국] 업링크 명령', JSON.stringify(cmd));
+    wss.clients.forEach((client) => {
+      if (client.readyState === WebSocket.OPEN) {
+        client.send(JSON.stringify({ type: 'command_ack', data: cmd }));
+      }
+    });
+  },
+});
+let lastLinkLost = 0;
+setInterval(() => {
+  const st = groundLink.stats;
+  if (st.framesLost + st.crcFail !== lastLinkLost) {
+    lastLinkLost = st.framesLost + st.crcFail;
+    console.warn('지상국 링크 손실:', JSON.stringify(st));
+  }
+}, 1000);
 
 
 // 시뮬레이션 데이터 생성 함수 (프론트엔드 형식에 맞춤)
@@ -233,71 +261,8 @@ try {
     setInterval(() => broadcastData(createTestData()), 500);
   });
 
-  // 아두이노에서 바이너리 데이터 수신
-  serialPort.on('data', (chunk) => {
-    // 들어온 데이터를 누적
-    rxBuffer = Buffer.concat([rxBuffer, chunk]);
-    // 패킷 단위로 처리
-    while (rxBuffer.length >= EXPECTED_PACKET_LEN) {
-      // sync byte 찾기
-      const syncIndex = rxBuffer.indexOf(SYNC_BYTE);
-      if (syncIndex < 0) {
-        // sync 못 찾으면 전부 버림
-        rxBuffer = Buffer.alloc(0);
-        return;
-      }
-
-      // sync 앞의 쓰레기 데이터 제거
-      if (syncIndex > 0) {
-        rxBuffer = rxBuffer.slice(syncIndex);
-      }
-
-      // 아직 패킷 하나 분량 안 되면 대기
-      if (rxBuffer.length < EXPECTED_PACKET_LEN) {
-        return;
-      }
-
-      // 패킷 하나 추출
-      const packet = rxBuffer.slice(0, EXPECTED_PACKET_LEN);
-      rxBuffer = rxBuffer.slice(EXPECTED_PACKET_LEN);
-
-      // 체크섬 검증
-      let checksum = 0;
-      for (let i = 1; i < EXPECTED_PACKET_LEN - 1; i++) {
-        checksum = (checksum + packet[i]) & 0xFF;
-      }
-
-      if (checksum !== packet[EXPECTED_PACKET_LEN - 1]) {
-        console.error("체크섬 오류, 패킷 버림");
-        continue; // 다음 패킷 탐색
-      }
-
-      try {
-        const telemetryData = {
-          timestamp: Date.now(),
-
-          roll: packet.readFloatLE(1),
-          pitch: packet.readFloatLE(5),
-          yaw: packet.readFloatLE(9),
-          latitude: packet.readFloatLE(13),
-          longitude: packet.readFloatLE(17),
-          altitude: packet.readFloatLE(21),
-          temperature: packet.readFloatLE(25),
-          connect: packet.readFloatLE(29),
-          speed: packet.readFloatLE(33),
-          pressure: packet.readFloatLE(37),
-          parachuteStatus: packet.readUInt8(41),
-          flightPhase: packet.readUInt8(42),
-          battery: 100, // 임시
-        };
-
-        broadcastData(telemetryData);
-
-      } catch (e) {
-        console.error("패킷 파싱 에러:", e.message);
-      }
-    }
-  });
+  // 지상국 바이너리 프레임 수신 (groundLink.js: COBS + SEQ + CRC16, 프레임 하나 = LoRa 패킷 하나)
+  serialPort.on('data', (chunk) => groundLink.push(chunk));
 
 
 } catch (error) {
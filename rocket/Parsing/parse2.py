@@ -15,8 +15,15 @@ FLIGHT_STATE = ["STANDBY", "LAUNCHED", "POWERED", "COASTING", "APOGEE", "DESCENT
 # times: 4I
 # state: B
 # timeMs: I
-FMT = "<6f4f2i3fBB5f4IBI"
-REC_SIZE = struct.calcsize(FMT)  # 103이어야 함
+# 뒤에 추가된 필드 (예전 로그(103B)에는 없음)
+#  est(칼만 고도/속도/분산): 4f
+#  apo(예측 최고고도/예측 사출/카운터 하강 시각): 3I
+FMT_V1 = "<6f4f2i3fBB5f4IBI"
+FMT = FMT_V1 + "4f3I"
+REC_SIZE_V1 = struct.calcsize(FMT_V1)  # 103
+REC_SIZE = struct.calcsize(FMT)        # 131
+EXT_COLUMNS = ["est_altitude_m", "est_velocity_mps", "est_altVar", "est_velVar",
+               "apo_predMs", "apo_armMs", "apo_detectMs"]
 
 COLUMNS = [
     # imu
@@ -31,18 +38,275 @@ COLUMNS = [
     "baroTimeMs", "gpsTimeMs", "aTimeMs", "aRxTimeMs",
     # state & time
     "state", "timeMs",
-    # (추가) state string
-    "stateStr",
 ]
 
+# ====== version 2: 델타/varint 압축 (sensorMain/logCodec.h와 같은 순서/배율) ======
+# (필드 이름, 배율) : 배율 None = 정수 그대로 (int32는 부호 있게)
+V2_FIELDS = [
+    ("imu_ax", 100), ("imu_ay", 100), ("imu_az", 100), ("imu_gx", 10), ("imu_gy", 10), ("imu_gz", 10),
+    ("baro_pressure_hPa", 1000), ("baro_temperature_C", 100), ("baro_altitude_m", 100), ("baro_climbRate_mps", 100),
+    ("gps_latE7", "i32"), ("gps_lonE7", "i32"),
+    ("gps_altitude_m", 100), ("gps_speed_mps", 100), ("gps_heading_deg", 100), ("gps_sats", None), ("gps_fix", None),
+    ("roll_deg", 100), ("filterRoll_deg", 100), ("pitch_deg", 100), ("yaw_deg", 100), ("servoDegree_deg", 100),
+    ("baroTimeMs", None), ("gpsTimeMs", None), ("aTimeMs", None), ("aRxTimeMs", None),
+    ("state", None), ("timeMs", None),
+    ("est_altitude_m", 100), ("est_velocity_mps", 100), ("est_altVar", 10000), ("est_velVar", 10000),
+    ("apo_predMs", None), ("apo_armMs", None), ("apo_detectMs", None),
+]
+V2_MASK_BYTES = (len(V2_FIELDS) + 7) // 8
+
+def _s32(u):
+    return u - (1 << 32) if u & 0x80000000 else u
+
+def _varint(buf, i, end):
+    z = 0
+    for n in range(5):
+        if i + n >= end:
+            break
+        b = buf[i + n]
+        z |= (b & 0x7F) << (7 * n)
+        if not b & 0x80:
+            return ((z >> 1) ^ -(z & 1)) & 0xFFFFFFFF, i + n + 1
+    raise ValueError("bad varint")
+
+def iter_v2(buf):
+    """(values, is_key) 생성. 첫 키프레임 전 델타는 건너뜀, erase 영역(0x00/0xFF)이나 이상한 바이트에서 멈춤"""
+    prev = None
+    i = 0
+    while i + 2 <= len(buf):
+        tag, ln = buf[i], buf[i + 1]
+        if tag not in (ord("K"), ord("D")):
+            if tag not in (0x00, 0xFF):
+                print(f"[WARN] 알 수 없는 태그 0x{tag:02X} @ {i} (이후 무시)")
+            return
+        end = i + 2 + ln
+        if end > len(buf):
+            print(f"[WARN] 마지막 레코드가 잘렸습니다. len={len(buf) - i} (무시)")
+            return
+        j = i + 2
+        if tag == ord("K"):
+            cur = []
+            try:
+                for _ in V2_FIELDS:
+                    v, j = _varint(buf, j, end)
+                    cur.append(v)
+            except ValueError:
+                j = -1
+        else:
+            mask = buf[j:j + V2_MASK_BYTES]
+            j += V2_MASK_BYTES
+            cur = list(prev) if prev is not None else [0] * len(V2_FIELDS)
+            for k in range(len(V2_FIELDS)):
+                if j >= 0 and mask[k >> 3] & (1 << (k & 7)):
+                    try:
+                        d, j = _varint(buf, j, end)
+                    except ValueError:
+                        j = -1
+                        break
+                    cur[k] = (cur[k] + d) & 0xFFFFFFFF
+        if j != end:
+            print(f"[WARN] 레코드 길이가 맞지 않습니다 @ {i} (찢어진 마지막 레코드?, 이후 무시)")
+            return
+        i = end
+        if tag == ord("D") and prev is None:
+            continue
+        prev = cur
+        yield cur, tag == ord("K")
+
+def v2_row(q):
+    row = []
+    for (name, scale), u in zip(V2_FIELDS, q):
+        if scale is None:
+            row.append(u)
+        elif scale == "i32":
+            row.append(_s32(u))
+        else:
+            row.append(_s32(u) / scale)
+    return row
+
+def parse_v2_to_csv(f, csv_path: Path, bin_name: str):
+    buf = f.read()
+    n = keys = 0
+    with csv_path.open("w", newline="", encoding="utf-8") as out:
+        w = csv.writer(out)
+        w.writerow(COLUMNS + EXT_COLUMNS + ["stateStr"])
+        for q, is_key in iter_v2(buf):
+            row = v2_row(q)
+            state = row[26]
+            state_str = FLIGHT_STATE[state] if 0 <= state < len(FLIGHT_STATE) else "UNKNOWN"
+            w.writerow(row + [state_str])
+            n += 1
+            keys += is_key
+    print(f"OK: {bin_name} -> {csv_path.name}  (records={n}, keyframes={keys}, version=2)")
+    return 0
+
+# ====== version 3: 종류별 레코드 (sensorMain/logRecords.h) ======
+# TAG(1) LEN(1) TIME(u32) BODY. 레코드마다 직전 값에 덮어쓴 한 행 + rec(종류), event 열
+V3_BODY = {
+    ord("I"): "<I10h",      # aTimeMs, ax ay az(x100) gx gy gz(x10) roll froll pitch yaw(x100)
+    ord("B"): "<Ihih",      # pressure(hPa x1000) temp(x100) alt(cm) climb(cm/s)
+    ord("G"): "<iiiHHBB",   # lat lon alt(cm) speed(cm/s) heading(x100) sats fix
+    ord("S"): "<Bhiiff",    # state servo(x100) estAlt(cm) estVel(cm/s) altVar velVar
+    ord("V"): "<BI",        # code arg
+}
+V3_EVENTS = {1: "BOOT", 2: "STATE", 3: "DEPLOY", 4: "APO_ARM", 5: "APO_DETECT", 6: "LORA_CMD"}
+
+def iter_v3(buf):
+    """(tag, time, body, 위치) 순서대로. erase 영역(0x00/0xFF)이나 잘린 레코드에서 멈춤"""
+    i = 0
+    while i + 6 <= len(buf):
+        tag, ln = buf[i], buf[i + 1]
+        if tag in (0x00, 0xFF):
+            return
+        end = i + 2 + ln
+        if ln < 4 or end > len(buf):
+            print(f"[WARN] 마지막 레코드가 잘렸습니다 @ {i} (무시)")
+            return
+        (t,) = struct.unpack_from("<I", buf, i + 2)
+        yield tag, t, buf[i + 6:end], i
+        i = end
+
+# ====== version 4: v3 레코드 + 프레임 (sensorMain/logFrame.h) ======
+# SYNC(A5 C3) SEQ(u16) 레코드 CRC16(SEQ..레코드 끝, CCITT-FALSE)
+# 깨진 곳은 다음 SYNC로 건너뛰어 다시 맞춤, SEQ 빈 곳은 빠진 레코드로 셈
+V4_SYNC = b"\xA5\xC3"
+
+def _crc16_table():
+    table = []
+    for i in range(256):
+        crc = i << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+        table.append(crc & 0xFFFF)
+    return table
+
+_CRC16 = _crc16_table()
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc = ((crc << 8) & 0xFFFF) ^ _CRC16[(crc >> 8) ^ b]
+    return crc
+
+def _v4_frame(buf, i):
+    """i가 맞는 프레임이면 (seq, 레코드 끝), 아니면 None"""
+    if buf[i:i + 2] != V4_SYNC or i + 6 > len(buf):
+        return None
+    ln = buf[i + 5]
+    end = i + 6 + ln
+    if ln < 4 or end + 2 > len(buf):
+        return None
+    if crc16_ccitt(buf[i + 2:end]) != struct.unpack_from("<H", buf, end)[0]:
+        return None
+    return struct.unpack_from("<H", buf, i + 2)[0], end
+
+def iter_v4(buf, stats):
+    # 뒤쪽 erase 영역 (같은 값 0x00 또는 0xFF)
+    tail = len(buf)
+    if tail and buf[-1] in (0x00, 0xFF):
+        tail = len(buf.rstrip(bytes([buf[-1]])))
+    i = 0
+    expect = None
+    while i < tail:
+        fr = _v4_frame(buf, i)
+        if fr is None:
+            j = buf.find(V4_SYNC, i + 1, tail)
+            while j >= 0 and _v4_frame(buf, j) is None:
+                j = buf.find(V4_SYNC, j + 1, tail)
+            if j < 0:
+                if i < tail:
+                    print(f"[WARN] 마지막 프레임이 잘렸습니다 @ {i} ({tail - i} B, 무시)")
+                return
+            stats["resyncs"] += 1
+            stats["skipped"] += j - i
+            i = j
+            continue
+        seq, end = fr
+        if expect is not None and seq != expect:
+            stats["lost"] += (seq - expect) & 0xFFFF
+        expect = (seq + 1) & 0xFFFF
+        (t,) = struct.unpack_from("<I", buf, i + 6)
+        yield buf[i + 4], t, buf[i + 10:end], i + 4
+        i = end + 2
+
+def parse_typed_to_csv(f, csv_path: Path, bin_name: str, version: int):
+    buf = f.read()
+    stats = {"resyncs": 0, "skipped": 0, "lost": 0}
+    records = iter_v4(buf, stats) if version == 4 else iter_v3(buf)
+    col = {name: k for k, name in enumerate(COLUMNS + EXT_COLUMNS)}
+    row = [0] * len(col)
+    counts = {}
+    n = 0
+    with csv_path.open("w", newline="", encoding="utf-8") as out:
+        w = csv.writer(out)
+        w.writerow(COLUMNS + EXT_COLUMNS + ["stateStr", "rec", "event"])
+        for tag, t, body, pos in records:
+            fmt = V3_BODY.get(tag)
+            if fmt is None:
+                continue  # 모르는 종류는 건너뜀
+            if struct.calcsize(fmt) != len(body):
+                if version == 4:
+                    continue
+                print(f"[WARN] 레코드 길이가 맞지 않습니다 '{chr(tag)}' @ {pos} (이후 무시)")
+                break
+            v = struct.unpack(fmt, body)
+            event = ""
+            if tag == ord("I"):
+                row[col["aRxTimeMs"]], row[col["aTimeMs"]] = t, v[0]
+                for k, name in enumerate(["imu_ax", "imu_ay", "imu_az"]):
+                    row[col[name]] = v[1 + k] / 100
+                for k, name in enumerate(["imu_gx", "imu_gy", "imu_gz"]):
+                    row[col[name]] = v[4 + k] / 10
+                for k, name in enumerate(["roll_deg", "filterRoll_deg", "pitch_deg", "yaw_deg"]):
+                    row[col[name]] = v[7 + k] / 100
+            elif tag == ord("B"):
+                row[col["baroTimeMs"]] = t
+                row[col["baro_pressure_hPa"]] = v[0] / 1000
+                row[col["baro_temperature_C"]] = v[1] / 100
+                row[col["baro_altitude_m"]] = v[2] / 100
+                row[col["baro_climbRate_mps"]] = v[3] / 100
+            elif tag == ord("G"):
+                row[col["gpsTimeMs"]] = t
+                row[col["gps_latE7"]], row[col["gps_lonE7"]] = v[0], v[1]
+                row[col["gps_altitude_m"]] = v[2] / 100
+                row[col["gps_speed_mps"]] = v[3] / 100
+                row[col["gps_heading_deg"]] = v[4] / 100
+                row[col["gps_sats"]], row[col["gps_fix"]] = v[5], v[6]
+            elif tag == ord("S"):
+                row[col["state"]] = v[0]
+                row[col["servoDegree_deg"]] = v[1] / 100
+                row[col["est_altitude_m"]] = v[2] / 100
+                row[col["est_velocity_mps"]] = v[3] / 100
+                row[col["est_altVar"]], row[col["est_velVar"]] = v[4], v[5]
+            else:
+                code, arg = v
+                event = f"{V3_EVENTS.get(code, code)}:{arg}"
+                if code == 2:
+                    row[col["state"]] = arg
+                elif code == 4:
+                    row[col["apo_armMs"]], row[col["apo_predMs"]] = t, arg
+                elif code == 5:
+                    row[col["apo_detectMs"]] = t
+            row[col["timeMs"]] = t
+            state = row[col["state"]]
+            state_str = FLIGHT_STATE[state] if 0 <= state < len(FLIGHT_STATE) else "UNKNOWN"
+            w.writerow(row + [state_str, chr(tag), event])
+            counts[chr(tag)] = counts.get(chr(tag), 0) + 1
+            n += 1
+    extra = ""
+    if version == 4:
+        extra = f", resyncs={stats['resyncs']}, skipped={stats['skipped']}B, lost={stats['lost']}"
+    print(f"OK: {bin_name} -> {csv_path.name}  (records={n}, {counts}{extra}, version={version})")
+    return 0
+
 def read_header_if_any(f):
     """
     헤더가 있으면 (has_header=True, version, rec_size, data_offset)을 반환.
-    없으면 (False, None, REC_SIZE, 0)
+    없으면 (False, None, REC_SIZE_V1, 0)  (헤더 없는 초기 로그는 103B 레이아웃)
     """
     start = f.read(8)
     if len(start) < 8:
-        return (False, None, REC_SIZE, 0)
+        return (False, None, REC_SIZE_V1, 0)
 
     magic = start[:4]
     if magic == b"RLG1":
@@ -51,14 +315,25 @@ def read_header_if_any(f):
 
     # 헤더가 아니면 파일 포인터를 처음으로 되돌림
     f.seek(0)
-    return (False, None, REC_SIZE, 0)
+    return (False, None, REC_SIZE_V1, 0)
 
 def parse_bin_to_csv(bin_path: Path, csv_path: Path):
     with bin_path.open("rb") as f:
         has_hdr, version, rec_size, offset = read_header_if_any(f)
 
-        if rec_size != REC_SIZE:
-            print(f"[WARN] rec_size mismatch. file rec_size={rec_size}, expected={REC_SIZE}")
+        if has_hdr and version == 2:
+            f.seek(offset)
+            return parse_v2_to_csv(f, csv_path, bin_path.name)
+        if has_hdr and version in (3, 4):
+            f.seek(offset)
+            return parse_typed_to_csv(f, csv_path, bin_path.name, version)
+
+        if rec_size == REC_SIZE:
+            fmt, columns = FMT, COLUMNS + EXT_COLUMNS
+        elif rec_size == REC_SIZE_V1:
+            fmt, columns = FMT_V1, COLUMNS
+        else:
+            print(f"[WARN] rec_size mismatch. file rec_size={rec_size}, expected={REC_SIZE} or {REC_SIZE_V1}")
             print("       구조체가 바뀌었거나, 다른 포맷의 로그일 수 있어요.")
             # 그래도 file rec_size로 읽어보긴 어려움(언팩 포맷은 고정이라)
             # 여기서는 안전하게 종료
@@ -68,25 +343,28 @@ def parse_bin_to_csv(bin_path: Path, csv_path: Path):
 
         with csv_path.open("w", newline="", encoding="utf-8") as out:
             w = csv.writer(out)
-            w.writerow(COLUMNS)
+            w.writerow(columns + ["stateStr"])
 
             n = 0
             while True:
-                chunk = f.read(REC_SIZE)
+                chunk = f.read(rec_size)
                 if not chunk:
                     break
-                if len(chunk) != REC_SIZE:
+                if len(chunk) != rec_size:
                     print(f"[WARN] 마지막 레코드가 잘렸습니다. len={len(chunk)} (무시)")
                     break
+                # 연속 할당 로그: 안 쓴 뒤쪽은 erase 상태 (전부 0x00 또는 0xFF)
+                if chunk.count(chunk[0]) == rec_size and chunk[0] in (0x00, 0xFF):
+                    break
 
-                vals = struct.unpack(FMT, chunk)
+                vals = struct.unpack(fmt, chunk)
 
                 # gps_fix(B) -> bool
                 vals = list(vals)
                 gps_fix = bool(vals[16])  # gps_fix 위치(0-based) 계산 결과: 16
                 vals[16] = int(gps_fix)
 
-                state = vals[-2]  # state는 끝에서 두 번째
+                state = vals[26]  # state 위치(0-based)
                 state_str = FLIGHT_STATE[state] if 0 <= state < len(FLIGHT_STATE) else "UNKNOWN"
 
                 row = vals + [state_str]
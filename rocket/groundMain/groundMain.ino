@@ -1,242 +1,372 @@
-#include <SoftwareSerial.h>
-
-SoftwareSerial lora(2, 3); // RX, TX
+#include <Arduino.h>
+
+// ====== LoRa 수신 ======
+//  SoftwareSerial은 바이트마다 수신 인터럽트 안에서 비트 시간(9600bps 약 1ms)만큼 돌면서 다른 인터럽트를 막음
+//  -> 하드웨어 UART(Serial1)로 받음. Serial1이 있는 보드(Mega 2560 RX1/TX1 등)에 LoRa 모듈 연결
+//  줄은 와 있는 바이트만 넣어서 조립 (loraLine.h), base64는 256칸 역표 (loraBase64.h)
+#ifndef LORA_PORT
+#define LORA_PORT Serial1
+#endif
+#define LORA_LINE_MAX 272   // +RCV=1,240,<240자>,-120,-20 약 265자
+#include <loraLine.h>
+#include <loraBase64.h>
+#include <loraRadio.h>
+#include <loraPacket.h>
+#include <groundLink.h>
+
+LoraLine g_loraLine;
+LoraRxStats g_loraRxSt;
+
+void sendEmergencyDeploy();
+void sendCenter();
+void onUplinkAck(uint8_t ack);
+void uplinkPrintStats();
 
 int ejection = false;
 int sound = false;
-struct __attribute__((packed)) FlightDataPacket {
-  // 시작을 알리는 Sync Byte (1 byte)
-  const uint8_t start_byte = 0xAA;
-
-  // 데이터 필드 (42 bytes)
-  float roll;
-  float pitch;
-  float yaw;
-  float lat;
-  float lon;
-  float alt;
-  float temp;
-  float connect;
-  float speed;
-  float pressure;
-  uint8_t para;  // 0 or 1
-  uint8_t phase; // FlightState enum 값
-
-  // 간단한 체크섬 (모든 데이터 바이트를 더한 값) (1 byte)
-  uint8_t checksum;
-}; // 총 44 바이트
-
-
-const char* b64 =
-  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-int b64Index(char c) {
-  const char* p = strchr(b64, c);
-  return p ? (p - b64) : 0;
-}
 
-int base64Decode(const String& in, uint8_t* out) {
-  int outLen = 0;
-
-  for (int i = 0; i < in.length(); i += 4) {
-    uint32_t n = 0;
-    int pad = 0;
-
-    for (int j = 0; j < 4; j++) {
-      char c = in[i + j];
-      if (c == '=') {
-        n <<= 6;
-        pad++;
-      } else {
-        n = (n << 6) | b64Index(c);
-      }
+// ====== PC로 보내는 프레임 (groundLink.h) ======
+//  예전: 샘플마다 float 44B FlightDataPacket + 8비트 합 체크섬, 기압/속도는 random()
+//  지금: LoRa 패킷 하나를 정수 배율 그대로 TELEM 프레임 하나로 (5샘플 약 80B, USB write 한 번)
+GlTx g_glTx;
+static_assert(GL_TELEM_HDR_LEN + LORA_BATCH_MAX * GL_SAMPLE_LEN <= GL_PAYLOAD_MAX, "LoRa batch > TELEM frame");
+
+// 텍스트를 모았다가 줄 끝에서 TEXT 프레임 하나로 (바이너리 스트림 사이에 평문을 섞지 않음)
+class GlTextOut : public Print {
+public:
+  size_t write(uint8_t c) override {
+    if (c == '\n') {
+      glBegin(g_glTx, GL_MSG_TEXT);
+      memcpy(&g_glTx.frame[g_glTx.n], buf, n);
+      g_glTx.n += n;
+      Serial.write(g_glTx.wire, glFinish(g_glTx));
+      n = 0;
+    } else if (c != '\r' && n < sizeof(buf)) {
+      buf[n++] = c;
     }
-
-    out[outLen++] = (n >> 16) & 0xFF;
-    if (pad < 2) out[outLen++] = (n >> 8) & 0xFF;
-    if (pad < 1) out[outLen++] = n & 0xFF;
+    return 1;
   }
-  return outLen;
-}
+  using Print::write;
 
-// float readFloat(const uint8_t* buf, int& idx) {
-//   union { float f; uint8_t b[4]; } u;
-//   for (int i = 0; i < 4; i++) u.b[i] = buf[idx++];
-//   return u.f;
-// }
+private:
+  uint8_t buf[96];
+  uint8_t n = 0;
+};
+GlTextOut pcText;
 
-int16_t read16(const uint8_t* buf, int& idx) {
-  int16_t v = (buf[idx] << 8) | buf[idx + 1];
-  idx += 2;
-  return v;
+static inline uint16_t rd_u16_be(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static inline uint32_t rd_u32_be(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
 }
 
-int32_t read32(const uint8_t* buf, int& idx) {
-  int32_t v = 0;
-  v |= (int32_t)buf[idx++] << 24;
-  v |= (int32_t)buf[idx++] << 16;
-  v |= (int32_t)buf[idx++] << 8;
-  v |= (int32_t)buf[idx++];
-  return v;
+// TELEM 헤더. 버튼 플래그는 여기서 한 번 보내고 지움
+void beginTelem(uint32_t t0, uint8_t dt10ms, uint8_t n, uint32_t lat, uint32_t lon, uint16_t temp,
+                uint16_t pressure, uint16_t speed, uint8_t connect, const LoraRcv& r) {
+  glBegin(g_glTx, GL_MSG_TELEM);
+  uint8_t* f = g_glTx.frame;
+  int& i = g_glTx.n;
+  push_u32_le(f, i, t0);
+  f[i++] = dt10ms;
+  f[i++] = n;
+  f[i++] = (ejection ? GL_FLAG_EJECT_BTN : 0) | (sound ? GL_FLAG_SOUND_BTN : 0);
+  ejection = false;
+  sound = false;
+  push_u32_le(f, i, lat);
+  push_u32_le(f, i, lon);
+  push_u16_le(f, i, temp);
+  push_u16_le(f, i, pressure);
+  push_u16_le(f, i, speed);
+  f[i++] = connect;
+  push_i16_le(f, i, r.rssi);
+  f[i++] = (uint8_t)r.snr;
 }
 
-void handleLoraRx() { // 로켓으로부터의 텔레메트리 수신 함수
-  if (!lora.available()) return;
-
-  String line = lora.readStringUntil('\n');
-  line.trim();
-  //Serial.println(line);
-
-  if (!line.startsWith("+RCV=")) return;
-
-  int p1 = line.indexOf(',');
-  int p2 = line.indexOf(',', p1 + 1);
-  int p3 = line.indexOf(',', p2 + 1);
-  if (p3 < 0) return;
-
-  String payload = line.substring(p2 + 1, p3);
+void pushSample(uint16_t roll, uint16_t pitch, uint16_t yaw, uint16_t alt10, uint8_t phaseChute) {
+  uint8_t* f = g_glTx.frame;
+  int& i = g_glTx.n;
+  push_u16_le(f, i, roll);
+  push_u16_le(f, i, pitch);
+  push_u16_le(f, i, yaw);
+  push_u16_le(f, i, alt10);
+  f[i++] = phaseChute;
+}
 
-  uint8_t raw[64];
-  int rawLen = base64Decode(payload, raw);
+// +RCV 한 줄 처리. 모듈 응답(+OK 등)은 무시
+void handleLoraLine(char* line) {
+  if (strncmp(line, "+RCV=", 5) != 0) return;
 
-  if (rawLen != 21) {
-    Serial.print("LEN ERROR: ");
-    Serial.println(rawLen);
+  LoraRcv r;
+  if (!loraParseRcv(line, r)) {
+    g_loraRxSt.bad++;
     return;
   }
-
-  if (raw[0] != 0xAA) {
-    Serial.print("SYNC ERROR: ");
-    Serial.println(raw[0], HEX);
+  g_loraRxSt.rcv++;
+  g_loraRxSt.lastRssi = r.rssi;
+  g_loraRxSt.lastSnr = r.snr;
+
+  uint8_t raw[LORA_PAYLOAD_MAX];   // AT+SEND 최대 240자
+  int rawLen = b64Decode(r.data, r.len, raw, sizeof(raw));
+  if (rawLen < 0) {
+    g_loraRxSt.bad++;
+    pcText.print("B64 ERROR: ");
+    pcText.println(r.len);
     return;
-  }  
+  }
 
-  int idx = 1;
+  // 패킷 배치는 로켓과 같이 쓰는 loraPacket.h (묶음 0xAB / 위치 0xAC / 예전 단일 0xAA)
+  // 묶음: 헤더 + 샘플 x N
+  if (rawLen > 0 && raw[0] == LORA_SYNC_BATCH) {
+    uint8_t n = rawLen > LORA_BATCH_OFS_N ? raw[LORA_BATCH_OFS_N] : 0;
+    if (rawLen != LORA_BATCH_HDR_LEN + n * LORA_BATCH_SAMPLE_LEN) {
+      g_loraRxSt.bad++;
+      pcText.print("LEN ERROR: ");
+      pcText.println(rawLen);
+      return;
+    }
+    beginTelem(rd_u32_be(&raw[LORA_BATCH_OFS_T0]), raw[LORA_BATCH_OFS_DT], n, rd_u32_be(&raw[LORA_BATCH_OFS_LAT]),
+               rd_u32_be(&raw[LORA_BATCH_OFS_LON]), rd_u16_be(&raw[LORA_BATCH_OFS_TEMP]),
+               rd_u16_be(&raw[LORA_BATCH_OFS_PRESS]), rd_u16_be(&raw[LORA_BATCH_OFS_SPEED]),
+               raw[LORA_BATCH_OFS_CONNECT], r);
+    for (const uint8_t* s = &raw[LORA_BATCH_HDR_LEN]; s < &raw[rawLen]; s += LORA_BATCH_SAMPLE_LEN)
+      pushSample(rd_u16_be(&s[LORA_SAMPLE_OFS_ROLL]), rd_u16_be(&s[LORA_SAMPLE_OFS_PITCH]),
+                 rd_u16_be(&s[LORA_SAMPLE_OFS_YAW]), rd_u16_be(&s[LORA_SAMPLE_OFS_ALT]), s[LORA_SAMPLE_OFS_PHASE]);
+    Serial.write(g_glTx.wire, glFinish(g_glTx));
+    onUplinkAck(raw[LORA_BATCH_OFS_ACK]);
+    return;
+  }
 
-  // int16_t roll_i  = 
-  // int16_t pitch_i = 
-  // int16_t yaw_i   =
+  // 위치 (착지 후 5초마다)
+  if (rawLen > 0 && raw[0] == LORA_SYNC_POS) {
+    if (rawLen != LORA_POS_LEN) {
+      g_loraRxSt.bad++;
+      pcText.print("LEN ERROR: ");
+      pcText.println(rawLen);
+      return;
+    }
+    glBegin(g_glTx, GL_MSG_POS);
+    uint8_t* f = g_glTx.frame;
+    int& i = g_glTx.n;
+    push_u32_le(f, i, rd_u32_be(&raw[LORA_POS_OFS_T]));
+    push_u32_le(f, i, rd_u32_be(&raw[LORA_POS_OFS_LAT]));
+    push_u32_le(f, i, rd_u32_be(&raw[LORA_POS_OFS_LON]));
+    push_u16_le(f, i, rd_u16_be(&raw[LORA_POS_OFS_ALT]));
+    f[i++] = raw[LORA_POS_OFS_SATS];
+    f[i++] = raw[LORA_POS_OFS_FIX];
+    f[i++] = raw[LORA_POS_OFS_CONNECT];
+    f[i++] = raw[LORA_POS_OFS_PHASE];
+    push_i16_le(f, i, r.rssi);
+    f[i++] = (uint8_t)r.snr;
+    Serial.write(g_glTx.wire, glFinish(g_glTx));
+    onUplinkAck(raw[LORA_POS_OFS_ACK]);
+    return;
+  }
 
-  // int32_t lat_i = read32(raw, idx);
-  // int32_t lon_i = r
+  // 단일 (예전 로켓 펌웨어): 기압/속도/ack 없음 -> 0으로, 업링크 확인에는 안 씀
+  if (rawLen != LORA_LEGACY_LEN) {
+    g_loraRxSt.bad++;
+    pcText.print("LEN ERROR: ");
+    pcText.println(rawLen);
+    return;
+  }
 
-  // uint16_t alt_i = 
-  // int16_t temp_i = 
+  if (raw[0] != LORA_SYNC_LEGACY) {
+    g_loraRxSt.bad++;
+    pcText.print("SYNC ERROR: ");
+    pcText.println(raw[0], HEX);
+    return;
+  }
 
-  // uint8_t hum   = raw[idx++];
-  // uint8_t phase  = 
-  // uint8_t para = 
+  beginTelem(0, 0, 1, rd_u32_be(&raw[LORA_LEGACY_OFS_LAT]), rd_u32_be(&raw[LORA_LEGACY_OFS_LON]),
+             rd_u16_be(&raw[LORA_LEGACY_OFS_TEMP]), 0, 0, raw[LORA_LEGACY_OFS_CONNECT], r);
+  pushSample(rd_u16_be(&raw[LORA_LEGACY_OFS_ROLL]), rd_u16_be(&raw[LORA_LEGACY_OFS_PITCH]),
+             rd_u16_be(&raw[LORA_LEGACY_OFS_YAW]), rd_u16_be(&raw[LORA_LEGACY_OFS_ALT]) / 10,  // 0.01m -> 0.1m
+             raw[LORA_LEGACY_OFS_PHASE]);
+  Serial.write(g_glTx.wire, glFinish(g_glTx));
+}
 
-  // float roll  = roll_i  / 100.0;
-  // float pitch = pitch_i / 100.0;
-  // float yaw   = yaw_i   / 100.0;
+// LORA_PORT에 와 있는 바이트만 읽음. 줄이 덜 왔으면 다음 루프에 이어서
+void handleLoraRx() { // 로켓으로부터의 텔레메트리 수신 함수
+  while (LORA_PORT.available()) {
+    if (loraLineFeed(g_loraLine, (char)LORA_PORT.read())) handleLoraLine(g_loraLine.buf);
+  }
+}
 
-  // float lat = lat_i / 1e7;
-  // float lon = lon_i / 1e7;
 
-  // float alt  = alt_i / 10.0;
-  // float temp = temp_i / 100.0;
+// 웹 명령 줄 조립 (readStringUntil은 줄이 덜 오면 1초까지 멈춤 -> 그동안 LoRa 수신 버퍼가 넘침)
+static char webCmd[16];
+static uint8_t webCmdLen = 0;
+static bool webCmdOverflow = false;
 
-  FlightDataPacket packet;
-  
-  packet.roll = read16(raw, idx) / 100.0;
-  packet.pitch = read16(raw, idx) / 100.0;
-  packet.yaw = read16(raw, idx) / 100.0;
-
-  packet.lat = read32(raw, idx) / 1e7;
-  packet.lon = read32(raw, idx) / 1e7;
-  packet.alt = read16(raw, idx) / 100;
-  packet.temp = read16(raw, idx) / 100.0;
-
-  if(sound == true) { //소리버튼 클릭
-  //Serial.println("SOUND send (\"E\")");
-    if(raw[idx] == 1) 
-      packet.connect = 3; //커넥트핀 해제
-    else
-      packet.connect = 2; //커넥트핀 연결
-  idx++;
-  sound = false;
+void runWebCommand(const char* cmd) {
+  if (strcmp(cmd, "EJECT") == 0) {
+    digitalWrite(13, HIGH);
+    sendEmergencyDeploy();
   }
-  else
-  packet.connect= raw[idx++];
-  packet.phase = raw[idx] / 10;
-  if(ejection==true){
-    packet.para = 2;
-    ejection = false;
-    idx++;
+  else if (strcmp(cmd, "CENTER") == 0) {
+    digitalWrite(13, LOW);
+    sendCenter();
   }
-  else
-  packet.para = raw[idx++] % 10;
-  packet.pressure = random(500, 1000);   
-  packet.speed = random(0, 100); 
-
-  // 체크섬 계산
-  packet.checksum = 0;
-  uint8_t* bytes = (uint8_t*)&packet;
-  // start_byte는 제외하고 checksum 필드 전까지 더합니다.
-  for (size_t i = 1; i < sizeof(packet) - 1; ++i) {
-    packet.checksum += bytes[i];
+  else if (strcmp(cmd, "STATS") == 0) {
+    loraRxPrintStats(pcText, g_loraLine, g_loraRxSt);
+    uplinkPrintStats();
   }
+}
 
-  // 시리얼 포트로 패킷 전송
-  Serial.write((uint8_t*)&packet, sizeof(packet));
-
-
-  // Serial.print("ROLL=");  Serial.print(packet.roll);
-  // Serial.print(" PITCH=");Serial.print(packet.pitch);
-  // Serial.print(" YAW=");  Serial.print(packet.yaw);
-  // Serial.print(" LAT=");  Serial.print(packet.lat, 7);
-  // Serial.print(" LON=");  Serial.print(packet.lon, 7);
-  // Serial.print(" ALT=");  Serial.print(packet.alt);
-  // Serial.print(" TEMP="); Serial.print(packet.temp);
-  // Serial.print(" CONNECT=");  Serial.print(packet.connect);
-  // Serial.print(" PARA="); Serial.print(packet.para);
-  // Serial.print(" PHASE=");Serial.println(packet.phase);
-
-  // if(Serial.available())
-  // lora.write(Serial.read());
-  // if(lora.available())
-  // Serial.write(lora.read())
+void handleWebCommand() { // 웹으로부터의 명령 처리 함수
+  while (Serial.available()) {
+    char c = (char)Serial.read();
+    if (c == '\r' || c == ' ' || c == '\t') continue;   // trim
+    if (c == '\n') {
+      webCmd[webCmdLen] = '\0';
+      if (!webCmdOverflow && webCmdLen > 0) runWebCommand(webCmd);
+      webCmdLen = 0;
+      webCmdOverflow = false;
+    } else if (webCmdLen < sizeof(webCmd) - 1) {
+      webCmd[webCmdLen++] = c;
+    } else {
+      webCmdOverflow = true;
+    }
+  }
 }
 
+// ====== 업링크 명령 (재전송 + 확인) ======
+//  AT+SEND=1,3,<코드><id 16진 2자리> (예: E07). 로켓은 받은 id를 다음 텔레메트리의 ack로 돌려줌 (sensorMain lora.h)
+//  예전: 10번 x delay(50) -> 0.5초 동안 텔레메트리 수신이 멈추고 로켓이 받았는지 알 수 없었음
+//  지금: 루프마다 serviceUplink()가 시각만 보고 보낼 차례면 한 줄 (UART 버퍼 64B 안이라 안 막힘)
+//    간격 200ms부터 두 배씩 최대 1600ms + 0~50% 지터 (로켓 송신 약 0.5초와 주기가 겹쳐 계속 못 듣는 걸 피함)
+//    ack가 오면 확인, 10초 넘으면 포기 -> 결과와 지연을 CMD 프레임으로 PC에
+//    id는 첫 텔레메트리의 ack(로켓이 마지막으로 받은 id) 다음부터. 그걸 받기 전에는 보내지 않음
+static const uint16_t UPLINK_BACKOFF_MIN_MS = 200;
+static const uint16_t UPLINK_BACKOFF_MAX_MS = 1600;
+static const uint32_t UPLINK_TIMEOUT_MS = 10000;
+
+struct Uplink {
+  char code;          // 0 = 보낼 명령 없음
+  uint8_t id;
+  uint8_t tries;
+  uint16_t backoffMs;
+  uint32_t firstMs;
+  uint32_t nextMs;
+};
+
+struct UplinkStats {
+  uint32_t cmds;
+  uint32_t tx;
+  uint32_t acked;
+  uint32_t failed;    // 시간 초과 + 바뀜
+  uint32_t lastLatencyMs;
+};
+
+Uplink g_uplink;
+UplinkStats g_uplinkSt;
+static uint8_t uplinkLastId = 0;
+static bool uplinkSeeded = false;   // 로켓 ack를 한 번이라도 봤는지
+
+void uplinkReport(uint8_t result, uint32_t now) {
+  glBegin(g_glTx, GL_MSG_CMD);
+  uint8_t* f = g_glTx.frame;
+  int& i = g_glTx.n;
+  f[i++] = (uint8_t)g_uplink.code;
+  f[i++] = g_uplink.id;
+  f[i++] = result;
+  f[i++] = g_uplink.tries;
+  push_u32_le(f, i, now - g_uplink.firstMs);
+  Serial.write(g_glTx.wire, glFinish(g_glTx));
+  g_uplink.code = 0;
+}
 
-void handleWebCommand() { // 웹으로부터의 명령 처리 함수
-  if (!Serial.available()) return;
+static uint8_t uplinkNextId() {
+  if (++uplinkLastId == 0) uplinkLastId = 1;   // 0은 로켓 ack "없음"
+  return uplinkLastId;
+}
 
-  String cmd = Serial.readStringUntil('\n');
-  cmd.trim();
+// 새 명령. 같은 명령이 이미 재전송 중이면 그대로 둠 (버튼 반복), 사출 재전송 중에는 다른 명령을 받지 않음
+void uplinkStart(char code) {
+  uint32_t now = millis();
+  if (g_uplink.code == code || g_uplink.code == 'E') return;
+  if (g_uplink.code) {
+    g_uplinkSt.failed++;
+    uplinkReport(GL_CMD_REPLACED, now);
+  }
+  g_uplink.code = code;
+  g_uplink.id = uplinkNextId();
+  g_uplink.tries = 0;
+  g_uplink.backoffMs = UPLINK_BACKOFF_MIN_MS;
+  g_uplink.firstMs = now;
+  g_uplink.nextMs = now;
+  g_uplinkSt.cmds++;
+}
 
-  if (cmd == "EJECT") {
-    digitalWrite(13, HIGH);
-    sendEmergencyDeploy();
+void serviceUplink() {
+  if (!g_uplink.code) return;
+  uint32_t now = millis();
+  if (now - g_uplink.firstMs >= UPLINK_TIMEOUT_MS) {
+    g_uplinkSt.failed++;
+    uplinkReport(GL_CMD_TIMEOUT, now);
+    return;
   }
-  else if(cmd == "CENTER") {
-    digitalWrite(13, LOW);
-    sendCenter();
+  if ((int32_t)(now - g_uplink.nextMs) < 0) return;
+  if (!uplinkSeeded) return;   // 로켓의 마지막 id를 알기 전엔 안 보냄 (onUplinkAck)
+
+  char cmd[24];
+  int n = snprintf(cmd, sizeof(cmd), "AT+SEND=1,3,%c%02X\r\n", g_uplink.code, g_uplink.id);
+  LORA_PORT.write((const uint8_t*)cmd, n);
+  if (g_uplink.tries < 255) g_uplink.tries++;
+  g_uplinkSt.tx++;
+  g_uplink.nextMs = now + g_uplink.backoffMs + random(0, g_uplink.backoffMs / 2 + 1);
+  if (g_uplink.backoffMs < UPLINK_BACKOFF_MAX_MS) g_uplink.backoffMs *= 2;
+}
+
+// 텔레메트리의 ack (로켓이 마지막으로 받은 id)
+//  재시작 직후 첫 ack는 예전 세션의 id일 수 있음 -> 그 다음 번호부터 (1부터 다시 쓰면 로켓은 중복으로 건너뛰고
+//  예전 ack로 확인됨). 그 전에 눌린 명령은 보내지 않고 기다렸다가 여기서 새 id로 바로 보냄
+void onUplinkAck(uint8_t ack) {
+  if (!uplinkSeeded) {
+    uplinkSeeded = true;
+    uplinkLastId = ack;
+    if (g_uplink.code) {
+      g_uplink.id = uplinkNextId();
+      g_uplink.nextMs = millis();
+      return;
+    }
   }
+  if (!g_uplink.code || ack != g_uplink.id || g_uplink.tries == 0) return;
+  uint32_t now = millis();
+  g_uplinkSt.acked++;
+  g_uplinkSt.lastLatencyMs = now - g_uplink.firstMs;
+  uplinkReport(GL_CMD_ACKED, now);
+}
+
+void uplinkPrintStats() {
+  pcText.print(F("uplink cmd="));
+  pcText.print((unsigned long)g_uplinkSt.cmds);
+  pcText.print(F(" tx="));
+  pcText.print((unsigned long)g_uplinkSt.tx);
+  pcText.print(F(" acked="));
+  pcText.print((unsigned long)g_uplinkSt.acked);
+  pcText.print(F(" failed="));
+  pcText.print((unsigned long)g_uplinkSt.failed);
+  pcText.print(F(" last="));
+  pcText.print((unsigned long)g_uplinkSt.lastLatencyMs);
+  pcText.println(F("ms"));
 }
 
 void sendEmergencyDeploy() { // LoRa 비상 사출 송신 함수
-  for(int i=0; i<10; i++){
-  lora.print("AT+SEND=1,1,E\r\n");
-  delay(50);
-  }
-  //Serial.println("[lora] EMERGENCY DEPLOY SENT (\"E\")");
+  uplinkStart('E');
 }
 
 void sendCenter() { // LoRa 중앙 정렬 송신 함수
-  for(int i=0; i<10; i++){
-  lora.print("AT+SEND=1,1,C\r\n");
-  delay(50);
-  }
-  //Serial.println("[lora] CENTER SENT (\"C\")");
+  uplinkStart('C');
 }
 
 
 void setup() {
   Serial.begin(115200);
-  lora.begin(9600);
-  Serial.println("RX READY");
+  LORA_PORT.begin(9600);
+  loraLineInit(g_loraLine);
+  delay(200);
+  if (!loraConfigure(LORA_PORT)) pcText.println("LORA PARAMETER FAIL");  // 로켓과 같은 SF (loraRadio.h)
+  pcText.println("RX READY");
   pinMode(13, OUTPUT);
   pinMode(8, INPUT_PULLUP);
   pinMode(9, INPUT_PULLUP);
@@ -246,12 +376,17 @@ void setup() {
 void loop() {
   handleLoraRx();
   handleWebCommand();
+  serviceUplink();
   
-  if(digitalRead(9)==LOW)
+  // 누르는 순간 한 번 (누르고 있는 동안 매 루프 새 명령을 만들지 않게)
+  static bool ejectBtnWasLow = false;
+  bool ejectBtnLow = digitalRead(9)==LOW;
+  if(ejectBtnLow && !ejectBtnWasLow)
   {
     ejection = true;
     sendEmergencyDeploy();
   }
+  ejectBtnWasLow = ejectBtnLow;
   if(digitalRead(8)==LOW)
   {
     sound = true;
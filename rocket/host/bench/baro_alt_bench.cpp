@@ -0,0 +1,128 @@
+// ============================================================================
+// 기압 -> 고도 커널 검증 + 벤치마크 (호스트)
+//  - 기준: K * (1 - (p/p0)^0.1903) 를 double pow로 계산
+//  - 1) 스윕: p = 300~1100 hPa (0.01 hPa 간격) x 여러 p0 에서 baroAltitude() 최대 오차
+//       BARO_ALT_MAX_ERR_M 넘으면 종료코드 1 (ctest baro_alt_sweep)
+//       기존 float powf 식 오차도 같이 출력 (float 자체 반올림 수준 비교용)
+//  - 2) 속도: 기존 powf 식 vs 표 보간, 호출당 사이클(x86 TSC) / ns
+//       AVR soft-float는 powf가 훨씬 더 비싸므로 비율은 하한으로 볼 것
+//
+//   baro_alt_bench [--sweep-only] [reps]
+// ============================================================================
+
+#include <baroAltitude.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycles() { return __rdtsc(); }
+#define HAVE_CYCLES 1
+#else
+static inline uint64_t cycles() { return 0; }
+#define HAVE_CYCLES 0
+#endif
+
+static const double BARO_ALT_MAX_ERR_M = 0.06;  // baroAltitude.h에 적은 값
+
+static double altRef(double p, double p0) {
+  return 43561.54 * (1.0 - pow(p / p0, 0.1903));
+}
+
+// 기존 sensorMain 구현 그대로 (비교 기준)
+static float altPowf(float p_hPa, float p0_hPa) {
+  if (p_hPa <= 0.0f || p0_hPa <= 0.0f) return 0.0f;
+  return 43561.54f * (1.0f - powf(p_hPa / p0_hPa, 0.1903f));
+}
+
+struct SweepResult {
+  double maxErr;
+  double atP;
+  double maxErrPowf;
+};
+
+static SweepResult sweep(float p0) {
+  BaroAltRef r = baroAltRef(p0);
+  SweepResult s = { 0.0, 0.0, 0.0 };
+  for (int k = 0; k <= 80000; k++) {
+    float p = 300.0f + k * 0.01f;
+    double ref = altRef(p, p0);
+    double e = fabs((double)baroAltitude(r, p) - ref);
+    if (e > s.maxErr) {
+      s.maxErr = e;
+      s.atP = p;
+    }
+    double ep = fabs((double)altPowf(p, p0) - ref);
+    if (ep > s.maxErrPowf) s.maxErrPowf = ep;
+  }
+  return s;
+}
+
+struct Timing {
+  double cyclesPerCall;
+  double nsPerCall;
+  double sink;
+};
+
+template <typename F>
+static Timing run(F fn, const std::vector<float>& ps, int reps) {
+  volatile float sink = 0.0f;
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t c0 = cycles();
+  for (int r = 0; r < reps; r++) {
+    for (size_t i = 0; i < ps.size(); i++) sink = sink + fn(ps[i]);
+  }
+  uint64_t c1 = cycles();
+  auto t1 = std::chrono::steady_clock::now();
+
+  double calls = (double)ps.size() * reps;
+  Timing t;
+  t.cyclesPerCall = (double)(c1 - c0) / calls;
+  t.nsPerCall = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+  t.sink = sink;
+  return t;
+}
+
+int main(int argc, char** argv) {
+  bool sweepOnly = false;
+  int reps = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--sweep-only") == 0) sweepOnly = true;
+    else reps = atoi(argv[i]);
+  }
+  if (reps <= 0) reps = 200;
+
+  // 1) 정확도
+  const float p0s[] = { 300.0f, 500.0f, 700.0f, 900.0f, 1000.0f, 1013.25f, 1030.0f, 1100.0f };
+  int fails = 0;
+  printf("%-9s %12s %10s %14s\n", "p0 hPa", "maxErr m", "at hPa", "powf maxErr m");
+  for (float p0 : p0s) {
+    SweepResult s = sweep(p0);
+    printf("%-9.2f %12.4f %10.2f %14.4f%s\n", p0, s.maxErr, s.atP, s.maxErrPowf,
+           s.maxErr > BARO_ALT_MAX_ERR_M ? "  FAIL" : "");
+    if (s.maxErr > BARO_ALT_MAX_ERR_M) fails++;
+  }
+  printf("limit %.3f m over 300..1100 hPa: %s\n\n", BARO_ALT_MAX_ERR_M, fails ? "FAIL" : "ok");
+  if (fails || sweepOnly) return fails ? 1 : 0;
+
+  // 2) 속도 (비행 중 범위 근처 압력 무작위)
+  std::vector<float> ps(4096);
+  srand(1234);
+  for (size_t i = 0; i < ps.size(); i++) ps[i] = 700.0f + 330.0f * (float)rand() / (float)RAND_MAX;
+
+  const float p0 = 1013.25f;
+  BaroAltRef r = baroAltRef(p0);
+  Timing a = run([p0](float p) { return altPowf(p, p0); }, ps, reps);
+  Timing b = run([&r](float p) { return baroAltitude(r, p); }, ps, reps);
+
+  printf("%-22s %12s %10s\n", "impl", HAVE_CYCLES ? "cycles/call" : "-", "ns/call");
+  printf("%-22s %12.2f %10.3f\n", "powf (old)", a.cyclesPerCall, a.nsPerCall);
+  printf("%-22s %12.2f %10.3f\n", "table + quad interp", b.cyclesPerCall, b.nsPerCall);
+  printf("speedup x%.2f\n", a.nsPerCall / b.nsPerCall);
+  return 0;
+}
@@ -0,0 +1,115 @@
+// ============================================================================
+// CRC16 CCITT-FALSE 벤치마크 (호스트)
+//  - 기존 bit-by-bit 루프(sensorMain/pinMain에 있던 코드) vs linkProtocol.h 테이블
+//  - 결과 일치 확인 후 바이트당 사이클(x86 TSC) / ns 출력
+//
+// 빌드: g++ -O2 -std=gnu++11 -I../../libraries/RocketCommon/src crc16_bench.cpp -o crc16_bench
+// ============================================================================
+
+#include <linkProtocol.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t cycles() { return __rdtsc(); }
+#define HAVE_CYCLES 1
+#else
+static inline uint64_t cycles() { return 0; }
+#define HAVE_CYCLES 0
+#endif
+
+// 기존 구현 그대로 (비교 기준)
+static uint16_t crc16_ccitt_bitwise(const uint8_t* data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static uint16_t crc16_table_incremental(const uint8_t* data, size_t len) {
+  Crc16 crc;
+  for (size_t i = 0; i < len; i++) crc.update(data[i]);
+  return crc.value;
+}
+
+struct Result {
+  double cyclesPerByte;
+  double nsPerByte;
+  uint16_t sink;
+};
+
+// frameLen: 실제 프레임 단위로 나눠서 계산 (A2B = 29B, B2A = 11B)
+template <typename F>
+static Result run(F fn, const std::vector<uint8_t>& buf, size_t frameLen, int reps) {
+  volatile uint16_t sink = 0;
+  size_t frames = buf.size() / frameLen;
+
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t c0 = cycles();
+  for (int r = 0; r < reps; r++) {
+    for (size_t i = 0; i < frames; i++) sink = sink ^ fn(&buf[i * frameLen], frameLen);
+  }
+  uint64_t c1 = cycles();
+  auto t1 = std::chrono::steady_clock::now();
+
+  double bytes = (double)frames * frameLen * reps;
+  Result res;
+  res.cyclesPerByte = (double)(c1 - c0) / bytes;
+  res.nsPerByte = std::chrono::duration<double, std::nano>(t1 - t0).count() / bytes;
+  res.sink = sink;
+  return res;
+}
+
+int main(int argc, char** argv) {
+  int reps = (argc > 1) ? atoi(argv[1]) : 200;
+  if (reps <= 0) reps = 200;
+
+  std::vector<uint8_t> buf(64 * 1024);
+  srand(1234);
+  for (size_t i = 0; i < buf.size(); i++) buf[i] = (uint8_t)rand();
+
+  // 1) 정확성: 표준 check 값 + 무작위 길이 전부 비교
+  const char* check = "123456789";
+  uint16_t ref = crc16_ccitt_bitwise((const uint8_t*)check, 9);
+  uint16_t tbl = crc16_ccitt((const uint8_t*)check, 9);
+  printf("check(\"123456789\"): bitwise=0x%04X table=0x%04X (expect 0x29B1)\n", ref, tbl);
+  if (ref != 0x29B1 || tbl != 0x29B1) return 1;
+
+  for (size_t len = 0; len < 600; len++) {
+    if (crc16_ccitt_bitwise(&buf[len], len) != crc16_ccitt(&buf[len], len) ||
+        crc16_ccitt_bitwise(&buf[len], len) != crc16_table_incremental(&buf[len], len)) {
+      printf("MISMATCH at len=%zu\n", len);
+      return 1;
+    }
+  }
+  printf("table == bitwise for len 0..599\n\n");
+
+  // 2) 속도
+  const size_t frameLens[] = { A2B_HDR_LEN + A2B_LEN, B2A_HDR_LEN + B2A_LEN, 512 };
+  const char* frameNames[] = { "A2B frame", "B2A frame", "512B block" };
+
+  printf("%-11s %-22s %12s %10s\n", "frame", "impl", HAVE_CYCLES ? "cycles/B" : "-", "ns/B");
+  for (int k = 0; k < 3; k++) {
+    Result a = run(crc16_ccitt_bitwise, buf, frameLens[k], reps);
+    Result b = run(crc16_ccitt, buf, frameLens[k], reps);
+    Result c = run(crc16_table_incremental, buf, frameLens[k], reps);
+    if (a.sink != b.sink || a.sink != c.sink) {
+      printf("MISMATCH (%s)\n", frameNames[k]);
+      return 1;
+    }
+    printf("%-11s %-22s %12.2f %10.3f\n", frameNames[k], "bitwise (old)", a.cyclesPerByte, a.nsPerByte);
+    printf("%-11s %-22s %12.2f %10.3f\n", frameNames[k], "table crc16_ccitt", b.cyclesPerByte, b.nsPerByte);
+    printf("%-11s %-22s %12.2f %10.3f\n", frameNames[k], "table Crc16::update", c.cyclesPerByte, c.nsPerByte);
+    printf("%-11s speedup x%.2f\n\n", frameNames[k], a.nsPerByte / b.nsPerByte);
+  }
+  return 0;
+}
@@ -0,0 +1,318 @@
+// ============================================================================
+// 비행 로그 리플레이
+//  - FL*.BIN 레코드를 시간 순서대로 FlightData에 넣고, sensorMain의 parachute.ino
+//    logic 태스크 한 주기(flightLogicStep: 고도 추정 -> runFlightLogic -> applyParachuteDeployState)를
+//    sensorMain taskLogic과 같은 함수로 그대로 돌림 (칼만 고도/속도도 다시 계산, 로그의 est는 무시)
+//  - logic은 --loop-us 간격(기본: 태스크 테이블의 logic 주기) 격자로 호출, 호출 전에 그 시각까지의
+//    레코드를 모두 반영 (레코드 사이 구간은 같은 값을 여러 번 넣음)
+//    (isPowered/isMotorOver 카운터는 호출 횟수 기준이라 호출 간격이 결과에 영향)
+//  - 가상 시계 위에서 돌기 때문에 실제 시간보다 수천 배 빠름
+//  - 파일마다 프로세스를 분리 (isAltitudeUp/Down의 static 카운터 초기화)
+//
+//   flight_replay [옵션] FL0016.BIN FLIGHT.BIN ...
+// ============================================================================
+
+#include <Arduino.h>
+#include <Servo.h>
+#include "sim.h"
+
+#include <chrono>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "flightType.h"
+#include "rlg_log.h"
+
+// ====== sensorMain.ino의 전역 중 parachute.ino가 쓰는 것 ======
+#define PIN_CONNECT_DETECT 2
+#define PIN_DEPLOY_SERVO 6
+
+FlightData flight;
+JudgeCounters jc;
+Servo deployServo;
+DeployController deployCtl;
+bool pinDetached = false;
+bool g_parachuteDeployed = false;
+bool launchTimeStarted = false;
+unsigned long launchTimeMs = 0;
+
+#include "parachute.ino"
+#include "altEstimator.h"
+
+AltEstimator g_altEst;
+
+// ====== 옵션 ======
+struct Options {
+  uint32_t loopUs = FLIGHT_LOGIC_PERIOD_MS * 1000UL;  // runFlightLogic 호출 간격 (sensorMain 태스크 주기)
+  int64_t pinDetachedMs = 0;     // 커넥트핀 분리 시각 (로그에 기록 안 됨), -1이면 분리 안 함
+  bool verbose = false;          // 스케치의 Serial 출력 표시
+  // 회귀 검사 (하나라도 실패하면 종료코드 1)
+  const char* expectState = nullptr;
+  int expectDeploy = -1;         // 1: 사출 있어야 함, 0: 없어야 함
+  int64_t maxDeployLatencyMs = -1;  // 사출 시각 - 로그상 최고고도 시각
+  int64_t minDeployLatencyMs = 0;   // 예측 사출은 로그상 최고고도(잡음 포함)보다 조금 빠를 수 있음
+};
+
+struct Transition {
+  uint32_t timeMs;
+  FlightState from, to;
+};
+
+struct ReplayResult {
+  std::vector<Transition> logged;
+  std::vector<Transition> replayed;
+  bool launched = false;
+  uint32_t launchMs = 0;
+  bool deployed = false;
+  uint32_t deployMs = 0;
+  FlightState deployState = STANDBY;
+  bool haveApogee = false;
+  uint32_t apogeeMs = 0;
+  float apogeeAlt = 0.0f;
+  uint32_t predFirstMs = 0;  // 관성비행 진입 직후 첫 예측 최고고도 시각
+  uint32_t predFirstAtMs = 0;
+  uint64_t steps = 0;
+};
+
+static const char* stateName(uint8_t s) {
+  return s <= LANDED ? getStateName((FlightState)s) : "?";
+}
+
+// 로그 레코드의 센서/링크 값만 반영 (상태, timeMs, 칼만 추정, 예측 기록은 리플레이 쪽 값 유지)
+static void applyRecord(const FlightData& rec) {
+  FlightState st = flight.state;
+  AltEstData est = flight.est;
+  ApogeeLog apo = flight.apo;
+  flight = rec;
+  flight.state = st;
+  flight.est = est;
+  flight.apo = apo;
+}
+
+static void step(const Options& opt, ReplayResult& r) {
+  flight.timeMs = millis();
+
+  if (opt.pinDetachedMs >= 0 && (int64_t)millis() >= opt.pinDetachedMs) sim::setPin(PIN_CONNECT_DETECT, true);
+
+  FlightState before = flight.state;
+  bool deployedBefore = g_parachuteDeployed;
+
+  flightLogicStep(g_altEst, millis());  // sensorMain taskLogic과 같은 함수
+
+  if (flight.state != before) r.replayed.push_back({ (uint32_t)millis(), before, flight.state });
+  if (!r.launched && launchTimeStarted) {
+    r.launched = true;
+    r.launchMs = launchTimeMs;
+  }
+  if (r.predFirstMs == 0 && flight.apo.predMs != 0) {
+    r.predFirstMs = flight.apo.predMs;
+    r.predFirstAtMs = millis();
+  }
+  if (!deployedBefore && g_parachuteDeployed) {
+    r.deployed = true;
+    r.deployMs = millis();
+    r.deployState = flight.state;
+  }
+  r.steps++;
+}
+
+static void replay(const RlgLog& log, const Options& opt, ReplayResult& r) {
+  sim::setPin(PIN_CONNECT_DETECT, false);
+  pinMode(PIN_CONNECT_DETECT, INPUT_PULLUP);
+  initParachuteDeploy();
+  flight.state = STANDBY;
+
+  // logic 주기 격자(--loop-us) 위에서 돌리고, 각 단계 전에 그 시각까지 기록된 레코드를 모두 반영
+  // (종류별 레코드(v3)는 한 ms에 여러 개, 주기도 제각각 -> 레코드 수가 아니라 시간 기준으로 호출)
+  const std::vector<FlightData>& recs = log.records;
+  if (recs.empty()) return;
+  uint64_t t = (uint64_t)recs[0].timeMs * 1000ULL;
+  int64_t offUs = 0;  // 시간 역행(재부팅 등) 이후 레코드를 현재 시각 뒤로 이어 붙이는 보정
+  size_t i = 0;
+  while (i < recs.size()) {
+    sim::advanceToUs(t);
+    while (i < recs.size()) {
+      const FlightData& rec = recs[i];
+      // 종류별 레코드는 쓰는 순서와 시각이 몇 ms 어긋날 수 있음 -> 1초 넘게 거꾸로 갈 때만 재부팅으로 봄
+      if (i > 0 && rec.timeMs + 1000 < recs[i - 1].timeMs) offUs = (int64_t)t - (int64_t)rec.timeMs * 1000;
+      if ((int64_t)rec.timeMs * 1000 + offUs > (int64_t)t) break;
+
+      if (i > 0 && rec.state != recs[i - 1].state)
+        r.logged.push_back({ rec.timeMs, recs[i - 1].state, rec.state });
+      if (!isOMGbaro(rec.baro) && (!r.haveApogee || rec.baro.altitude > r.apogeeAlt)) {
+        r.haveApogee = true;
+        r.apogeeAlt = rec.baro.altitude;
+        r.apogeeMs = rec.timeMs;
+      }
+      applyRecord(rec);
+      i++;
+    }
+    step(opt, r);
+    t += opt.loopUs;
+  }
+}
+
+static void printTransitions(const char* label, const std::vector<Transition>& v, const ReplayResult& r) {
+  printf("  %-8s:", label);
+  if (v.empty()) printf(" (none)");
+  printf("\n");
+  for (const Transition& t : v) {
+    printf("    %8u ms  %-8s -> %-8s", t.timeMs, stateName(t.from), stateName(t.to));
+    if (r.launched) printf("  (T0%+.3f s)", ((int64_t)t.timeMs - (int64_t)r.launchMs) / 1000.0);
+    printf("\n");
+  }
+}
+
+static int runFile(const char* path, const Options& opt) {
+  RlgLog log;
+  std::string err;
+  if (!rlgLoad(path, log, err)) {
+    fprintf(stderr, "%s: %s\n", path, err.c_str());
+    return 2;
+  }
+
+  sim::config().echoSerial = opt.verbose;
+  Serial.begin(115200);  // 상태 전이 시 출력 블로킹 시간도 실제와 같게 반영
+
+  ReplayResult r;
+  auto wall0 = std::chrono::steady_clock::now();
+  replay(log, opt, r);
+  Serial.flush();
+  fflush(stdout);
+  double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall0).count();
+
+  uint32_t firstMs = log.records.empty() ? 0 : log.records.front().timeMs;
+  uint32_t lastMs = log.records.empty() ? 0 : log.records.back().timeMs;
+  printf("%s: %s v%u recSize=%u, %zu records, %.3f..%.3f s\n", path,
+         log.hasHeader ? "RLG1" : "no header", log.version, log.recSize, log.records.size(),
+         firstMs / 1000.0, lastMs / 1000.0);
+  if (log.trailingBytes) printf("  (truncated tail: %zu bytes)\n", log.trailingBytes);
+  if (log.unusedBytes) printf("  (preallocated, unused: %zu bytes)\n", log.unusedBytes);
+  if (log.version == LOGC_VERSION) {
+    printf("  (delta: %zu keyframes, %zu records before first keyframe skipped)\n", log.keyframes,
+           log.skippedNoKey);
+  }
+  if (log.version == LR_VERSION || log.version == LF_VERSION) {
+    printf("  (typed: imu %zu, baro %zu, gps %zu, status %zu, event %zu, unknown %zu)\n", log.typeCount[0],
+           log.typeCount[1], log.typeCount[2], log.typeCount[3], log.typeCount[4], log.unknownRecs);
+  }
+  if (log.version == LF_VERSION) {
+    printf("  (framed: %zu resyncs, %zu bytes skipped, %zu seq gaps, %zu records lost)\n", log.resyncs,
+           log.skippedBytes, log.seqGaps, log.lostRecords);
+  }
+  if (log.badBytes) printf("  (undecodable tail: %zu bytes)\n", log.badBytes);
+
+  printTransitions("logged", r.logged, r);
+  printTransitions("replay", r.replayed, r);
+
+  if (r.launched) printf("  launch  : T0 = %u ms\n", r.launchMs);
+  else printf("  launch  : not detected\n");
+  if (r.haveApogee) printf("  apogee  : %.2f m @ %u ms (max baro altitude in log)\n", r.apogeeAlt, r.apogeeMs);
+  else printf("  apogee  : no valid baro data\n");
+  if (r.deployed) {
+    printf("  deploy  : %u ms in %s", r.deployMs, stateName(r.deployState));
+    if (r.launched) printf(", T0%+.3f s", ((int64_t)r.deployMs - (int64_t)r.launchMs) / 1000.0);
+    if (r.haveApogee) printf(", apogee%+.3f s", ((int64_t)r.deployMs - (int64_t)r.apogeeMs) / 1000.0);
+    printf("\n");
+  } else {
+    printf("  deploy  : none\n");
+  }
+  // 예측기 vs 카운터 판단 (flight.apo)
+  if (r.predFirstMs) {
+    printf("  predict : first %u ms (made @ %u ms), last %u ms", r.predFirstMs, r.predFirstAtMs, flight.apo.predMs);
+    if (r.haveApogee) printf(", last-apogee%+.3f s", ((int64_t)flight.apo.predMs - (int64_t)r.apogeeMs) / 1000.0);
+    printf("\n");
+  }
+  if (flight.apo.armMs || flight.apo.detectMs) {
+    printf("  apo arm : %s", flight.apo.armMs ? "" : "none");
+    if (flight.apo.armMs) printf("%u ms", flight.apo.armMs);
+    printf(", counter descent: ");
+    if (flight.apo.detectMs) printf("%u ms", flight.apo.detectMs);
+    else printf("none");
+    if (flight.apo.armMs && flight.apo.detectMs)
+      printf(" (predictor %.3f s earlier)", ((int64_t)flight.apo.detectMs - (int64_t)flight.apo.armMs) / 1000.0);
+    printf("\n");
+  }
+  double simS = (lastMs - firstMs) / 1000.0;
+  printf("  final   : %s, %llu loop steps, %.1f ms wall (%.0fx real time)\n",
+         stateName(flight.state), (unsigned long long)r.steps, wallMs,
+         wallMs > 0 ? simS * 1000.0 / wallMs : 0.0);
+
+  // ====== 회귀 검사 ======
+  int fails = 0;
+  if (opt.expectState && strcmp(opt.expectState, stateName(flight.state)) != 0) {
+    printf("  FAIL: final state %s, expected %s\n", stateName(flight.state), opt.expectState);
+    fails++;
+  }
+  if (opt.expectDeploy >= 0 && (int)r.deployed != opt.expectDeploy) {
+    printf("  FAIL: deploy %s, expected %s\n", r.deployed ? "happened" : "missing",
+           opt.expectDeploy ? "deploy" : "no deploy");
+    fails++;
+  }
+  if (opt.maxDeployLatencyMs >= 0) {
+    if (!r.deployed || !r.haveApogee) {
+      printf("  FAIL: deploy latency undefined\n");
+      fails++;
+    } else {
+      int64_t lat = (int64_t)r.deployMs - (int64_t)r.apogeeMs;
+      if (lat < opt.minDeployLatencyMs || lat > opt.maxDeployLatencyMs) {
+        printf("  FAIL: deploy latency %lld ms, allowed %lld..%lld ms\n", (long long)lat,
+               (long long)opt.minDeployLatencyMs, (long long)opt.maxDeployLatencyMs);
+        fails++;
+      }
+    }
+  }
+  fflush(stdout);
+  return fails ? 1 : 0;
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [--loop-us N] [--pin-detached-ms T|never] [--verbose]\n"
+          "          [--expect-state NAME] [--expect-deploy|--expect-no-deploy]\n"
+          "          [--max-deploy-latency-ms N] [--min-deploy-latency-ms N] FILE...\n",
+          argv0);
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  std::vector<const char*> files;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    bool hasVal = (i + 1 < argc);
+    if (a == "--loop-us" && hasVal) opt.loopUs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    else if (a == "--pin-detached-ms" && hasVal) {
+      const char* v = argv[++i];
+      opt.pinDetachedMs = (strcmp(v, "never") == 0) ? -1 : strtoll(v, nullptr, 10);
+    } else if (a == "--verbose") opt.verbose = true;
+    else if (a == "--expect-state" && hasVal) opt.expectState = argv[++i];
+    else if (a == "--expect-deploy") opt.expectDeploy = 1;
+    else if (a == "--expect-no-deploy") opt.expectDeploy = 0;
+    else if (a == "--max-deploy-latency-ms" && hasVal) opt.maxDeployLatencyMs = strtoll(argv[++i], nullptr, 10);
+    else if (a == "--min-deploy-latency-ms" && hasVal) opt.minDeployLatencyMs = strtoll(argv[++i], nullptr, 10);
+    else if (a.size() > 1 && a[0] == '-') {
+      usage(argv[0]);
+      return 2;
+    } else files.push_back(argv[i]);
+  }
+  if (files.empty() || opt.loopUs == 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  int worst = 0;
+  for (const char* path : files) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) _exit(runFile(path, opt));
+    int status = 0;
+    if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status)) {
+      fprintf(stderr, "%s: replay crashed\n", path);
+      worst = 2;
+      continue;
+    }
+    if (WEXITSTATUS(status) > worst) worst = WEXITSTATUS(status);
+  }
+  return worst;
+}
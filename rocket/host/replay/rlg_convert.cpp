@@ -0,0 +1,475 @@
+// ============================================================================
+// RLG1 로그 일괄 변환 (호스트)
+//  - 파일 또는 디렉터리(안의 *.BIN 전부)를 받아 CSV 또는 열 단위 바이너리(.rlc)로 변환
+//  - 파일은 mmap, 레코드 형식은 헤더의 version/recSize로 고름 (rlg_log.h 디코더 그대로)
+//      헤더 없음 = 103B 초기 로그, v1 = FlightData 그대로(recSize가 달라도 앞부분만),
+//      v2 = 델타/varint, v3 = 종류별 레코드 (이벤트는 <이름>_events.csv 따로)
+//  - 파일 하나 = 작업 하나, --jobs 개 스레드가 나눠서 처리 (기본 = 코어 수)
+//  - CSV 열 순서는 parse2.py와 같음 (+ stateStr)
+//  - .rlc : "RLC1" u32 rows, u16 cols
+//           열마다 { u8 이름 길이, 이름, u8 타입 'f'(float32) 'u'(uint32) 'i'(int32) 'b'(uint8) }
+//           그 뒤 열 데이터가 열 순서대로 rows개씩 연속 (little-endian)
+//           -> numpy.frombuffer(dtype, count=rows, offset=...)로 열 하나를 복사 없이 읽을 수 있음
+//
+//  - 출력: 입력 파일 옆에 <이름>.csv, --out DIR이면 DIR/<상위 디렉터리 이름>_<이름>.csv
+//    (카드마다 FL0000.BIN부터 다시 세므로 이름만 쓰면 겹침). 그래도 출력이 겹치면 변환 전에 실패
+//
+//   rlg_convert [--format csv|rlc] [--out DIR] [--jobs N] [--quiet] FILE|DIR ...
+// ============================================================================
+
+#include <dirent.h>
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rlg_log.h"
+
+// ====== 열 정의 (parse2.py COLUMNS + EXT_COLUMNS 순서) ======
+struct RlcCol {
+  const char* name;
+  uint8_t offset;  // offsetof(FlightData, ...)
+  char type;       // 'f' float32, 'u' uint32, 'i' int32, 'b' uint8
+};
+
+#define RLC_C(name, member, type) { name, (uint8_t)offsetof(FlightData, member), type }
+
+static const RlcCol RLC_COLS[] = {
+  RLC_C("imu_ax", imu.ax, 'f'), RLC_C("imu_ay", imu.ay, 'f'), RLC_C("imu_az", imu.az, 'f'),
+  RLC_C("imu_gx", imu.gx, 'f'), RLC_C("imu_gy", imu.gy, 'f'), RLC_C("imu_gz", imu.gz, 'f'),
+  RLC_C("baro_pressure_hPa", baro.pressure, 'f'), RLC_C("baro_temperature_C", baro.temperature, 'f'),
+  RLC_C("baro_altitude_m", baro.altitude, 'f'), RLC_C("baro_climbRate_mps", baro.climbRate, 'f'),
+  RLC_C("gps_latE7", gps.latitudeE7, 'i'), RLC_C("gps_lonE7", gps.longitudeE7, 'i'),
+  RLC_C("gps_altitude_m", gps.altitude, 'f'), RLC_C("gps_speed_mps", gps.speed, 'f'),
+  RLC_C("gps_heading_deg", gps.heading, 'f'), RLC_C("gps_sats", gps.sats, 'b'), RLC_C("gps_fix", gps.fix, 'b'),
+  RLC_C("roll_deg", roll, 'f'), RLC_C("filterRoll_deg", filterRoll, 'f'), RLC_C("pitch_deg", pitch, 'f'),
+  RLC_C("yaw_deg", yaw, 'f'), RLC_C("servoDegree_deg", servoDegree, 'f'),
+  RLC_C("baroTimeMs", baroTimeMs, 'u'), RLC_C("gpsTimeMs", gpsTimeMs, 'u'), RLC_C("aTimeMs", aTimeMs, 'u'),
+  RLC_C("aRxTimeMs", aRxTimeMs, 'u'),
+  RLC_C("state", state, 'b'), RLC_C("timeMs", timeMs, 'u'),
+  RLC_C("est_altitude_m", est.altitude, 'f'), RLC_C("est_velocity_mps", est.velocity, 'f'),
+  RLC_C("est_altVar", est.altVar, 'f'), RLC_C("est_velVar", est.velVar, 'f'),
+  RLC_C("apo_predMs", apo.predMs, 'u'), RLC_C("apo_armMs", apo.armMs, 'u'), RLC_C("apo_detectMs", apo.detectMs, 'u'),
+};
+
+static const size_t RLC_NCOLS = sizeof(RLC_COLS) / sizeof(RLC_COLS[0]);
+static const size_t RLC_LEGACY_NCOLS = 28;  // recSize 103 로그에는 est/apo 열이 없음
+
+static const char* const STATE_NAMES[] = { "STANDBY", "LAUNCHED", "POWERED", "COASTING", "APOGEE", "DESCENT", "LANDED" };
+static const char* const EVENT_NAMES[] = { "?", "BOOT", "STATE", "DEPLOY", "APO_ARM", "APO_DETECT", "LORA_CMD" };
+
+static inline size_t colSize(char type) {
+  return type == 'b' ? 1 : 4;
+}
+
+// ====== 출력 버퍼 (큰 덩어리로 fwrite) ======
+struct OutBuf {
+  FILE* fp;
+  std::vector<char> buf;
+  size_t n = 0;
+  bool ok = true;
+
+  explicit OutBuf(FILE* f) : fp(f), buf(1 << 20) {}
+
+  void flush() {
+    if (n && fwrite(buf.data(), 1, n, fp) != n) ok = false;
+    n = 0;
+  }
+  char* reserve(size_t k) {
+    if (n + k > buf.size()) flush();
+    return &buf[n];
+  }
+  void put(const void* p, size_t k) {
+    if (k > buf.size()) {
+      flush();
+      if (fwrite(p, 1, k, fp) != k) ok = false;
+      return;
+    }
+    memcpy(reserve(k), p, k);
+    n += k;
+  }
+  void str(const char* s) { put(s, strlen(s)); }
+};
+
+// snprintf보다 빠른 정수 출력 (CSV 대부분이 정수 열)
+static inline size_t fmtU32(char* out, uint32_t v) {
+  char tmp[10];
+  size_t k = 0;
+  do {
+    tmp[k++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  for (size_t i = 0; i < k; i++) out[i] = tmp[k - 1 - i];
+  return k;
+}
+
+static inline size_t fmtI32(char* out, int32_t v) {
+  if (v >= 0) return fmtU32(out, (uint32_t)v);
+  out[0] = '-';
+  return 1 + fmtU32(out + 1, 0u - (uint32_t)v);
+}
+
+// float: 소수점 0~6자리 중 다시 읽었을 때 같은 float가 되는 가장 짧은 고정소수점
+// (로그 값은 대부분 0.01 단위로 양자화돼 있어 2자리에서 끝남). 안 되면 %.9g
+static inline size_t fmtF32(char* out, float v) {
+  static const double P10[7] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+  float a = v < 0 ? -v : v;
+  if (v == v && a < 1e9f) {
+    for (int d = 0; d <= 6; d++) {
+      double x = floor((double)a * P10[d] + 0.5);
+      if ((float)(x / P10[d]) != a) continue;
+      uint64_t q = (uint64_t)x;
+      uint32_t ip = (uint32_t)(q / (uint64_t)P10[d]);
+      uint32_t fp = (uint32_t)(q % (uint64_t)P10[d]);
+      size_t k = 0;
+      if (v < 0 && q) out[k++] = '-';
+      k += fmtU32(out + k, ip);
+      if (d) {
+        out[k++] = '.';
+        for (int i = d - 1; i >= 0; i--) {
+          out[k + i] = (char)('0' + fp % 10);
+          fp /= 10;
+        }
+        k += d;
+      }
+      return k;
+    }
+  }
+  return (size_t)snprintf(out, 16, "%.9g", v);
+}
+
+static bool writeCsv(const std::string& path, const RlgLog& log, size_t ncols) {
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp) return false;
+  OutBuf o(fp);
+  for (size_t c = 0; c < ncols; c++) {
+    o.str(RLC_COLS[c].name);
+    o.str(",");
+  }
+  o.str("stateStr\n");
+
+  for (const FlightData& f : log.records) {
+    char* line = o.reserve(ncols * 16 + 16);
+    size_t k = 0;
+    const uint8_t* base = (const uint8_t*)&f;
+    for (size_t c = 0; c < ncols; c++) {
+      const uint8_t* p = base + RLC_COLS[c].offset;
+      switch (RLC_COLS[c].type) {
+        case 'f': {
+          float v;
+          memcpy(&v, p, 4);
+          k += fmtF32(line + k, v);
+          break;
+        }
+        case 'u': {
+          uint32_t v;
+          memcpy(&v, p, 4);
+          k += fmtU32(line + k, v);
+          break;
+        }
+        case 'i': {
+          int32_t v;
+          memcpy(&v, p, 4);
+          k += fmtI32(line + k, v);
+          break;
+        }
+        default:
+          k += fmtU32(line + k, *p);
+          break;
+      }
+      line[k++] = ',';
+    }
+    uint8_t s = (uint8_t)f.state;
+    const char* name = s < 7 ? STATE_NAMES[s] : "UNKNOWN";
+    size_t len = strlen(name);
+    memcpy(line + k, name, len);
+    k += len;
+    line[k++] = '\n';
+    o.n += k;
+  }
+  o.flush();
+  bool ok = o.ok;
+  if (fclose(fp) != 0) ok = false;
+  return ok;
+}
+
+static bool writeRlc(const std::string& path, const RlgLog& log, size_t ncols) {
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp) return false;
+  OutBuf o(fp);
+  uint32_t rows = (uint32_t)log.records.size();
+  uint16_t cols = (uint16_t)ncols;
+  o.put("RLC1", 4);
+  o.put(&rows, 4);
+  o.put(&cols, 2);
+  for (size_t c = 0; c < ncols; c++) {
+    uint8_t len = (uint8_t)strlen(RLC_COLS[c].name);
+    o.put(&len, 1);
+    o.put(RLC_COLS[c].name, len);
+    o.put(&RLC_COLS[c].type, 1);
+  }
+
+  // 열 하나씩 모아서 (레코드 -> 열 전치)
+  std::vector<uint8_t> col(rows * (size_t)4);
+  for (size_t c = 0; c < ncols; c++) {
+    size_t w = colSize(RLC_COLS[c].type);
+    uint8_t off = RLC_COLS[c].offset;
+    uint8_t* q = col.data();
+    for (const FlightData& f : log.records) {
+      memcpy(q, (const uint8_t*)&f + off, w);
+      q += w;
+    }
+    o.put(col.data(), rows * w);
+  }
+  o.flush();
+  bool ok = o.ok;
+  if (fclose(fp) != 0) ok = false;
+  return ok;
+}
+
+static bool writeEvents(const std::string& path, const RlgLog& log) {
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp) return false;
+  fprintf(fp, "timeMs,code,event,arg\n");
+  for (const LrEventOut& e : log.events) {
+    const char* name = e.code < sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) ? EVENT_NAMES[e.code] : "?";
+    fprintf(fp, "%lu,%u,%s,%lu\n", (unsigned long)e.timeMs, e.code, name, (unsigned long)e.arg);
+  }
+  return fclose(fp) == 0;
+}
+
+// ====== 작업 ======
+struct Options {
+  bool rlc = false;
+  std::string outDir;  // 비면 입력 파일 옆
+  unsigned jobs = 0;
+  bool quiet = false;
+};
+
+struct Job {
+  std::string in;
+  std::string outStem;  // 확장자 없는 출력 경로 (main에서 정함)
+  // 결과
+  bool ok = false;
+  std::string err;
+  std::string out;
+  uint16_t version = 0;
+  uint16_t recSize = 0;
+  bool hasHeader = false;
+  size_t inBytes = 0;
+  size_t records = 0;
+  size_t events = 0;
+  double ms = 0.0;
+};
+
+static std::string baseName(const std::string& p) {
+  size_t s = p.find_last_of('/');
+  return s == std::string::npos ? p : p.substr(s + 1);
+}
+
+static std::string dirName(const std::string& p) {
+  size_t s = p.find_last_of('/');
+  return s == std::string::npos ? std::string(".") : p.substr(0, s);
+}
+
+static std::string stem(const std::string& name) {
+  size_t d = name.find_last_of('.');
+  return d == std::string::npos ? name : name.substr(0, d);
+}
+
+// 출력 경로 (확장자 없음). --out이면 상위 디렉터리 이름을 붙임 (상대 경로/"."도 실제 이름으로)
+static std::string outStemFor(const std::string& in, const Options& opt) {
+  std::string name = stem(baseName(in));
+  if (opt.outDir.empty()) return dirName(in) + "/" + name;
+  char* real = realpath(dirName(in).c_str(), nullptr);
+  std::string parent = real ? baseName(real) : baseName(dirName(in));
+  free(real);
+  if (parent.empty()) parent = "root";
+  return opt.outDir + "/" + parent + "_" + name;
+}
+
+static void runJob(Job& j, const Options& opt) {
+  auto t0 = std::chrono::steady_clock::now();
+  RlgMap m;
+  if (!rlgMapOpen(j.in.c_str(), m, j.err)) return;
+  j.inBytes = m.size;
+  RlgLog log;
+  bool ok = rlgParse(m.data, m.size, log, j.err);
+  rlgMapClose(m);
+  if (!ok) return;
+
+  j.version = log.version;
+  j.recSize = log.recSize;
+  j.hasHeader = log.hasHeader;
+  j.records = log.records.size();
+  j.events = log.events.size();
+
+  // 초기 로그는 est/apo가 없으므로 열도 없음 (0으로 채운 열을 만들지 않음)
+  size_t ncols = log.version < LOGC_VERSION && log.recSize < sizeof(FlightData) ? RLC_LEGACY_NCOLS : RLC_NCOLS;
+  const std::string& st = j.outStem;
+  j.out = st + (opt.rlc ? ".rlc" : ".csv");
+  ok = opt.rlc ? writeRlc(j.out, log, ncols) : writeCsv(j.out, log, ncols);
+  if (ok && !log.events.empty()) ok = writeEvents(st + "_events.csv", log);
+  if (!ok) {
+    j.err = "cannot write " + j.out;
+    return;
+  }
+  j.ok = true;
+  j.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static bool hasBinExt(const char* name) {
+  size_t n = strlen(name);
+  return n > 4 && strcasecmp(name + n - 4, ".bin") == 0;
+}
+
+// 디렉터리면 안의 *.BIN (하위 디렉터리는 안 봄)
+static bool collect(const char* path, std::vector<Job>& jobs) {
+  struct stat st;
+  if (stat(path, &st) != 0) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return false;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    Job j;
+    j.in = path;
+    jobs.push_back(j);
+    return true;
+  }
+  DIR* d = opendir(path);
+  if (!d) {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return false;
+  }
+  std::vector<std::string> names;
+  while (struct dirent* e = readdir(d)) {
+    if (hasBinExt(e->d_name)) names.push_back(e->d_name);
+  }
+  closedir(d);
+  std::sort(names.begin(), names.end());
+  for (const std::string& n : names) {
+    Job j;
+    j.in = std::string(path) + "/" + n;
+    jobs.push_back(j);
+  }
+  return true;
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr, "usage: %s [--format csv|rlc] [--out DIR] [--jobs N] [--quiet] FILE|DIR ...\n", argv0);
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  std::vector<Job> jobs;
+  bool inputOk = true;
+  for (int i = 1; i < argc; i++) {
+    const char* a = argv[i];
+    bool hasNext = i + 1 < argc;
+    if (strcmp(a, "--format") == 0 && hasNext) {
+      const char* f = argv[++i];
+      if (strcmp(f, "rlc") == 0) opt.rlc = true;
+      else if (strcmp(f, "csv") == 0) opt.rlc = false;
+      else {
+        usage(argv[0]);
+        return 2;
+      }
+    } else if (strcmp(a, "--out") == 0 && hasNext) {
+      opt.outDir = argv[++i];
+    } else if (strcmp(a, "--jobs") == 0 && hasNext) {
+      opt.jobs = (unsigned)atoi(argv[++i]);
+    } else if (strcmp(a, "--quiet") == 0) {
+      opt.quiet = true;
+    } else if (a[0] == '-') {
+      usage(argv[0]);
+      return 2;
+    } else {
+      inputOk &= collect(a, jobs);
+    }
+  }
+  if (jobs.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+  // 두 입력이 같은 출력을 쓰면 뒤의 것이 덮어씀 -> 아무것도 쓰기 전에 실패
+  std::map<std::string, const Job*> dests;
+  bool destOk = true;
+  for (Job& j : jobs) {
+    j.outStem = outStemFor(j.in, opt);
+    auto r = dests.insert(std::make_pair(j.outStem, &j));
+    if (!r.second) {
+      fprintf(stderr, "%s and %s: same output %s%s\n", r.first->second->in.c_str(), j.in.c_str(), j.outStem.c_str(),
+              opt.rlc ? ".rlc" : ".csv");
+      destOk = false;
+    }
+  }
+  if (!destOk) return 1;
+  if (!opt.outDir.empty() && mkdir(opt.outDir.c_str(), 0777) != 0 && errno != EEXIST) {
+    fprintf(stderr, "%s: %s\n", opt.outDir.c_str(), strerror(errno));
+    return 1;
+  }
+
+  unsigned n = opt.jobs ? opt.jobs : std::thread::hardware_concurrency();
+  if (n == 0) n = 1;
+  if (n > jobs.size()) n = (unsigned)jobs.size();
+
+  // 큰 파일부터 (마지막에 큰 파일 하나만 남아 코어가 노는 것 방지)
+  std::vector<size_t> order(jobs.size());
+  std::vector<off_t> sizes(jobs.size(), 0);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    order[i] = i;
+    struct stat st;
+    if (stat(jobs[i].in.c_str(), &st) == 0) sizes[i] = st.st_size;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::atomic<size_t> next(0);
+  std::mutex printMu;
+  auto worker = [&]() {
+    for (;;) {
+      size_t k = next.fetch_add(1);
+      if (k >= order.size()) return;
+      Job& j = jobs[order[k]];
+      runJob(j, opt);
+      if (opt.quiet && j.ok) continue;
+      std::lock_guard<std::mutex> lock(printMu);
+      if (!j.ok) {
+        fprintf(stderr, "%s: %s\n", j.in.c_str(), j.err.c_str());
+        continue;
+      }
+      char fmt[24];
+      if (j.hasHeader) snprintf(fmt, sizeof(fmt), "v%u recSize=%u", j.version, j.recSize);
+      else snprintf(fmt, sizeof(fmt), "no header");
+      printf("%s -> %s  (%s, records=%zu%s%s, %.1f ms)\n", j.in.c_str(), baseName(j.out).c_str(), fmt,
+             j.records, j.events ? ", events=" : "", j.events ? std::to_string(j.events).c_str() : "", j.ms);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < n; i++) threads.emplace_back(worker);
+  for (std::thread& t : threads) t.join();
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  size_t okFiles = 0, records = 0, inBytes = 0;
+  for (const Job& j : jobs) {
+    if (!j.ok) continue;
+    okFiles++;
+    records += j.records;
+    inBytes += j.inBytes;
+  }
+  printf("%zu/%zu files, %zu records, %.1f MB in %.3f s (%u threads, %.0f MB/s)\n", okFiles, jobs.size(), records,
+         inBytes / 1e6, sec, n, sec > 0 ? inBytes / 1e6 / sec : 0.0);
+  return (inputOk && okFiles == jobs.size()) ? 0 : 1;
+}
@@ -0,0 +1,292 @@
+#ifndef RLG_LOG_H
+#define RLG_LOG_H
+
+// ============================================================================
+// SD 로그(FL*.BIN) 읽기/쓰기 (호스트 도구 공용)
+//  - RLG1 : LogHeader{ "RLG1", version, recSize } + FlightData 레코드 반복
+//  - 헤더 없는 초기 로그(FLIGHT.BIN)는 recSize = RLG_LEGACY_REC_SIZE(103)로 간주
+//  - recSize가 현재 FlightData와 다르면 앞부분만 복사하고 나머지는 0
+//  - 연속 할당 로그(sdRawLog.h)는 뒤쪽이 erase 상태 -> 전부 0x00 / 0xFF인 레코드에서 멈춤
+//  - version 2 : 델타/varint 압축 (logCodec.h). 첫 키프레임 전 델타는 건너뜀
+//                태그가 0x00 / 0xFF면 erase 영역, 그 밖의 이상한 바이트에서도 멈춤 (badBytes)
+//  - version 3 : 종류별 레코드 (logRecords.h). 레코드마다 직전 값에 덮어쓴 FlightData 하나
+//                (timeMs = 레코드 시각), 이벤트는 events에 따로
+//  - version 4 : v3 레코드 + SYNC/SEQ/CRC16 프레임 (logFrame.h). 한 번 훑으면서 깨진 구간은
+//                다음 SYNC로 건너뛰어 다시 맞춤 (resyncs, skippedBytes), SEQ 빈 곳은 lostRecords
+//  - 파일은 mmap으로 읽음 (rlgLoad). 이미 메모리에 있는 내용은 rlgParse
+// ============================================================================
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "flightType.h"
+#include "logCodec.h"
+#include "logRecords.h"
+#include "logFrame.h"
+
+struct RlgLog {
+  bool hasHeader = false;
+  uint16_t version = 0;
+  uint16_t recSize = 0;
+  size_t trailingBytes = 0;  // 마지막 레코드가 잘린 경우 남은 바이트
+  size_t unusedBytes = 0;    // 미리 할당만 하고 안 쓴 뒤쪽 (erase 상태)
+  // version 2
+  size_t keyframes = 0;
+  size_t skippedNoKey = 0;   // 첫 키프레임 전 델타
+  size_t badBytes = 0;       // 해석 못 한 뒤쪽
+  // version 3
+  size_t typeCount[5] = { 0 };  // I B G S V
+  size_t unknownRecs = 0;
+  std::vector<LrEventOut> events;
+  // version 4
+  size_t resyncs = 0;        // 깨진 구간 뒤에서 다시 맞춘 횟수
+  size_t skippedBytes = 0;   // 건너뛴 바이트 (파일 끝의 잘린 프레임 제외)
+  size_t seqGaps = 0;
+  size_t lostRecords = 0;    // SEQ로 센 빠진 레코드 (SD 버퍼에서 버린 것 + 깨진 구간)
+  std::vector<FlightData> records;
+};
+
+static const size_t RLG_HEADER_SIZE = 8;
+static const uint16_t RLG_LEGACY_REC_SIZE = 103;  // est 추가 전 FlightData
+
+// 레코드 전체가 한 값(0x00 또는 0xFF)이면 아직 안 쓴 영역
+inline bool rlgIsErased(const uint8_t* p, size_t n) {
+  if (p[0] != 0x00 && p[0] != 0xFF) return false;
+  for (size_t i = 1; i < n; i++) {
+    if (p[i] != p[0]) return false;
+  }
+  return true;
+}
+
+// buf 끝에서부터 erase 상태(같은 값 0x00 또는 0xFF)가 이어지는 길이 (from 이후만)
+inline size_t rlgErasedTail(const uint8_t* buf, size_t size, size_t from) {
+  if (size <= from) return 0;
+  uint8_t e = buf[size - 1];
+  if (e != 0x00 && e != 0xFF) return 0;
+  size_t i = size;
+  while (i > from && buf[i - 1] == e) i--;
+  return size - i;
+}
+
+inline bool rlgDecodeDelta(const uint8_t* buf, size_t size, size_t off, RlgLog& log, std::string& err) {
+  if (log.recSize != sizeof(FlightData)) {
+    err = "v2 log recSize does not match this FlightData";
+    return false;
+  }
+  LogDecoder dec;
+  memset(&dec, 0, sizeof(dec));
+  while (off < size) {
+    uint8_t tag = buf[off];
+    if (tag == 0x00 || tag == 0xFF) {
+      log.unusedBytes = size - off;
+      break;
+    }
+    FlightData f;
+    size_t used;
+    LogDecodeResult r = logDecode(dec, buf + off, size - off, f, used);
+    if (r == LOGC_SHORT || r == LOGC_BAD) {
+      // 전원이 끊겨 찢어진 마지막 레코드 + 뒤쪽 erase 영역
+      log.unusedBytes = rlgErasedTail(buf, size, off);
+      size_t rest = size - off - log.unusedBytes;
+      if (r == LOGC_SHORT || log.unusedBytes) log.trailingBytes = rest;
+      else log.badBytes = rest;
+      break;
+    }
+    off += used;
+    if (r == LOGC_NO_KEY) {
+      log.skippedNoKey++;
+      continue;
+    }
+    if (tag == LOGC_TAG_KEY) log.keyframes++;
+    log.records.push_back(f);
+  }
+  return true;
+}
+
+// 레코드 하나를 f에 반영하고 log에 스냅샷/이벤트 추가
+inline LrResult rlgApplyTyped(const uint8_t* p, size_t avail, FlightData& f, RlgLog& log, size_t& used) {
+  static const uint8_t tags[5] = { LR_TAG_IMU, LR_TAG_BARO, LR_TAG_GPS, LR_TAG_STATUS, LR_TAG_EVENT };
+  LrEventOut ev;
+  LrResult r = lrApply(p, avail, f, ev, used);
+  if (r == LR_UNKNOWN) log.unknownRecs++;
+  if (r != LR_OK) return r;
+  for (int k = 0; k < 5; k++) {
+    if (tags[k] == p[0]) log.typeCount[k]++;
+  }
+  if (ev.valid) log.events.push_back(ev);
+  log.records.push_back(f);
+  return r;
+}
+
+inline bool rlgDecodeTyped(const uint8_t* buf, size_t size, size_t off, RlgLog& log) {
+  FlightData f;
+  memset(&f, 0, sizeof(f));
+  while (off < size) {
+    if (buf[off] == 0x00 || buf[off] == 0xFF) {
+      log.unusedBytes = size - off;
+      break;
+    }
+    size_t used;
+    LrResult r = rlgApplyTyped(buf + off, size - off, f, log, used);
+    if (r == LR_SHORT || r == LR_BAD) {
+      log.unusedBytes = rlgErasedTail(buf, size, off);
+      size_t rest = size - off - log.unusedBytes;
+      if (r == LR_SHORT || log.unusedBytes) log.trailingBytes = rest;
+      else log.badBytes = rest;
+      break;
+    }
+    off += used;
+  }
+  return true;
+}
+
+inline bool rlgDecodeFramed(const uint8_t* buf, size_t size, size_t off, RlgLog& log) {
+  FlightData f;
+  memset(&f, 0, sizeof(f));
+  size_t tail = size - rlgErasedTail(buf, size, off);  // 이 뒤는 안 쓴 영역
+  bool haveSeq = false;
+  uint16_t expect = 0;
+  while (off < tail) {
+    uint16_t seq;
+    uint8_t n;
+    if (lfCheck(buf + off, size - off, seq, n) == LF_OK) {
+      if (haveSeq && seq != expect) {
+        log.seqGaps++;
+        log.lostRecords += (uint16_t)(seq - expect);
+      }
+      haveSeq = true;
+      expect = (uint16_t)(seq + 1);
+      size_t used;
+      if (rlgApplyTyped(buf + off + LF_HEAD, n, f, log, used) == LR_BAD) log.skippedBytes += n;
+      off += LF_OVERHEAD + n;
+      continue;
+    }
+    // 다음 SYNC1 후보에서 다시 시도 (memchr로 한 번에)
+    const uint8_t* next = (const uint8_t*)memchr(buf + off + 1, LF_SYNC1, tail - off - 1);
+    size_t to = next ? (size_t)(next - buf) : tail;
+    // 뒤에 맞는 프레임이 하나도 없으면 파일 끝의 잘린 프레임
+    size_t probe = to;
+    while (probe < tail) {
+      uint16_t s2;
+      uint8_t n2;
+      if (lfCheck(buf + probe, size - probe, s2, n2) == LF_OK) break;
+      const uint8_t* q = (const uint8_t*)memchr(buf + probe + 1, LF_SYNC1, tail - probe - 1);
+      probe = q ? (size_t)(q - buf) : tail;
+    }
+    if (probe >= tail) {
+      log.trailingBytes = tail - off;
+      off = tail;
+      break;
+    }
+    log.skippedBytes += probe - off;
+    log.resyncs++;
+    off = probe;
+  }
+  log.unusedBytes = size - (off > tail ? off : tail);
+  return true;
+}
+
+inline bool rlgParse(const uint8_t* buf, size_t size, RlgLog& log, std::string& err) {
+  size_t off = 0;
+  log = RlgLog();
+  if (size >= RLG_HEADER_SIZE && memcmp(buf, "RLG1", 4) == 0) {
+    log.hasHeader = true;
+    log.version = (uint16_t)(buf[4] | (buf[5] << 8));
+    log.recSize = (uint16_t)(buf[6] | (buf[7] << 8));
+    off = RLG_HEADER_SIZE;
+  } else {
+    log.recSize = RLG_LEGACY_REC_SIZE;
+  }
+  if (log.recSize == 0) {
+    err = "recSize 0";
+    return false;
+  }
+
+  if (log.hasHeader && log.version == LOGC_VERSION) return rlgDecodeDelta(buf, size, off, log, err);
+  if (log.hasHeader && log.version == LR_VERSION) return rlgDecodeTyped(buf, size, off, log);
+  if (log.hasHeader && log.version == LF_VERSION) return rlgDecodeFramed(buf, size, off, log);
+  if (log.hasHeader && log.version > LF_VERSION) {
+    err = "unknown RLG1 version " + std::to_string(log.version);
+    return false;
+  }
+
+  size_t count = (size - off) / log.recSize;
+  log.trailingBytes = (size - off) % log.recSize;
+  for (size_t i = 0; i < count; i++) {
+    if (rlgIsErased(buf + off + i * log.recSize, log.recSize)) {
+      log.unusedBytes = size - off - i * log.recSize;
+      log.trailingBytes = 0;
+      count = i;
+      break;
+    }
+  }
+  log.records.resize(count);
+  size_t copy = log.recSize < sizeof(FlightData) ? log.recSize : sizeof(FlightData);
+  for (size_t i = 0; i < count; i++) {
+    memset(&log.records[i], 0, sizeof(FlightData));
+    memcpy(&log.records[i], buf + off + i * log.recSize, copy);
+  }
+  return true;
+}
+
+// 읽기 전용 mmap (빈 파일은 data = nullptr, size = 0)
+struct RlgMap {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+};
+
+inline bool rlgMapOpen(const char* path, RlgMap& m, std::string& err) {
+  m = RlgMap();
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    err = std::string("cannot open ") + path;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    err = std::string("cannot stat ") + path;
+    return false;
+  }
+  m.size = (size_t)st.st_size;
+  if (m.size > 0) {
+    void* p = mmap(nullptr, m.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      err = std::string("cannot mmap ") + path;
+      return false;
+    }
+    madvise(p, m.size, MADV_SEQUENTIAL);
+    m.data = (const uint8_t*)p;
+  }
+  close(fd);  // 매핑은 fd를 닫아도 유지됨
+  return true;
+}
+
+inline void rlgMapClose(RlgMap& m) {
+  if (m.data) munmap((void*)m.data, m.size);
+  m = RlgMap();
+}
+
+inline bool rlgLoad(const char* path, RlgLog& log, std::string& err) {
+  RlgMap m;
+  if (!rlgMapOpen(path, m, err)) return false;
+  bool ok = rlgParse(m.data, m.size, log, err);
+  rlgMapClose(m);
+  return ok;
+}
+
+inline bool rlgWriteHeader(FILE* fp, uint16_t version = 1) {
+  uint8_t hdr[RLG_HEADER_SIZE] = { 'R', 'L', 'G', '1', (uint8_t)version, (uint8_t)(version >> 8),
+                                   (uint8_t)(sizeof(FlightData) & 0xFF),
+                                   (uint8_t)(sizeof(FlightData) >> 8) };
+  return fwrite(hdr, 1, sizeof(hdr), fp) == sizeof(hdr);
+}
+
+#endif
@@ -0,0 +1,248 @@
+// ============================================================================
+// 합성 비행 로그 생성기 (리플레이 회귀 테스트용)
+//  - 1차원 수직 비행: 발사대 대기 -> 등추력 연소 -> 관성 상승 -> 하강 (낙하산 없음)
+//  - 기압 고도는 updateBaro()와 같은 20Hz + LPF(0.2) 상승률, 로그는 LOG_PERIOD_MS(100ms)
+//  - 노이즈는 고정 시드라 매번 같은 파일이 나옴
+//
+//  - --delta : RLG1 v2 압축 포맷 (logCodec.h, 키프레임 10레코드마다)
+//  - --typed : RLG1 v3 종류별 레코드 (logRecords.h). IMU 100Hz, 기압은 갱신마다, 상태 50Hz
+//  - --framed : RLG1 v4 (v3 + SYNC/SEQ/CRC16 프레임, logFrame.h)
+//  - --prelaunch : v3/v4에서 sensorMain 발사 전 링(preRing.h) 흉내. 발사 전에는 SD에 1초마다 상태/기압만,
+//                  고속 레코드는 링에 두었다가 발사 시각에 한꺼번에 (SD 대역폭은 무한으로 가정)
+//  - --corrupt-every N : 다 쓴 뒤 512B 섹터 N개마다 하나를 망가뜨림 (쓰레기 / 0x00 번갈아)
+//                        비행 데이터와 별도 시드라 망가뜨리기 전 내용은 같음
+//
+//   rlg_synth --out synth.bin [--burn-s 2.5] [--thrust-g 6] [--noise-m 0.3] [--delta | --typed | --framed]
+//             [--prelaunch] [--corrupt-every N]
+// ============================================================================
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "rlg_log.h"
+#include "preRing.h"
+
+static const float G = 9.81f;
+static const float A2B_ACC_PER_MPS2 = 10.0f / 9.80665f;  // pinMain이 보내는 가속도 단위 (mg/100)
+
+// 고정 시드 가우시안 근사 (균등분포 12개 합)
+static uint32_t g_rng = 12345;
+static float noise() {
+  float s = 0.0f;
+  for (int i = 0; i < 12; i++) {
+    g_rng = g_rng * 1664525u + 1013904223u;
+    s += (g_rng >> 8) / 16777216.0f;
+  }
+  return s - 6.0f;
+}
+
+static float pressureAt(float alt_m, float p0_hPa) {
+  return p0_hPa * powf(1.0f - alt_m / 44330.0f, 5.255f);
+}
+
+int main(int argc, char** argv) {
+  const char* out = nullptr;
+  float padS = 5.0f;        // 발사 전 대기
+  float burnS = 2.5f;       // 연소 시간
+  float thrustG = 6.0f;     // 추력 가속도 (중력 제외)
+  float dragK = 0.0015f;    // 항력 가속도 = k * v|v|
+  float noiseM = 0.3f;      // 기압 고도 노이즈 (1 sigma)
+  float afterApogeeS = 15.0f;
+  uint32_t bootMs = 3400;   // 첫 레코드 시각 (p0 보정 후)
+  bool delta = false;
+  bool typed = false;
+  bool framed = false;
+  bool prelaunch = false;
+  uint32_t corruptEvery = 0;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    bool hasVal = (i + 1 < argc);
+    if (a == "--out" && hasVal) out = argv[++i];
+    else if (a == "--pad-s" && hasVal) padS = strtof(argv[++i], nullptr);
+    else if (a == "--burn-s" && hasVal) burnS = strtof(argv[++i], nullptr);
+    else if (a == "--thrust-g" && hasVal) thrustG = strtof(argv[++i], nullptr);
+    else if (a == "--drag-k" && hasVal) dragK = strtof(argv[++i], nullptr);
+    else if (a == "--noise-m" && hasVal) noiseM = strtof(argv[++i], nullptr);
+    else if (a == "--after-apogee-s" && hasVal) afterApogeeS = strtof(argv[++i], nullptr);
+    else if (a == "--delta") delta = true;
+    else if (a == "--typed") typed = true;
+    else if (a == "--framed") typed = framed = true;
+    else if (a == "--prelaunch") prelaunch = true;
+    else if (a == "--corrupt-every" && hasVal) corruptEvery = (uint32_t)strtoul(argv[++i], nullptr, 10);
+    else {
+      fprintf(stderr, "usage: %s --out FILE [--pad-s S] [--burn-s S] [--thrust-g G] [--drag-k K] [--noise-m M] [--after-apogee-s S] [--delta | --typed | --framed] [--prelaunch] [--corrupt-every N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (prelaunch && !typed) {
+    fprintf(stderr, "--prelaunch needs --typed or --framed\n");
+    return 2;
+  }
+  if (!out) {
+    fprintf(stderr, "--out required\n");
+    return 2;
+  }
+
+  LogEncoder enc;
+  logEncInit(enc, 10);  // 100ms 레코드 -> 1초마다 키프레임
+
+  FILE* fp = fopen(out, "wb");
+  uint16_t version = framed ? LF_VERSION : (typed ? LR_VERSION : (delta ? LOGC_VERSION : 1));
+  if (!fp || !rlgWriteHeader(fp, version)) {
+    fprintf(stderr, "cannot write %s\n", out);
+    return 1;
+  }
+
+  const float p0 = 1013.25f;
+  const uint32_t DT_MS = 1;            // 적분 간격
+  const uint32_t BARO_PERIOD_MS = 50;  // updateBaro 주기
+  const uint32_t LOG_PERIOD_MS = 100;  // sdLogWrite 주기
+  const uint32_t IMU_PERIOD_MS = typed ? 10 : LOG_PERIOD_MS;  // v3는 A2B 프레임마다
+  const uint32_t STATUS_PERIOD_MS = 20;
+
+  float h = 0.0f, v = 0.0f, specific = G;  // specific: 가속도계가 느끼는 비력 (m/s^2)
+  float altPrev = 0.0f, climbFilt = 0.0f;
+  bool havePrev = false;
+  bool apogeeSeen = false;
+  float apogeeAlt = 0.0f;
+  uint32_t apogeeMs = 0, launchMs = bootMs + (uint32_t)(padS * 1000.0f);
+
+  FlightData f;
+  memset(&f, 0, sizeof(f));
+  f.state = STANDBY;
+  uint32_t nRec = 0;
+  uint16_t seq = 0;
+
+  static PreRing ring;
+  preRingInit(ring);
+  bool pre = prelaunch;
+  uint32_t ringDumped = 0;
+
+  // v3: 레코드 그대로, v4: 프레임으로 감싸서 (sensorMain logFrameWrite와 같음)
+  auto writeRec = [&](uint8_t* frame, uint8_t n) {
+    if (framed) fwrite(frame, 1, lfWrap(frame, seq++, n), fp);
+    else fwrite(frame + LF_HEAD, 1, n, fp);
+    nRec++;
+  };
+  auto emitTyped = [&](uint8_t (*encode)(uint8_t*, const FlightData&), bool direct) {
+    uint8_t frame[LF_MAX_FRAME];
+    uint8_t n = encode(frame + LF_HEAD, f);
+    if (pre && !direct) preRingPush(ring, frame + LF_HEAD, n);
+    else if (!pre || direct) writeRec(frame, n);
+  };
+
+  for (uint32_t t = bootMs;; t += DT_MS) {
+    // 발사 감지 (T0 첫 IMU 샘플에서) -> 링을 통째로 내보냄
+    if (pre && t >= launchMs) {
+      pre = false;
+      uint8_t frame[LF_MAX_FRAME];
+      while (!preRingEmpty(ring)) {
+        writeRec(frame, preRingPop(ring, frame + LF_HEAD));
+        ringDumped++;
+      }
+    }
+    // ====== 운동 ======
+    float tf = (t - launchMs) / 1000.0f;
+    if (t >= launchMs) {
+      float thrust = (tf < burnS) ? thrustG * G : 0.0f;
+      float drag = -dragK * v * fabsf(v);
+      float a = thrust + drag - G;
+      if (h <= 0.0f && a < 0.0f && v <= 0.0f) a = 0.0f;  // 발사대 위
+      v += a * DT_MS / 1000.0f;
+      h += v * DT_MS / 1000.0f;
+      if (h < 0.0f) {
+        h = 0.0f;
+        v = 0.0f;
+      }
+      specific = thrust + drag;
+    }
+    if (!apogeeSeen && t > launchMs + 100 && v <= 0.0f) {
+      apogeeSeen = true;
+      apogeeAlt = h;
+      apogeeMs = t;
+    }
+
+    // ====== 기압계 (updateBaro와 같은 계산) ======
+    if ((t - bootMs) % BARO_PERIOD_MS == 0) {
+      float alt = h + noiseM * noise();
+      if (havePrev) {
+        float raw = (alt - altPrev) / (BARO_PERIOD_MS / 1000.0f);
+        climbFilt = 0.8f * climbFilt + 0.2f * raw;
+      }
+      havePrev = true;
+      altPrev = alt;
+      f.baro.pressure = pressureAt(alt, p0);
+      f.baro.temperature = 20.0f - 0.0065f * h;
+      f.baro.altitude = alt;
+      f.baro.climbRate = climbFilt;
+      f.baroTimeMs = t;
+      if (typed) emitTyped(lrEncodeBaro, false);
+    }
+
+    // ====== A2B IMU ======
+    if ((t - bootMs) % IMU_PERIOD_MS == 0) {
+      // A2B 단위 (mg/100, 1g = 10.0)
+      f.imu.ax = A2B_ACC_PER_MPS2 * 0.05f * noise();
+      f.imu.ay = A2B_ACC_PER_MPS2 * 0.05f * noise();
+      f.imu.az = A2B_ACC_PER_MPS2 * (specific + 0.05f * noise());
+      f.aTimeMs = t - 3;
+      f.aRxTimeMs = t - 1;
+      if (typed) emitTyped(lrEncodeImu, false);
+    }
+
+    // ====== 로그 ======
+    if (typed && pre && (t - bootMs) % 1000 == 0) {
+      f.timeMs = t;  // 하트비트 (sensorMain LOG_HEARTBEAT_MS)
+      emitTyped(lrEncodeStatus, true);
+      emitTyped(lrEncodeBaro, true);
+    } else if (typed && !pre && (t - bootMs) % STATUS_PERIOD_MS == 0) {
+      f.timeMs = t;
+      emitTyped(lrEncodeStatus, false);
+    } else if (!typed && (t - bootMs) % LOG_PERIOD_MS == 0) {
+      f.timeMs = t;
+      if (delta) {
+        uint8_t rec[LOGC_MAX_REC];
+        uint8_t n = logEncode(enc, f, rec);
+        fwrite(rec, 1, n, fp);
+      } else {
+        fwrite(&f, sizeof(f), 1, fp);
+      }
+      nRec++;
+    }
+
+    if (apogeeSeen && t >= apogeeMs + (uint32_t)(afterApogeeS * 1000.0f)) break;
+    if (t > launchMs + 600000) break;  // 안전장치
+  }
+  long fileBytes = ftell(fp);
+
+  // 섹터 손상 (헤더가 있는 첫 섹터는 남김)
+  uint32_t corrupted = 0;
+  if (corruptEvery) {
+    uint32_t rng = 777;
+    for (long blk = corruptEvery; (blk + 1) * 512 <= fileBytes; blk += corruptEvery) {
+      uint8_t sec[512];
+      for (int k = 0; k < 512; k++) {
+        rng = rng * 1664525u + 1013904223u;
+        sec[k] = (corrupted & 1) ? 0x00 : (uint8_t)(rng >> 24);
+      }
+      fseek(fp, blk * 512, SEEK_SET);
+      fwrite(sec, 1, sizeof(sec), fp);
+      corrupted++;
+    }
+  }
+  fclose(fp);
+
+  if (delta) printf("delta: %u keyframes, %.1f B/record (x%.2f)\n", (unsigned)enc.keys,
+                    enc.records ? (double)enc.outBytes / enc.records : 0.0,
+                    enc.outBytes ? (double)enc.rawBytes / enc.outBytes : 0.0);
+  if (prelaunch) printf("prelaunch: ring %u B, dumped %u records at launch, %u evicted before\n", PRE_RING_BYTES,
+                        ringDumped, (unsigned)ring.evicted);
+  if (corruptEvery) printf("corrupted %u sectors (every %u)\n", corrupted, corruptEvery);
+  printf("%s: %u records, launch %u ms, apogee %.1f m @ %u ms\n", out, nRec, launchMs, apogeeAlt, apogeeMs);
+  return 0;
+}
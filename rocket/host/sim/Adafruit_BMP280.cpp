@@ -0,0 +1,107 @@
+// Adafruit_BMP280 호스트 구현 (원본 드라이버의 정수 보상식/트랜잭션 순서 유지)
+
+#include "Adafruit_BMP280.h"
+
+uint8_t Adafruit_BMP280::read8(uint8_t reg) {
+  wire_->beginTransmission(addr_);
+  wire_->write(reg);
+  wire_->endTransmission();
+  wire_->requestFrom(addr_, (uint8_t)1);
+  return (uint8_t)wire_->read();
+}
+
+void Adafruit_BMP280::write8(uint8_t reg, uint8_t v) {
+  wire_->beginTransmission(addr_);
+  wire_->write(reg);
+  wire_->write(v);
+  wire_->endTransmission();
+}
+
+uint32_t Adafruit_BMP280::read24(uint8_t reg) {
+  wire_->beginTransmission(addr_);
+  wire_->write(reg);
+  wire_->endTransmission();
+  wire_->requestFrom(addr_, (uint8_t)3);
+  uint32_t v = (uint32_t)wire_->read();
+  v = (v << 8) | (uint32_t)wire_->read();
+  v = (v << 8) | (uint32_t)wire_->read();
+  return v;
+}
+
+bool Adafruit_BMP280::begin(uint8_t addr, uint8_t chipid) {
+  addr_ = addr;
+  wire_->beginTransmission(addr_);
+  if (wire_->endTransmission() != 0) return false;
+  id_ = read8(0xD0);
+  if (id_ != chipid) return false;
+
+  uint8_t c[24];
+  wire_->beginTransmission(addr_);
+  wire_->write((uint8_t)0x88);
+  wire_->endTransmission();
+  wire_->requestFrom(addr_, (uint8_t)24);
+  for (int i = 0; i < 24; i++) c[i] = (uint8_t)wire_->read();
+  auto u16 = [&c](int i) { return (uint16_t)(c[i] | (c[i + 1] << 8)); };
+  T1_ = u16(0);
+  T2_ = (int16_t)u16(2);
+  T3_ = (int16_t)u16(4);
+  P1_ = u16(6);
+  P2_ = (int16_t)u16(8);
+  P3_ = (int16_t)u16(10);
+  P4_ = (int16_t)u16(12);
+  P5_ = (int16_t)u16(14);
+  P6_ = (int16_t)u16(16);
+  P7_ = (int16_t)u16(18);
+  P8_ = (int16_t)u16(20);
+  P9_ = (int16_t)u16(22);
+
+  setSampling();
+  delay(100);
+  return true;
+}
+
+void Adafruit_BMP280::setSampling(sensor_mode mode, sensor_sampling tempSampling, sensor_sampling pressSampling,
+                                  sensor_filter filter, standby_duration duration) {
+  write8(0xF5, (uint8_t)((duration << 5) | (filter << 2)));
+  write8(0xF4, (uint8_t)((tempSampling << 5) | (pressSampling << 2) | mode));
+}
+
+float Adafruit_BMP280::readTemperature() {
+  int32_t adc_T = (int32_t)read24(0xFA);
+  adc_T >>= 4;
+
+  int32_t var1 = ((((adc_T >> 3) - ((int32_t)T1_ << 1))) * ((int32_t)T2_)) >> 11;
+  int32_t var2 = (((((adc_T >> 4) - ((int32_t)T1_)) * ((adc_T >> 4) - ((int32_t)T1_))) >> 12) * ((int32_t)T3_)) >> 14;
+  tFine_ = var1 + var2;
+
+  float T = (float)((tFine_ * 5 + 128) >> 8);
+  return T / 100.0f;
+}
+
+float Adafruit_BMP280::readPressure() {
+  // 원본 드라이버와 동일: t_fine을 위해 온도를 다시 읽음
+  readTemperature();
+
+  int32_t adc_P = (int32_t)read24(0xF7);
+  adc_P >>= 4;
+
+  int64_t var1 = ((int64_t)tFine_) - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)P6_;
+  var2 = var2 + ((var1 * (int64_t)P5_) << 17);
+  var2 = var2 + (((int64_t)P4_) << 35);
+  var1 = ((var1 * var1 * (int64_t)P3_) >> 8) + ((var1 * (int64_t)P2_) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)P1_) >> 33;
+  if (var1 == 0) return 0;
+
+  int64_t p = 1048576 - adc_P;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)P9_) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)P8_) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (((int64_t)P7_) << 4);
+  return (float)p / 256.0f;
+}
+
+float Adafruit_BMP280::readAltitude(float seaLevelhPa) {
+  float pressure = readPressure() / 100.0f;
+  return 44330.0f * (1.0f - powf(pressure / seaLevelhPa, 0.1903f));
+}
@@ -0,0 +1,58 @@
+#ifndef SIM_ADAFRUIT_BMP280_H
+#define SIM_ADAFRUIT_BMP280_H
+
+// Adafruit_BMP280 호스트 구현 (Wire 위에서 실제 드라이버와 같은 트랜잭션 패턴)
+//  - readTemperature(): 0xFA에서 3바이트
+//  - readPressure(): 내부에서 readTemperature()를 다시 부른 뒤 0xF7에서 3바이트
+
+#include "Arduino.h"
+#include "Wire.h"
+
+class Adafruit_BMP280 {
+public:
+  enum sensor_sampling {
+    SAMPLING_NONE = 0x00,
+    SAMPLING_X1 = 0x01,
+    SAMPLING_X2 = 0x02,
+    SAMPLING_X4 = 0x03,
+    SAMPLING_X8 = 0x04,
+    SAMPLING_X16 = 0x05
+  };
+  enum sensor_mode { MODE_SLEEP = 0x00, MODE_FORCED = 0x01, MODE_NORMAL = 0x03, MODE_SOFT_RESET_CODE = 0xB6 };
+  enum sensor_filter { FILTER_OFF = 0x00, FILTER_X2 = 0x01, FILTER_X4 = 0x02, FILTER_X8 = 0x03, FILTER_X16 = 0x04 };
+  enum standby_duration {
+    STANDBY_MS_1 = 0x00,
+    STANDBY_MS_63 = 0x01,
+    STANDBY_MS_125 = 0x02,
+    STANDBY_MS_250 = 0x03,
+    STANDBY_MS_500 = 0x04,
+    STANDBY_MS_1000 = 0x05,
+    STANDBY_MS_2000 = 0x06,
+    STANDBY_MS_4000 = 0x07
+  };
+
+  explicit Adafruit_BMP280(TwoWire* wire = &Wire) : wire_(wire) {}
+
+  bool begin(uint8_t addr = 0x77, uint8_t chipid = 0x58);
+  void setSampling(sensor_mode mode = MODE_NORMAL, sensor_sampling tempSampling = SAMPLING_X16,
+                   sensor_sampling pressSampling = SAMPLING_X16, sensor_filter filter = FILTER_OFF,
+                   standby_duration duration = STANDBY_MS_1);
+  float readTemperature();
+  float readPressure();
+  float readAltitude(float seaLevelhPa = 1013.25f);
+  uint8_t sensorID() const { return id_; }
+
+private:
+  uint8_t read8(uint8_t reg);
+  void write8(uint8_t reg, uint8_t v);
+  uint32_t read24(uint8_t reg);
+
+  TwoWire* wire_;
+  uint8_t addr_ = 0x77;
+  uint8_t id_ = 0;
+  int32_t tFine_ = 0;
+  uint16_t T1_ = 0, P1_ = 0;
+  int16_t T2_ = 0, T3_ = 0, P2_ = 0, P3_ = 0, P4_ = 0, P5_ = 0, P6_ = 0, P7_ = 0, P8_ = 0, P9_ = 0;
+};
+
+#endif
@@ -0,0 +1,91 @@
+// PCA9685 레지스터 모델 + 드라이버
+
+#include "Adafruit_PWMServoDriver.h"
+#include "sim_internal.h"
+
+namespace {
+
+class Pca9685Model : public sim::I2cDevice {
+public:
+  Pca9685Model() { sim::registerI2c(0x40, this); }
+  void onWrite(const uint8_t* data, size_t n) override {
+    if (n == 0) return;
+    ptr_ = data[0];
+    for (size_t i = 1; i < n; i++) regs_[(uint8_t)(ptr_ + i - 1)] = data[i];
+  }
+  void onRead(uint8_t* out, size_t n) override {
+    for (size_t i = 0; i < n; i++) out[i] = regs_[(uint8_t)(ptr_ + i)];
+  }
+  uint16_t offTicks(uint8_t ch) const {
+    uint8_t base = (uint8_t)(0x06 + 4 * ch);
+    return (uint16_t)(regs_[base + 2] | ((regs_[base + 3] & 0x0F) << 8));
+  }
+
+private:
+  uint8_t regs_[256] = {};
+  uint8_t ptr_ = 0;
+};
+
+Pca9685Model g_pca;
+
+}  // namespace
+
+namespace sim {
+uint16_t pwmTicks(uint8_t channel) { return g_pca.offTicks(channel); }
+}  // namespace sim
+
+void Adafruit_PWMServoDriver::write8(uint8_t reg, uint8_t v) {
+  wire_->beginTransmission(addr_);
+  wire_->write(reg);
+  wire_->write(v);
+  wire_->endTransmission();
+}
+
+bool Adafruit_PWMServoDriver::begin(uint8_t prescale) {
+  reset();
+  if (prescale) {
+    write8(0xFE, prescale);
+  } else {
+    setPWMFreq(1000);
+  }
+  return true;
+}
+
+void Adafruit_PWMServoDriver::reset() {
+  write8(0x00, 0x80);
+  delay(10);
+}
+
+void Adafruit_PWMServoDriver::setPWMFreq(float freq) {
+  if (freq < 1) freq = 1;
+  if (freq > 3500) freq = 3500;
+  freq_ = freq;
+  float prescaleval = ((osc_ / (freq * 4096.0f)) + 0.5f) - 1;
+  uint8_t prescale = (uint8_t)constrain(prescaleval, 3.0f, 255.0f);
+  write8(0x00, 0x10);  // sleep
+  write8(0xFE, prescale);
+  write8(0x00, 0x00);
+  delay(5);
+  write8(0x00, 0xA0);  // restart + auto increment
+}
+
+uint8_t Adafruit_PWMServoDriver::setPWM(uint8_t num, uint16_t on, uint16_t off) {
+  wire_->beginTransmission(addr_);
+  wire_->write((uint8_t)(0x06 + 4 * num));
+  wire_->write((uint8_t)on);
+  wire_->write((uint8_t)(on >> 8));
+  wire_->write((uint8_t)off);
+  wire_->write((uint8_t)(off >> 8));
+  return wire_->endTransmission();
+}
+
+void Adafruit_PWMServoDriver::setPin(uint8_t num, uint16_t val, bool invert) {
+  if (val > 4095) val = 4095;
+  if (invert) val = (uint16_t)(4095 - val);
+  setPWM(num, 0, val);
+}
+
+void Adafruit_PWMServoDriver::writeMicroseconds(uint8_t num, uint16_t us) {
+  double pulselength = 1000000.0 / freq_ / 4096.0;
+  setPWM(num, 0, (uint16_t)(us / pulselength));
+}
@@ -0,0 +1,29 @@
+#ifndef SIM_ADAFRUIT_PWMSERVODRIVER_H
+#define SIM_ADAFRUIT_PWMSERVODRIVER_H
+
+// PCA9685 드라이버 호스트 구현 (원본과 같은 I2C 쓰기 횟수/길이)
+
+#include "Arduino.h"
+#include "Wire.h"
+
+class Adafruit_PWMServoDriver {
+public:
+  explicit Adafruit_PWMServoDriver(uint8_t addr = 0x40, TwoWire& wire = Wire) : addr_(addr), wire_(&wire) {}
+
+  bool begin(uint8_t prescale = 0);
+  void reset();
+  void setPWMFreq(float freq);
+  void setOscillatorFrequency(uint32_t freq) { osc_ = freq; }
+  uint8_t setPWM(uint8_t num, uint16_t on, uint16_t off);
+  void setPin(uint8_t num, uint16_t val, bool invert = false);
+  void writeMicroseconds(uint8_t num, uint16_t us);
+
+private:
+  void write8(uint8_t reg, uint8_t v);
+  uint8_t addr_;
+  TwoWire* wire_;
+  uint32_t osc_ = 25000000;
+  float freq_ = 50.0f;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+// EEPROM 호스트 구현: 4KB (ATmega2560), sim::config().eepromPath 파일에 write-through
+
+#include "Arduino.h"
+
+class EEPROMClass {
+public:
+  static const int SIZE = 4096;
+
+  uint8_t read(int idx);
+  void write(int idx, uint8_t v);
+  void update(int idx, uint8_t v) {
+    if (read(idx) != v) write(idx, v);
+  }
+  uint16_t length() const { return SIZE; }
+
+  template <class T>
+  T& get(int idx, T& t) {
+    uint8_t* p = (uint8_t*)&t;
+    for (size_t i = 0; i < sizeof(T); i++) p[i] = read(idx + (int)i);
+    return t;
+  }
+  template <class T>
+  const T& put(int idx, const T& t) {
+    const uint8_t* p = (const uint8_t*)&t;
+    for (size_t i = 0; i < sizeof(T); i++) update(idx + (int)i, p[i]);
+    return t;
+  }
+
+private:
+  void load();
+  void save();
+  bool loaded_ = false;
+  uint8_t mem_[SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef SIM_HARDWARE_SERIAL_H
+#define SIM_HARDWARE_SERIAL_H
+
+// ============================================================================
+// UART 모델
+//  - 송신: 64B 링버퍼, 보율에 맞춰 가상 시간 경과에 따라 비워짐.
+//          버퍼가 가득 차면 write()가 자리가 날 때까지 시간을 소모 (AVR과 동일한 블로킹)
+//  - 수신: 외부에서 도착 시각과 함께 주입, 64B 버퍼가 넘치면 버림 (AVR과 동일)
+// ============================================================================
+
+#include <deque>
+#include <functional>
+
+class HardwareSerial : public Stream {
+public:
+  static const size_t TX_BUFFER_SIZE = 64;
+  static const size_t RX_BUFFER_SIZE = 64;
+
+  explicit HardwareSerial(const char* name) : name_(name) {}
+
+  void begin(unsigned long baud);
+  void end() { baud_ = 0; }
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() override;
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  void flush() override;  // 송신 완료까지 대기
+  using Print::write;
+  explicit operator bool() const { return true; }
+
+  // ---- 시뮬레이터 쪽 ----
+  const char* name() const { return name_; }
+  unsigned long baud() const { return baud_; }
+  double byteUs() const { return baud_ ? 10.0e6 / (double)baud_ : 0.0; }
+
+  // 지금 이후 보율 간격으로 바이트 도착 예약 (이전 예약 뒤에 이어짐)
+  void inject(const uint8_t* data, size_t n);
+  void inject(const char* s) { inject((const uint8_t*)s, strlen(s)); }
+  // 도착 시각 지정
+  void injectAt(uint64_t atUs, const uint8_t* data, size_t n);
+
+  // 송신 바이트가 선로로 나간 시점에 호출 (상대 장치 모델 연결용)
+  std::function<void(uint8_t)> onTx;
+
+  struct Stats {
+    uint32_t txBytes = 0;
+    uint32_t rxBytes = 0;
+    uint32_t rxOverflow = 0;   // 수신 버퍼 초과로 버린 바이트
+    uint32_t txBlockedCalls = 0;
+    uint64_t txBlockedUs = 0;  // write()가 버퍼 대기로 소모한 시간
+  };
+  Stats stats;
+
+  void pump(uint64_t nowUs);  // 가상 시간 진행 시 호출
+
+private:
+  struct Pending {
+    uint64_t atUs;
+    uint8_t b;
+  };
+
+  const char* name_;
+  unsigned long baud_ = 0;
+  bool registered_ = false;
+
+  std::deque<uint8_t> rx_;
+  std::deque<Pending> rxPending_;
+
+  std::deque<uint8_t> txBytes_;
+  double txNextDoneUs_ = 0.0;  // 현재 송신 중인 바이트가 끝나는 시각
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef SIM_ICM_20948_H
+#define SIM_ICM_20948_H
+
+// ============================================================================
+// SparkFun ICM_20948 라이브러리 호스트 구현 (pinMain이 쓰는 부분)
+//  - sim::imu() 모델이 odrHz 주기로 새 샘플 생성
+//  - dataReady()/getAGMT()는 원본과 같은 수의 I2C 트랜잭션 시간을 소모
+//  - FIFO: FIFO_EN_2로 고른 가속도+자이로(12B, big-endian)만. 512B 넘게 쌓이면 오래된 것부터 버림
+// ============================================================================
+
+#include "Arduino.h"
+#include "Wire.h"
+
+typedef enum {
+  ICM_20948_Stat_Ok = 0x00,
+  ICM_20948_Stat_Err,
+  ICM_20948_Stat_NotImpl,
+  ICM_20948_Stat_ParamErr,
+  ICM_20948_Stat_WrongID,
+  ICM_20948_Stat_InvalSensor,
+  ICM_20948_Stat_NoData,
+  ICM_20948_Stat_SensorNotSupported,
+  ICM_20948_Stat_DMPNotSupported,
+  ICM_20948_Stat_DMPVerifyFail,
+  ICM_20948_Stat_FIFONoDataAvail,
+  ICM_20948_Stat_FIFOIncompleteData,
+  ICM_20948_Stat_FIFOMoreDataAvail,
+  ICM_20948_Stat_UnrecognisedDMPHeader,
+  ICM_20948_Stat_UnrecognisedDMPHeader2,
+  ICM_20948_Stat_InvalDMPRegister,
+} ICM_20948_Status_e;
+
+typedef enum {
+  ICM_20948_Internal_Acc = (1 << 0),
+  ICM_20948_Internal_Gyr = (1 << 1),
+  ICM_20948_Internal_Mag = (1 << 2),
+  ICM_20948_Internal_Tmp = (1 << 3),
+  ICM_20948_Internal_Mst = (1 << 4),
+} ICM_20948_InternalSensorID_bm;
+
+enum { gpm2 = 0, gpm4, gpm8, gpm16 };
+enum { dps250 = 0, dps500, dps1000, dps2000 };
+
+typedef struct {
+  uint8_t a;
+  uint8_t g;
+} ICM_20948_fss_t;
+
+typedef enum { acc_d246bw_n265bw = 0 } ICM_20948_ACCEL_CONFIG_DLPCFG_e;
+typedef enum { gyr_d196bw6_n229bw8 = 0 } ICM_20948_GYRO_CONFIG_1_DLPCFG_e;
+
+typedef struct {
+  uint8_t a;
+  uint8_t g;
+} ICM_20948_dlpcfg_t;
+
+typedef struct {
+  uint16_t a;
+  uint8_t g;
+} ICM_20948_smplrt_t;
+
+// 레지스터 주소 (쓰는 것만)
+typedef enum {
+  AGB0_REG_FIFO_EN_2 = 0x67,
+  AGB0_REG_FIFO_COUNT_H = 0x70,
+  AGB0_REG_FIFO_R_W = 0x72,
+} ICM_20948_Reg_Addr_e;
+
+enum inv_icm20948_sensor {
+  INV_ICM20948_SENSOR_ACCELEROMETER = 0,
+  INV_ICM20948_SENSOR_GYROSCOPE,
+  INV_ICM20948_SENSOR_RAW_ACCELEROMETER,
+  INV_ICM20948_SENSOR_RAW_GYROSCOPE,
+  INV_ICM20948_SENSOR_MAGNETIC_FIELD_UNCALIBRATED,
+  INV_ICM20948_SENSOR_GYROSCOPE_UNCALIBRATED,
+  INV_ICM20948_SENSOR_ACTIVITY_CLASSIFICATON,
+  INV_ICM20948_SENSOR_STEP_DETECTOR,
+  INV_ICM20948_SENSOR_STEP_COUNTER,
+  INV_ICM20948_SENSOR_GAME_ROTATION_VECTOR,
+  INV_ICM20948_SENSOR_ROTATION_VECTOR,
+  INV_ICM20948_SENSOR_GEOMAGNETIC_ROTATION_VECTOR,
+  INV_ICM20948_SENSOR_GEOMAGNETIC_FIELD,
+};
+
+enum DMP_ODR_Registers {
+  DMP_ODR_Reg_Accel = 0,
+  DMP_ODR_Reg_Gyro,
+  DMP_ODR_Reg_Cpass,
+  DMP_ODR_Reg_ALS,
+  DMP_ODR_Reg_Quat6,
+  DMP_ODR_Reg_Quat9,
+  DMP_ODR_Reg_PQuat6,
+  DMP_ODR_Reg_Geomag,
+  DMP_ODR_Reg_Pressure,
+  DMP_ODR_Reg_Gyro_Calibr,
+  DMP_ODR_Reg_Cpass_Calibr,
+};
+
+class ICM_20948_I2C {
+public:
+  ICM_20948_Status_e status = ICM_20948_Stat_Ok;
+
+  ICM_20948_Status_e begin(TwoWire& wirePort = Wire, bool ad0val = true, uint8_t ad0pin = 0xFF);
+  const char* statusString(ICM_20948_Status_e stat);
+  const char* statusString() { return statusString(status); }
+
+  ICM_20948_Status_e startupMagnetometer(bool minimal = false);
+  ICM_20948_Status_e setFullScale(uint8_t sensors, ICM_20948_fss_t fss);
+  ICM_20948_Status_e enableDLPF(uint8_t sensors, bool enable);
+  ICM_20948_Status_e setDLPFcfg(uint8_t sensors, ICM_20948_dlpcfg_t cfg);
+  ICM_20948_Status_e setSampleMode(uint8_t sensors, uint8_t mode);
+  ICM_20948_Status_e setSampleRate(uint8_t sensors, ICM_20948_smplrt_t smplrt);
+
+  ICM_20948_Status_e setBank(uint8_t bank);
+  ICM_20948_Status_e write(uint8_t reg, uint8_t* pdata, uint32_t len);
+  ICM_20948_Status_e read(uint8_t reg, uint8_t* pdata, uint32_t len);
+
+  ICM_20948_Status_e initializeDMP();
+  ICM_20948_Status_e enableDMPSensor(enum inv_icm20948_sensor sensor, bool enable = true);
+  ICM_20948_Status_e setDMPODRrate(enum DMP_ODR_Registers odr_reg, int interval);
+  ICM_20948_Status_e enableFIFO(bool enable = true);
+  ICM_20948_Status_e enableDMP(bool enable = true);
+  ICM_20948_Status_e resetDMP();
+  ICM_20948_Status_e resetFIFO();
+  ICM_20948_Status_e setFIFOmode(bool snapshot = false);
+  ICM_20948_Status_e getFIFOcount(uint16_t* count);
+  ICM_20948_Status_e readFIFO(uint8_t* data, uint8_t len = 1);
+
+  bool dataReady();
+  ICM_20948_Status_e getAGMT();
+
+  float accX() const { return acc_[0]; }  // mg
+  float accY() const { return acc_[1]; }
+  float accZ() const { return acc_[2]; }
+  float gyrX() const { return gyr_[0]; }  // dps
+  float gyrY() const { return gyr_[1]; }
+  float gyrZ() const { return gyr_[2]; }
+  float magX() const { return mag_[0]; }  // uT
+  float magY() const { return mag_[1]; }
+  float magZ() const { return mag_[2]; }
+  float temp() const { return 25.0f; }
+
+private:
+  ICM_20948_Status_e busOp(size_t transactions, size_t readBytes);
+  int64_t sampleIndex() const;
+  int64_t fifoPending();
+  void fifoSampleBytes(uint8_t* out) const;
+
+  uint8_t addr_ = 0x69;
+  int64_t lastIdx_ = -1;
+  uint8_t gyroDiv_ = 0;
+  uint8_t fss_[2] = {};      // a, g 풀스케일 코드
+  uint8_t fifoEn2_ = 0;
+  bool fifoOn_ = false;
+  int64_t fifoIdx_ = 0;      // 다음에 읽을 FIFO 샘플 번호
+  uint8_t fifoByte_ = 0;     // 그 샘플 안의 위치
+  float acc_[3] = {};
+  float gyr_[3] = {};
+  float mag_[3] = {};
+};
+
+#endif
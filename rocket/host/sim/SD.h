@@ -0,0 +1,100 @@
+#ifndef SIM_SD_H
+#define SIM_SD_H
+
+// ============================================================================
+// SD 라이브러리 호스트 구현: sim::config().sdDir 디렉터리가 카드 역할
+//  - 쓰기/flush 비용은 sim::sd() 지연 모델로 가상 시간에 반영
+//  - 8.3 파일명은 대문자 그대로 사용
+//  - SD 라이브러리 utility/SdFat.h의 저수준 클래스 일부 (Sd2Card / SdVolume / SdFile)
+//    createContiguous()로 만든 파일만 블록 번호로 접근 가능 (연속 블록 범위를 가상으로 배정)
+// ============================================================================
+
+#include "Arduino.h"
+#include "SPI.h"
+
+#include <memory>
+
+#define FILE_READ 0x01
+#define FILE_WRITE 0x13  // O_READ | O_WRITE | O_CREAT | O_APPEND
+
+class File : public Stream {
+public:
+  File() {}
+  File(const char* path, uint8_t mode);
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int availableForWrite() override { return 512; }
+  int available() override;
+  int read() override;
+  int peek() override;
+  int read(void* buf, uint16_t n);
+  void flush() override;
+  bool seek(uint32_t pos);
+  uint32_t position();
+  uint32_t size();
+  void close();
+  const char* name() const { return name_.c_str(); }
+  bool isDirectory() const { return false; }
+  explicit operator bool() const { return (bool)fp_; }
+
+private:
+  std::shared_ptr<FILE> fp_;
+  std::string name_;
+  uint32_t sectorBytes_ = 0;  // 섹터 경계 계산용 (쓰기 위치 % 512)
+};
+
+class SDClass {
+public:
+  bool begin(uint8_t csPin = 10);
+  bool begin(uint32_t clock, uint8_t csPin) {
+    (void)clock;
+    return begin(csPin);
+  }
+  File open(const char* path, uint8_t mode = FILE_READ);
+  File open(const String& path, uint8_t mode = FILE_READ) { return open(path.c_str(), mode); }
+  bool exists(const char* path);
+  bool exists(const String& path) { return exists(path.c_str()); }
+  bool remove(const char* path);
+  bool mkdir(const char* path);
+  void end() {}
+};
+
+extern SDClass SD;
+
+// ====== utility/Sd2Card.h, utility/SdFat.h (저수준) ======
+#define SPI_FULL_SPEED 0
+#define SPI_HALF_SPEED 1
+#define SPI_QUARTER_SPEED 2
+
+class Sd2Card {
+public:
+  uint8_t init(uint8_t sckRateID = SPI_FULL_SPEED, uint8_t chipSelectPin = 10);
+  // blocking=0 : 데이터 전송 후 바로 리턴, 카드 프로그래밍(busy)은 isBusy()로 확인
+  uint8_t writeBlock(uint32_t blockNumber, const uint8_t* src, uint8_t blocking = 1);
+  uint8_t isBusy();
+  uint8_t erase(uint32_t firstBlock, uint32_t lastBlock);
+  uint8_t errorCode() const { return error_; }
+
+private:
+  uint8_t error_ = 0;
+};
+
+class SdVolume {
+public:
+  uint8_t init(Sd2Card* dev) { return dev != nullptr; }
+};
+
+class SdFile {
+public:
+  uint8_t openRoot(SdVolume* vol) { return vol != nullptr; }
+  uint8_t createContiguous(SdFile* dirFile, const char* fileName, uint32_t size);
+  uint8_t contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock);
+  uint8_t close() { return 1; }
+
+private:
+  uint32_t bgn_ = 0, end_ = 0;
+};
+
+#endif
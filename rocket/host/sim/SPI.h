@@ -0,0 +1,15 @@
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+// SD 모델이 SPI 시간을 직접 반영하므로 빈 껍데기
+#include "Arduino.h"
+
+class SPIClass {
+public:
+  void begin() {}
+  void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif
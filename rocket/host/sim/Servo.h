@@ -0,0 +1,30 @@
+#ifndef SIM_SERVO_H
+#define SIM_SERVO_H
+
+// Servo 호스트 구현 (마지막 명령 각도만 기억)
+
+#include "Arduino.h"
+
+class Servo {
+public:
+  uint8_t attach(int pin) {
+    pin_ = pin;
+    return 1;
+  }
+  void detach() { pin_ = -1; }
+  bool attached() const { return pin_ >= 0; }
+  void write(int angle) {
+    angle_ = constrain(angle, 0, 180);
+    writes_++;
+  }
+  void writeMicroseconds(int us) { angle_ = (int)((us - 544) * 180L / (2400 - 544)); }
+  int read() const { return angle_; }
+  uint32_t writeCount() const { return writes_; }
+
+private:
+  int pin_ = -1;
+  int angle_ = 90;
+  uint32_t writes_ = 0;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef SIM_TINYGPSPLUS_H
+#define SIM_TINYGPSPLUS_H
+
+// TinyGPSPlus 호스트 구현: sim GPS 모델이 Serial1로 보내는 GGA/RMC만 해석
+
+#include "Arduino.h"
+
+class TinyGPSPlus;
+
+struct TinyGPSLocation {
+  bool isValid() const { return valid_; }
+  bool isUpdated() const { return updated_; }
+  uint32_t age() const { return valid_ ? millis() - lastCommitMs_ : 0xFFFFFFFFUL; }
+  double lat() {
+    updated_ = false;
+    return lat_;
+  }
+  double lng() {
+    updated_ = false;
+    return lng_;
+  }
+
+private:
+  friend class TinyGPSPlus;
+  bool valid_ = false, updated_ = false;
+  uint32_t lastCommitMs_ = 0;
+  double lat_ = 0, lng_ = 0;
+};
+
+// 단일 값 필드 공통
+struct TinyGPSValue {
+  bool isValid() const { return valid_; }
+  bool isUpdated() const { return updated_; }
+  uint32_t age() const { return valid_ ? millis() - lastCommitMs_ : 0xFFFFFFFFUL; }
+
+protected:
+  friend class TinyGPSPlus;
+  void set(double v) {
+    v_ = v;
+    valid_ = updated_ = true;
+    lastCommitMs_ = millis();
+  }
+  double get() {
+    updated_ = false;
+    return v_;
+  }
+  bool valid_ = false, updated_ = false;
+  uint32_t lastCommitMs_ = 0;
+  double v_ = 0;
+};
+
+struct TinyGPSInteger : TinyGPSValue {
+  uint32_t value() { return (uint32_t)get(); }
+};
+struct TinyGPSAltitude : TinyGPSValue {
+  double meters() { return get(); }
+};
+struct TinyGPSSpeed : TinyGPSValue {
+  double mps() { return get() * 0.514444; }
+  double kmph() { return get() * 1.852; }
+  double knots() { return get(); }
+};
+struct TinyGPSCourse : TinyGPSValue {
+  double deg() { return get(); }
+};
+struct TinyGPSHDOP : TinyGPSValue {
+  double hdop() { return get(); }
+};
+
+class TinyGPSPlus {
+public:
+  bool encode(char c);
+
+  TinyGPSLocation location;
+  TinyGPSInteger satellites;
+  TinyGPSAltitude altitude;
+  TinyGPSSpeed speed;
+  TinyGPSCourse course;
+  TinyGPSHDOP hdop;
+
+  uint32_t charsProcessed() const { return chars_; }
+  uint32_t sentencesWithFix() const { return fixes_; }
+  uint32_t failedChecksum() const { return failed_; }
+
+private:
+  bool commitSentence();
+  char line_[100];
+  size_t len_ = 0;
+  uint32_t chars_ = 0, fixes_ = 0, failed_ = 0;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+// I2C 마스터 (sim 장치 레지스트리에 연결, 트랜잭션마다 버스 시간 소모)
+
+#include "Arduino.h"
+
+class TwoWire : public Stream {
+public:
+  void begin() {}
+  void end() {}
+  void setClock(uint32_t hz);
+  void setWireTimeout(uint32_t timeoutUs = 25000, bool resetOnTimeout = false) {
+    (void)timeoutUs;
+    (void)resetOnTimeout;
+  }
+
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t stop = true);
+  uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override { return (int)(rxLen_ - rxIdx_); }
+  int read() override { return rxIdx_ < rxLen_ ? rxBuf_[rxIdx_++] : -1; }
+  int peek() override { return rxIdx_ < rxLen_ ? rxBuf_[rxIdx_] : -1; }
+
+private:
+  static const size_t BUFFER_LENGTH = 32;  // AVR Wire 버퍼 크기
+  uint8_t txAddr_ = 0;
+  uint8_t txBuf_[BUFFER_LENGTH];
+  size_t txLen_ = 0;
+  uint8_t rxBuf_[BUFFER_LENGTH];
+  size_t rxLen_ = 0;
+  size_t rxIdx_ = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
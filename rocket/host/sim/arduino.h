@@ -0,0 +1,2 @@
+// 대소문자 구분 파일시스템용 (Adafruit_AHRS_Madgwick.cpp가 <arduino.h>로 include)
+#include "Arduino.h"
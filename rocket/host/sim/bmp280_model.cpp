@@ -0,0 +1,170 @@
+// BMP280 I2C 레지스터 모델
+//  - 칩 ID / 보정계수(데이터시트 예시값) / ctrl_meas / config / 데이터 레지스터
+//  - normal 모드에서는 (측정시간 + standby) 주기로만 데이터 레지스터 갱신
+//    -> 그 사이에 읽으면 이전 샘플이 그대로 나옴 (실제 칩과 동일)
+//  - 물리값(Pa, °C) -> raw ADC는 Bosch 정수 보상식을 이분탐색으로 역산
+//  - 칩 내부 IIR 필터는 모델링하지 않음
+
+#include "Arduino.h"
+#include "sim_internal.h"
+
+namespace {
+
+const uint8_t REG_CALIB = 0x88;
+const uint8_t REG_CHIPID = 0xD0;
+const uint8_t REG_RESET = 0xE0;
+const uint8_t REG_STATUS = 0xF3;
+const uint8_t REG_CTRL_MEAS = 0xF4;
+const uint8_t REG_CONFIG = 0xF5;
+const uint8_t REG_DATA = 0xF7;
+
+struct Calib {
+  uint16_t T1 = 27504;
+  int16_t T2 = 26435, T3 = -1000;
+  uint16_t P1 = 36477;
+  int16_t P2 = -10685, P3 = 3024, P4 = 2855, P5 = 140, P6 = -7, P7 = 15500, P8 = -14600, P9 = 6000;
+};
+
+int32_t tFine(const Calib& c, int32_t adcT) {
+  int32_t var1 = ((((adcT >> 3) - ((int32_t)c.T1 << 1))) * ((int32_t)c.T2)) >> 11;
+  int32_t var2 = (((((adcT >> 4) - ((int32_t)c.T1)) * ((adcT >> 4) - ((int32_t)c.T1))) >> 12) * ((int32_t)c.T3)) >> 14;
+  return var1 + var2;
+}
+
+// Pa * 256
+uint32_t pressQ8(const Calib& c, int32_t tfine, int32_t adcP) {
+  int64_t var1 = ((int64_t)tfine) - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)c.P6;
+  var2 = var2 + ((var1 * (int64_t)c.P5) * 131072);
+  var2 = var2 + (((int64_t)c.P4) * 34359738368LL);
+  var1 = ((var1 * var1 * (int64_t)c.P3) / 256) + ((var1 * (int64_t)c.P2) * 4096);
+  var1 = ((((int64_t)1) * 140737488355328LL) + var1) * ((int64_t)c.P1) / 8589934592LL;
+  if (var1 == 0) return 0;
+  int64_t p = 1048576 - adcP;
+  p = (((p * 2147483648LL) - var2) * 3125) / var1;
+  var1 = (((int64_t)c.P9) * (p / 8192) * (p / 8192)) / 33554432;
+  var2 = (((int64_t)c.P8) * p) / 524288;
+  p = ((p + var1 + var2) / 256) + (((int64_t)c.P7) * 16);
+  return (uint32_t)p;
+}
+
+int oversampleCount(uint8_t code) {
+  static const int n[8] = { 0, 1, 2, 4, 8, 16, 16, 16 };
+  return n[code & 7];
+}
+
+class Bmp280Model : public sim::I2cDevice {
+public:
+  Bmp280Model() {
+    sim::registerI2c(0x76, this);
+    sim::registerI2c(0x77, this);
+    reset();
+  }
+
+  bool present(uint8_t address) const override {
+    return sim::baro().present && sim::baro().address == address;
+  }
+
+  void onWrite(const uint8_t* data, size_t n) override {
+    if (n == 0) return;
+    ptr_ = data[0];
+    for (size_t i = 1; i < n; i++) {
+      uint8_t reg = (uint8_t)(ptr_ + i - 1);
+      if (reg == REG_RESET && data[i] == 0xB6) {
+        reset();
+      } else if (reg == REG_CTRL_MEAS || reg == REG_CONFIG) {
+        regs_[reg] = data[i];
+        modeStartUs_ = sim::nowUs();
+        lastIdx_ = -1;
+      }
+    }
+  }
+
+  void onRead(uint8_t* out, size_t n) override {
+    latch();
+    for (size_t i = 0; i < n; i++) out[i] = regs_[(uint8_t)(ptr_ + i)];
+  }
+
+private:
+  void reset() {
+    memset(regs_, 0, sizeof(regs_));
+    regs_[REG_CHIPID] = 0x58;
+    uint8_t* p = &regs_[REG_CALIB];
+    auto u16 = [&p](uint16_t v) {
+      *p++ = (uint8_t)(v & 0xFF);
+      *p++ = (uint8_t)(v >> 8);
+    };
+    u16(cal_.T1); u16((uint16_t)cal_.T2); u16((uint16_t)cal_.T3);
+    u16(cal_.P1); u16((uint16_t)cal_.P2); u16((uint16_t)cal_.P3); u16((uint16_t)cal_.P4);
+    u16((uint16_t)cal_.P5); u16((uint16_t)cal_.P6); u16((uint16_t)cal_.P7); u16((uint16_t)cal_.P8);
+    u16((uint16_t)cal_.P9);
+    // 전원 인가 직후 데이터 레지스터 리셋값 0x80000
+    regs_[REG_DATA + 0] = 0x80;
+    regs_[REG_DATA + 3] = 0x80;
+    lastIdx_ = -1;
+  }
+
+  double periodUs() const {
+    static const double tsbMs[8] = { 0.5, 62.5, 125, 250, 500, 1000, 2000, 4000 };
+    uint8_t ctrl = regs_[REG_CTRL_MEAS];
+    int nt = oversampleCount(ctrl >> 5);
+    int np = oversampleCount(ctrl >> 2);
+    double measMs = 1.0 + 2.0 * nt + 2.0 * np + (np ? 0.5 : 0.0);
+    return (measMs + tsbMs[regs_[REG_CONFIG] >> 5]) * 1000.0;
+  }
+
+  void latch() {
+    if ((regs_[REG_CTRL_MEAS] & 0x03) != 0x03) return;  // normal 모드만
+    int64_t idx = (int64_t)((double)(sim::nowUs() - modeStartUs_) / periodUs());
+    if (idx == lastIdx_) return;
+    lastIdx_ = idx;
+
+    const sim::BaroModel& m = sim::baro();
+
+    // T: 보상값이 adc에 대해 단조 증가
+    int32_t target = (int32_t)lround(m.temperatureC * 100.0f);
+    int32_t lo = 0, hi = (1 << 20) - 1;
+    while (lo < hi) {
+      int32_t mid = (lo + hi) / 2;
+      if (((tFine(cal_, mid) * 5 + 128) >> 8) < target) lo = mid + 1;
+      else hi = mid;
+    }
+    int32_t adcT = lo;
+    int32_t tf = tFine(cal_, adcT);
+
+    // P: 보상값이 adc에 대해 단조 감소
+    uint32_t targetP = (uint32_t)lround(m.pressurePa * 256.0);
+    lo = 0;
+    hi = (1 << 20) - 1;
+    while (lo < hi) {
+      int32_t mid = (lo + hi) / 2;
+      if (pressQ8(cal_, tf, mid) > targetP) lo = mid + 1;
+      else hi = mid;
+    }
+    int32_t adcP = lo;
+
+    regs_[REG_DATA + 0] = (uint8_t)(adcP >> 12);
+    regs_[REG_DATA + 1] = (uint8_t)(adcP >> 4);
+    regs_[REG_DATA + 2] = (uint8_t)((adcP & 0x0F) << 4);
+    regs_[REG_DATA + 3] = (uint8_t)(adcT >> 12);
+    regs_[REG_DATA + 4] = (uint8_t)(adcT >> 4);
+    regs_[REG_DATA + 5] = (uint8_t)((adcT & 0x0F) << 4);
+  }
+
+  Calib cal_;
+  uint8_t regs_[256];
+  uint8_t ptr_ = 0;
+  uint64_t modeStartUs_ = 0;
+  int64_t lastIdx_ = -1;
+};
+
+Bmp280Model g_bmp280;
+
+}  // namespace
+
+namespace sim {
+BaroModel& baro() {
+  static BaroModel m;
+  return m;
+}
+}  // namespace sim
@@ -0,0 +1,320 @@
+// 호스트 Arduino 코어: 가상 시계, 핀, Print/Stream/String, UART 모델
+
+#include "Arduino.h"
+#include "sim_internal.h"
+
+#include <random>
+#include <vector>
+
+namespace sim {
+
+static uint64_t g_nowUs = 0;
+
+static std::vector<std::function<void(uint64_t)>>& tickers() {
+  static std::vector<std::function<void(uint64_t)>> v;
+  return v;
+}
+static std::vector<HardwareSerial*>& uarts() {
+  static std::vector<HardwareSerial*> v;
+  return v;
+}
+
+void registerTicker(std::function<void(uint64_t)> fn) { tickers().push_back(fn); }
+void registerUart(HardwareSerial* port) { uarts().push_back(port); }
+
+uint64_t nowUs() { return g_nowUs; }
+
+void advanceToUs(uint64_t us) {
+  if (us <= g_nowUs) return;
+  g_nowUs = us;
+  for (auto* p : uarts()) p->pump(g_nowUs);
+  for (auto& t : tickers()) t(g_nowUs);
+}
+
+void advanceUs(uint64_t us) { advanceToUs(g_nowUs + us); }
+
+Config& config() {
+  static Config c;
+  return c;
+}
+
+// ====== 핀 ======
+static const int NUM_PINS = 100;
+static uint8_t g_mode[NUM_PINS];
+static uint8_t g_out[NUM_PINS];
+static int8_t g_forced[NUM_PINS];  // -1: 외부 구동 없음
+static bool g_pinsInit = false;
+
+static void initPins() {
+  if (g_pinsInit) return;
+  for (int i = 0; i < NUM_PINS; i++) g_forced[i] = -1;
+  g_pinsInit = true;
+}
+
+void setPin(uint8_t pin, bool high) {
+  initPins();
+  if (pin < NUM_PINS) g_forced[pin] = high ? 1 : 0;
+}
+
+bool pinLevel(uint8_t pin) {
+  initPins();
+  if (pin >= NUM_PINS) return false;
+  if (g_forced[pin] >= 0) return g_forced[pin] == 1;
+  if (g_mode[pin] == OUTPUT) return g_out[pin] != 0;
+  return g_mode[pin] == INPUT_PULLUP;
+}
+
+}  // namespace sim
+
+// ====== 시간 ======
+unsigned long millis() { return (uint32_t)(sim::nowUs() / 1000ULL); }
+unsigned long micros() { return (uint32_t)sim::nowUs(); }
+void delay(unsigned long ms) { sim::advanceUs((uint64_t)ms * 1000ULL); }
+void delayMicroseconds(unsigned int us) { sim::advanceUs(us); }
+
+// ====== 핀 ======
+void pinMode(uint8_t pin, uint8_t mode) {
+  sim::initPins();
+  if (pin < sim::NUM_PINS) sim::g_mode[pin] = mode;
+}
+void digitalWrite(uint8_t pin, uint8_t val) {
+  sim::initPins();
+  if (pin < sim::NUM_PINS) sim::g_out[pin] = val ? 1 : 0;
+}
+int digitalRead(uint8_t pin) { return sim::pinLevel(pin) ? HIGH : LOW; }
+int analogRead(uint8_t) { return 0; }
+
+// ====== 난수 (재현성을 위해 고정 시드) ======
+static std::mt19937& rng() {
+  static std::mt19937 r(1);
+  return r;
+}
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return (long)(rng()() % (unsigned long)howbig);
+}
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+void randomSeed(unsigned long seed) {
+  if (seed) rng().seed((uint32_t)seed);
+}
+
+// ====== Print ======
+size_t Print::printNumber(unsigned long long v, int base) {
+  char buf[8 * sizeof(v) + 1];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    int d = (int)(v % base);
+    *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+    v /= base;
+  } while (v);
+  return write(p);
+}
+
+size_t Print::printSigned(long long v, int base) {
+  if (base == DEC && v < 0) {
+    size_t n = print('-');
+    return n + printNumber((unsigned long long)(-v), DEC);
+  }
+  // AVR과 동일하게 HEX 등은 2의 보수 그대로 (32bit)
+  return printNumber(base == DEC ? (unsigned long long)v : (unsigned long long)(uint32_t)v, base);
+}
+
+size_t Print::print(double v, int digits) {
+  if (isnan(v)) return write("nan");
+  if (isinf(v)) return write("inf");
+  if (v > 4294967040.0 || v < -4294967040.0) return write("ovf");
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits < 0 ? 0 : digits, v);
+  return write(buf);
+}
+
+// ====== Stream ======
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    sim::advanceUs(50);  // 폴링 간격
+  } while (millis() - start < timeoutMs_);
+  return -1;
+}
+
+String Stream::readStringUntil(char terminator) {
+  std::string s;
+  int c = timedRead();
+  while (c >= 0 && c != terminator) {
+    s += (char)c;
+    c = timedRead();
+  }
+  return String(s);
+}
+
+String Stream::readString() {
+  std::string s;
+  int c = timedRead();
+  while (c >= 0) {
+    s += (char)c;
+    c = timedRead();
+  }
+  return String(s);
+}
+
+size_t Stream::readBytes(char* buf, size_t n) {
+  size_t k = 0;
+  while (k < n) {
+    int c = timedRead();
+    if (c < 0) break;
+    buf[k++] = (char)c;
+  }
+  return k;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buf, size_t n) {
+  size_t k = 0;
+  while (k < n) {
+    int c = timedRead();
+    if (c < 0 || c == terminator) break;
+    buf[k++] = (char)c;
+  }
+  return k;
+}
+
+// ====== String ======
+String::String(double v, unsigned char digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  s_ = buf;
+}
+
+void String::trim() {
+  size_t b = 0, e = s_.size();
+  while (b < e && isspace((unsigned char)s_[b])) b++;
+  while (e > b && isspace((unsigned char)s_[e - 1])) e--;
+  s_ = s_.substr(b, e - b);
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int t = from;
+    from = to;
+    to = t;
+  }
+  if (from >= s_.size()) return String();
+  if (to > s_.size()) to = (unsigned int)s_.size();
+  return String(s_.substr(from, to - from));
+}
+
+// ====== UART ======
+HardwareSerial Serial("Serial");
+HardwareSerial Serial1("Serial1");
+HardwareSerial Serial2("Serial2");
+HardwareSerial Serial3("Serial3");
+
+void HardwareSerial::begin(unsigned long baud) {
+  if (!registered_) {
+    sim::registerUart(this);
+    registered_ = true;
+  }
+  baud_ = baud;
+}
+
+void HardwareSerial::pump(uint64_t nowUs) {
+  while (!txBytes_.empty() && txNextDoneUs_ <= (double)nowUs) {
+    uint8_t b = txBytes_.front();
+    txBytes_.pop_front();
+    stats.txBytes++;
+    if (this == &Serial && sim::config().echoSerial) fputc(b, stdout);
+    if (onTx) onTx(b);
+    if (!txBytes_.empty()) txNextDoneUs_ += byteUs();
+  }
+  while (!rxPending_.empty() && rxPending_.front().atUs <= nowUs) {
+    if (baud_ == 0) {
+      // begin() 전 도착 바이트는 수신되지 않음
+    } else if (rx_.size() < RX_BUFFER_SIZE - 1) {
+      rx_.push_back(rxPending_.front().b);
+      stats.rxBytes++;
+    } else {
+      stats.rxOverflow++;
+    }
+    rxPending_.pop_front();
+  }
+}
+
+int HardwareSerial::available() {
+  pump(sim::nowUs());
+  return (int)rx_.size();
+}
+
+int HardwareSerial::read() {
+  pump(sim::nowUs());
+  if (rx_.empty()) return -1;
+  uint8_t b = rx_.front();
+  rx_.pop_front();
+  return b;
+}
+
+int HardwareSerial::peek() {
+  pump(sim::nowUs());
+  return rx_.empty() ? -1 : rx_.front();
+}
+
+int HardwareSerial::availableForWrite() {
+  pump(sim::nowUs());
+  size_t buffered = txBytes_.empty() ? 0 : txBytes_.size() - 1;  // 맨 앞은 시프트 레지스터
+  return (int)(TX_BUFFER_SIZE - 1 - buffered);
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  if (baud_ == 0) return 0;
+  uint64_t now = sim::nowUs();
+  pump(now);
+  if (txBytes_.empty()) {
+    txNextDoneUs_ = (double)now + byteUs();
+  } else if (txBytes_.size() - 1 >= TX_BUFFER_SIZE - 1) {
+    // 버퍼 가득: 한 바이트가 빠질 때까지 블로킹
+    uint64_t t0 = now;
+    sim::advanceToUs((uint64_t)ceil(txNextDoneUs_));
+    stats.txBlockedCalls++;
+    stats.txBlockedUs += sim::nowUs() - t0;
+    if (txBytes_.empty()) txNextDoneUs_ = (double)sim::nowUs() + byteUs();
+  }
+  txBytes_.push_back(b);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n) {
+  for (size_t i = 0; i < n; i++) write(buf[i]);
+  return n;
+}
+
+void HardwareSerial::flush() {
+  if (!txBytes_.empty()) {
+    double doneUs = txNextDoneUs_ + (double)(txBytes_.size() - 1) * byteUs();
+    sim::advanceToUs((uint64_t)ceil(doneUs));
+  }
+}
+
+void HardwareSerial::inject(const uint8_t* data, size_t n) {
+  double step = baud_ ? byteUs() : 1042.0;
+  double t = (double)sim::nowUs();
+  if (!rxPending_.empty() && (double)rxPending_.back().atUs > t) t = (double)rxPending_.back().atUs;
+  for (size_t i = 0; i < n; i++) {
+    t += step;
+    rxPending_.push_back({ (uint64_t)t, data[i] });
+  }
+}
+
+void HardwareSerial::injectAt(uint64_t atUs, const uint8_t* data, size_t n) {
+  double step = baud_ ? byteUs() : 1042.0;
+  double t = (double)atUs;
+  if (!rxPending_.empty() && (double)rxPending_.back().atUs > t) t = (double)rxPending_.back().atUs;
+  for (size_t i = 0; i < n; i++) {
+    t += step;
+    rxPending_.push_back({ (uint64_t)t, data[i] });
+  }
+}
@@ -0,0 +1,38 @@
+// EEPROM = 호스트 파일 (없으면 0xFF로 초기화된 새 칩)
+
+#include "EEPROM.h"
+#include "sim_internal.h"
+
+EEPROMClass EEPROM;
+
+void EEPROMClass::load() {
+  if (loaded_) return;
+  memset(mem_, 0xFF, sizeof(mem_));
+  FILE* f = fopen(sim::config().eepromPath.c_str(), "rb");
+  if (f) {
+    size_t n = fread(mem_, 1, sizeof(mem_), f);
+    (void)n;
+    fclose(f);
+  }
+  loaded_ = true;
+}
+
+void EEPROMClass::save() {
+  FILE* f = fopen(sim::config().eepromPath.c_str(), "wb");
+  if (!f) return;
+  fwrite(mem_, 1, sizeof(mem_), f);
+  fclose(f);
+}
+
+uint8_t EEPROMClass::read(int idx) {
+  load();
+  return (idx >= 0 && idx < SIZE) ? mem_[idx] : 0xFF;
+}
+
+void EEPROMClass::write(int idx, uint8_t v) {
+  load();
+  if (idx < 0 || idx >= SIZE) return;
+  mem_[idx] = v;
+  save();
+  sim::advanceUs(3300);  // EEPROM 셀 쓰기 3.3ms
+}
@@ -0,0 +1,138 @@
+// GPS 모델(NMEA 송신) + TinyGPSPlus 최소 파서
+
+#include "TinyGPSPlus.h"
+#include "sim_internal.h"
+
+#include <vector>
+
+namespace {
+
+uint8_t nmeaChecksum(const char* body) {
+  uint8_t cs = 0;
+  for (const char* p = body; *p; p++) cs ^= (uint8_t)*p;
+  return cs;
+}
+
+void formatCoord(char* out, size_t n, double deg, bool isLat) {
+  double a = fabs(deg);
+  int d = (int)a;
+  double m = (a - d) * 60.0;
+  snprintf(out, n, isLat ? "%02d%09.6f,%c" : "%03d%09.6f,%c", d, m,
+           isLat ? (deg >= 0 ? 'N' : 'S') : (deg >= 0 ? 'E' : 'W'));
+}
+
+void sendSentence(const char* body) {
+  char buf[128];
+  int n = snprintf(buf, sizeof(buf), "$%s*%02X\r\n", body, nmeaChecksum(body));
+  Serial1.inject((const uint8_t*)buf, (size_t)n);
+}
+
+// 주기마다 GGA + RMC를 Serial1 수신으로 주입 (9600bps 기준 실제 트래픽 양과 비슷)
+struct GpsEmitter {
+  GpsEmitter() {
+    sim::registerTicker([this](uint64_t nowUs) { tick(nowUs); });
+  }
+  void tick(uint64_t nowUs) {
+    const sim::GpsModel& m = sim::gps();
+    if (!m.enabled || m.periodMs == 0) return;
+    uint64_t periodUs = (uint64_t)m.periodMs * 1000ULL;
+    if (nowUs < nextUs) return;
+    nextUs = (nowUs / periodUs + 1) * periodUs;
+
+    uint32_t t = (uint32_t)(nowUs / 10000ULL);  // 1/100 s
+    char hms[16];
+    snprintf(hms, sizeof(hms), "%02u%02u%02u.%02u", (t / 360000) % 24, (t / 6000) % 60, (t / 100) % 60, t % 100);
+    char lat[24], lng[24], body[110];
+    formatCoord(lat, sizeof(lat), m.latDeg, true);
+    formatCoord(lng, sizeof(lng), m.lngDeg, false);
+
+    snprintf(body, sizeof(body), "GPGGA,%s,%s,%s,%d,%02u,%.1f,%.1f,M,0.0,M,,", hms, lat, lng, m.fix ? 1 : 0,
+             (unsigned)m.sats, m.hdop, m.altM);
+    sendSentence(body);
+    snprintf(body, sizeof(body), "GPRMC,%s,%c,%s,%s,%.2f,%.1f,010126,,,A", hms, m.fix ? 'A' : 'V', lat, lng,
+             m.speedMps / 0.514444, m.courseDeg);
+    sendSentence(body);
+  }
+  uint64_t nextUs = 0;
+};
+
+GpsEmitter g_emitter;
+
+double parseCoord(const char* v, const char* hemi) {
+  if (!*v) return 0.0;
+  double raw = atof(v);
+  int d = (int)(raw / 100.0);
+  double deg = d + (raw - d * 100.0) / 60.0;
+  if (*hemi == 'S' || *hemi == 'W') deg = -deg;
+  return deg;
+}
+
+}  // namespace
+
+namespace sim {
+GpsModel& gps() {
+  static GpsModel m;
+  return m;
+}
+}  // namespace sim
+
+bool TinyGPSPlus::encode(char c) {
+  chars_++;
+  if (c == '$') {
+    len_ = 0;
+    line_[len_++] = c;
+    return false;
+  }
+  if (len_ == 0) return false;
+  if (c == '\r' || c == '\n') {
+    line_[len_] = '\0';
+    bool ok = commitSentence();
+    len_ = 0;
+    return ok;
+  }
+  if (len_ < sizeof(line_) - 1) line_[len_++] = c;
+  else len_ = 0;
+  return false;
+}
+
+bool TinyGPSPlus::commitSentence() {
+  char* star = strchr(line_, '*');
+  if (!star) return false;
+  *star = '\0';
+  if ((uint8_t)strtol(star + 1, nullptr, 16) != nmeaChecksum(line_ + 1)) {
+    failed_++;
+    return false;
+  }
+
+  std::vector<const char*> f;
+  char* p = line_ + 1;
+  f.push_back(p);
+  for (; *p; p++) {
+    if (*p == ',') {
+      *p = '\0';
+      f.push_back(p + 1);
+    }
+  }
+
+  if (strcmp(f[0], "GPGGA") == 0 && f.size() >= 10) {
+    if (atoi(f[6]) > 0) {
+      location.lat_ = parseCoord(f[2], f[3]);
+      location.lng_ = parseCoord(f[4], f[5]);
+      location.valid_ = location.updated_ = true;
+      location.lastCommitMs_ = millis();
+      altitude.set(atof(f[9]));
+      fixes_++;
+    }
+    satellites.set(atoi(f[7]));
+    hdop.set(atof(f[8]));
+    return true;
+  }
+  if (strcmp(f[0], "GPRMC") == 0 && f.size() >= 9) {
+    if (*f[2] == 'A') {
+      speed.set(atof(f[7]));
+      course.set(atof(f[8]));
+    }
+    return true;
+  }
+  return false;
+}
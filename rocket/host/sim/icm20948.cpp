@@ -0,0 +1,177 @@
+// ICM-20948 모델 + SparkFun 드라이버 호스트 구현
+
+#include "ICM_20948.h"
+
+#include <math.h>
+#include <string.h>
+#include "sim_internal.h"
+
+namespace sim {
+ImuModel& imu() {
+  static ImuModel m;
+  return m;
+}
+}  // namespace sim
+
+// 레지스터 뱅크 선택(쓰기) + 레지스터 주소(쓰기) + 읽기 = 원본 드라이버의 읽기 1회
+ICM_20948_Status_e ICM_20948_I2C::busOp(size_t transactions, size_t readBytes) {
+  bool ok = sim::imu().present;
+  for (size_t i = 0; i + 1 < transactions; i++) sim::i2cTransaction(1, ok);
+  sim::i2cTransaction(readBytes ? readBytes : 1, ok);
+  status = ok ? ICM_20948_Stat_Ok : ICM_20948_Stat_Err;
+  return status;
+}
+
+// 샘플 주기 = odrHz / (1 + GYRO_SMPLRT_DIV)
+int64_t ICM_20948_I2C::sampleIndex() const {
+  return (int64_t)((double)sim::nowUs() * sim::imu().odrHz / (1 + gyroDiv_) / 1e6);
+}
+
+ICM_20948_Status_e ICM_20948_I2C::begin(TwoWire&, bool ad0val, uint8_t) {
+  addr_ = ad0val ? 0x69 : 0x68;
+  busOp(3, 1);  // WHO_AM_I
+  if (status == ICM_20948_Stat_Ok) {
+    busOp(2, 0);  // sw reset
+    delay(50);
+    busOp(2, 0);  // sleep off
+    lastIdx_ = sampleIndex();
+  }
+  return status;
+}
+
+const char* ICM_20948_I2C::statusString(ICM_20948_Status_e stat) {
+  switch (stat) {
+    case ICM_20948_Stat_Ok: return "All is well.";
+    case ICM_20948_Stat_Err: return "General Error";
+    case ICM_20948_Stat_NoData: return "No Data";
+    case ICM_20948_Stat_FIFONoDataAvail: return "No FIFO Data Available";
+    case ICM_20948_Stat_FIFOMoreDataAvail: return "More FIFO Data Available";
+    default: return "Unknown Status";
+  }
+}
+
+ICM_20948_Status_e ICM_20948_I2C::startupMagnetometer(bool) {
+  busOp(8, 1);
+  delay(10);
+  return status;
+}
+ICM_20948_Status_e ICM_20948_I2C::setFullScale(uint8_t, ICM_20948_fss_t fss) {
+  fss_[0] = fss.a;
+  fss_[1] = fss.g;
+  return busOp(4, 0);
+}
+ICM_20948_Status_e ICM_20948_I2C::enableDLPF(uint8_t, bool) { return busOp(4, 0); }
+ICM_20948_Status_e ICM_20948_I2C::setDLPFcfg(uint8_t, ICM_20948_dlpcfg_t) { return busOp(4, 0); }
+ICM_20948_Status_e ICM_20948_I2C::setSampleMode(uint8_t, uint8_t) { return busOp(3, 0); }
+ICM_20948_Status_e ICM_20948_I2C::setSampleRate(uint8_t sensors, ICM_20948_smplrt_t smplrt) {
+  if (sensors & ICM_20948_Internal_Gyr) gyroDiv_ = smplrt.g;
+  return busOp(4, 0);
+}
+
+ICM_20948_Status_e ICM_20948_I2C::setBank(uint8_t) { return busOp(1, 0); }
+ICM_20948_Status_e ICM_20948_I2C::write(uint8_t reg, uint8_t* pdata, uint32_t len) {
+  if (reg == AGB0_REG_FIFO_EN_2 && len > 0) fifoEn2_ = pdata[0];
+  return busOp(1, 0);
+}
+ICM_20948_Status_e ICM_20948_I2C::read(uint8_t, uint8_t* pdata, uint32_t len) {
+  memset(pdata, 0, len);
+  return busOp(2, len);
+}
+
+// DMP 펌웨어 로딩(약 14KB)은 실제로 수백 ms 걸림
+ICM_20948_Status_e ICM_20948_I2C::initializeDMP() {
+  busOp(2, 0);
+  delay(400);
+  return status;
+}
+ICM_20948_Status_e ICM_20948_I2C::enableDMPSensor(enum inv_icm20948_sensor, bool) { return busOp(6, 0); }
+ICM_20948_Status_e ICM_20948_I2C::setDMPODRrate(enum DMP_ODR_Registers, int) { return busOp(4, 0); }
+ICM_20948_Status_e ICM_20948_I2C::enableFIFO(bool enable) {
+  fifoOn_ = enable;
+  fifoIdx_ = sampleIndex();
+  fifoByte_ = 0;
+  return busOp(2, 0);
+}
+ICM_20948_Status_e ICM_20948_I2C::enableDMP(bool) { return busOp(2, 0); }
+ICM_20948_Status_e ICM_20948_I2C::resetDMP() { return busOp(2, 0); }
+ICM_20948_Status_e ICM_20948_I2C::resetFIFO() {
+  fifoIdx_ = sampleIndex();
+  fifoByte_ = 0;
+  return busOp(3, 0);
+}
+ICM_20948_Status_e ICM_20948_I2C::setFIFOmode(bool) { return busOp(3, 0); }
+
+// FIFO 샘플 = 가속도 XYZ + 자이로 XYZ (FIFO_EN_2 0x1E일 때만), 512B를 넘으면 오래된 것부터 덮어씀
+static const int SIM_FIFO_BYTES = 512;
+static const int SIM_FIFO_SAMPLE = 12;
+
+int64_t ICM_20948_I2C::fifoPending() {
+  if (!fifoOn_ || (fifoEn2_ & 0x1E) != 0x1E) return 0;
+  int64_t n = sampleIndex() - fifoIdx_;
+  if (n * SIM_FIFO_SAMPLE > SIM_FIFO_BYTES) {
+    fifoIdx_ += n - SIM_FIFO_BYTES / SIM_FIFO_SAMPLE;
+    n = SIM_FIFO_BYTES / SIM_FIFO_SAMPLE;
+  }
+  return n;
+}
+
+static void putBe16(uint8_t* p, float v) {
+  int32_t r = (int32_t)lroundf(v);
+  if (r > 32767) r = 32767;
+  if (r < -32768) r = -32768;
+  p[0] = (uint8_t)((uint16_t)r >> 8);
+  p[1] = (uint8_t)r;
+}
+
+void ICM_20948_I2C::fifoSampleBytes(uint8_t* out) const {
+  static const float ACC_LSB_PER_MG[] = { 16.384f, 8.192f, 4.096f, 2.048f };
+  static const float GYR_LSB_PER_DPS[] = { 131.0f, 65.5f, 32.8f, 16.4f };
+  const sim::ImuModel& m = sim::imu();
+  for (int i = 0; i < 3; i++) {
+    putBe16(&out[i * 2], m.accMg[i] * ACC_LSB_PER_MG[fss_[0] & 3]);
+    putBe16(&out[6 + i * 2], m.gyrDps[i] * GYR_LSB_PER_DPS[fss_[1] & 3]);
+  }
+}
+
+ICM_20948_Status_e ICM_20948_I2C::getFIFOcount(uint16_t* count) {
+  if (busOp(3, 2) != ICM_20948_Stat_Ok) return status;
+  int64_t n = fifoPending();
+  *count = n ? (uint16_t)(n * SIM_FIFO_SAMPLE - fifoByte_) : 0;
+  return status;
+}
+
+ICM_20948_Status_e ICM_20948_I2C::readFIFO(uint8_t* data, uint8_t len) {
+  if (busOp(3, len) != ICM_20948_Stat_Ok) return status;
+  uint8_t smp[SIM_FIFO_SAMPLE];
+  fifoSampleBytes(smp);
+  int64_t avail = fifoPending() * SIM_FIFO_SAMPLE - fifoByte_;
+  for (uint8_t i = 0; i < len; i++) {
+    if (avail-- <= 0) {
+      data[i] = 0;  // 비어 있으면 실제 칩처럼 쓰레기 (여기선 0)
+      continue;
+    }
+    data[i] = smp[fifoByte_++];
+    if (fifoByte_ == SIM_FIFO_SAMPLE) {
+      fifoByte_ = 0;
+      fifoIdx_++;
+    }
+  }
+  return status;
+}
+
+bool ICM_20948_I2C::dataReady() {
+  if (busOp(3, 1) != ICM_20948_Stat_Ok) return false;
+  return sampleIndex() > lastIdx_;
+}
+
+ICM_20948_Status_e ICM_20948_I2C::getAGMT() {
+  if (busOp(3, 23) != ICM_20948_Stat_Ok) return status;
+  lastIdx_ = sampleIndex();
+  const sim::ImuModel& m = sim::imu();
+  for (int i = 0; i < 3; i++) {
+    acc_[i] = m.accMg[i];
+    gyr_[i] = m.gyrDps[i];
+    mag_[i] = m.magUt[i];
+  }
+  return status;
+}
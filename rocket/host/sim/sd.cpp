@@ -0,0 +1,221 @@
+// SD 카드 = 호스트 디렉터리
+
+#include "SD.h"
+#include "sim_internal.h"
+
+#include <sys/stat.h>
+#include <vector>
+#include <unistd.h>
+
+SPIClass SPI;
+SDClass SD;
+
+namespace sim {
+SdModel& sd() {
+  static SdModel m;
+  return m;
+}
+}  // namespace sim
+
+static std::string hostPath(const char* path) {
+  std::string p = sim::config().sdDir;
+  if (path[0] != '/') p += '/';
+  return p + path;
+}
+
+File::File(const char* path, uint8_t mode) : name_(path) {
+  std::string hp = hostPath(path);
+  FILE* f = nullptr;
+  if (mode == FILE_READ) {
+    f = fopen(hp.c_str(), "rb");
+  } else {
+    f = fopen(hp.c_str(), "r+b");
+    if (!f) f = fopen(hp.c_str(), "w+b");
+    if (f) fseek(f, 0, SEEK_END);
+  }
+  if (f) {
+    fp_ = std::shared_ptr<FILE>(f, fclose);
+    sectorBytes_ = (uint32_t)(ftell(f) % 512);
+  }
+  sim::advanceUs(sim::sd().openUs);
+}
+
+size_t File::write(const uint8_t* buf, size_t n) {
+  if (!fp_) return 0;
+  size_t k = fwrite(buf, 1, n, fp_.get());
+  // SPI 전송 + 512B 섹터가 찰 때마다 카드 쓰기
+  uint32_t sectors = (uint32_t)((sectorBytes_ + k) / 512);
+  sectorBytes_ = (uint32_t)((sectorBytes_ + k) % 512);
+  sim::advanceUs((uint64_t)(sim::sd().usPerByte * (float)k) + (uint64_t)sectors * sim::sd().sectorWriteUs);
+  return k;
+}
+
+int File::available() {
+  if (!fp_) return 0;
+  long pos = ftell(fp_.get());
+  fseek(fp_.get(), 0, SEEK_END);
+  long end = ftell(fp_.get());
+  fseek(fp_.get(), pos, SEEK_SET);
+  return (int)(end - pos);
+}
+
+int File::read() {
+  if (!fp_) return -1;
+  int c = fgetc(fp_.get());
+  return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+  if (!fp_) return -1;
+  int c = fgetc(fp_.get());
+  if (c != EOF) ungetc(c, fp_.get());
+  return c == EOF ? -1 : c;
+}
+
+int File::read(void* buf, uint16_t n) {
+  if (!fp_) return -1;
+  return (int)fread(buf, 1, n, fp_.get());
+}
+
+void File::flush() {
+  if (!fp_) return;
+  fflush(fp_.get());
+  sim::advanceUs(sim::sd().flushUs);
+}
+
+bool File::seek(uint32_t pos) {
+  if (!fp_) return false;
+  if (fseek(fp_.get(), (long)pos, SEEK_SET) != 0) return false;
+  sectorBytes_ = pos % 512;
+  return true;
+}
+
+uint32_t File::position() { return fp_ ? (uint32_t)ftell(fp_.get()) : 0; }
+
+uint32_t File::size() {
+  if (!fp_) return 0;
+  long pos = ftell(fp_.get());
+  fseek(fp_.get(), 0, SEEK_END);
+  long end = ftell(fp_.get());
+  fseek(fp_.get(), pos, SEEK_SET);
+  return (uint32_t)end;
+}
+
+void File::close() {
+  if (!fp_) return;
+  flush();
+  fp_.reset();
+}
+
+bool SDClass::begin(uint8_t) {
+  ::mkdir(sim::config().sdDir.c_str(), 0755);
+  struct stat st;
+  return stat(sim::config().sdDir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+File SDClass::open(const char* path, uint8_t mode) { return File(path, mode); }
+
+bool SDClass::exists(const char* path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool SDClass::remove(const char* path) { return ::unlink(hostPath(path).c_str()) == 0; }
+
+bool SDClass::mkdir(const char* path) { return ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+
+// ====== 저수준 블록 접근 (Sd2Card / SdFile::createContiguous) ======
+namespace {
+
+struct RawRegion {
+  uint32_t bgn, end;
+  std::string path;
+};
+
+std::vector<RawRegion>& rawRegions() {
+  static std::vector<RawRegion> v;
+  return v;
+}
+
+uint32_t g_nextFreeBlock = 8192;  // 가상 블록 번호 (FAT/루트 디렉터리 영역 이후)
+uint64_t g_busyUntilUs = 0;
+
+RawRegion* findRegion(uint32_t block) {
+  for (RawRegion& r : rawRegions()) {
+    if (block >= r.bgn && block <= r.end) return &r;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+uint8_t Sd2Card::init(uint8_t, uint8_t) {
+  sim::advanceUs(sim::sd().openUs);
+  return 1;
+}
+
+uint8_t Sd2Card::isBusy() {
+  sim::advanceUs(20);  // CS + 1바이트 SPI
+  return sim::nowUs() < g_busyUntilUs;
+}
+
+uint8_t Sd2Card::writeBlock(uint32_t blockNumber, const uint8_t* src, uint8_t blocking) {
+  // 이전 프로그래밍이 안 끝났으면 카드가 명령을 받을 때까지 대기
+  if (sim::nowUs() < g_busyUntilUs) sim::advanceToUs(g_busyUntilUs);
+
+  RawRegion* r = findRegion(blockNumber);
+  if (!r) {
+    error_ = 0x0E;  // SD_CARD_ERROR_CMD24 (호스트에서는 배정 안 된 블록)
+    return 0;
+  }
+  FILE* f = fopen(r->path.c_str(), "r+b");
+  if (!f) {
+    error_ = 0x0E;
+    return 0;
+  }
+  fseek(f, (long)(blockNumber - r->bgn) * 512L, SEEK_SET);
+  fwrite(src, 1, 512, f);
+  fclose(f);
+
+  sim::SdModel& m = sim::sd();
+  sim::advanceUs((uint64_t)(m.usPerByte * 512.0f));  // 토큰 + 512B + CRC 전송
+  m.blocksWritten++;
+  uint32_t busy = m.sectorWriteUs;
+  if (m.busySpikeEvery && (m.blocksWritten % m.busySpikeEvery) == 0) busy = m.busySpikeUs;
+  m.busyUs += busy;
+  g_busyUntilUs = sim::nowUs() + busy;
+  if (blocking) sim::advanceToUs(g_busyUntilUs);
+  return 1;
+}
+
+uint8_t Sd2Card::erase(uint32_t firstBlock, uint32_t lastBlock) {
+  RawRegion* r = findRegion(firstBlock);
+  if (!r || lastBlock > r->end) return 0;
+  // createContiguous가 만든 희소 파일은 이미 0 (DATA_STAT_AFTER_ERASE = 0 인 카드) -> 시간만 반영
+  sim::advanceUs(sim::sd().eraseUs);
+  return 1;
+}
+
+uint8_t SdFile::createContiguous(SdFile*, const char* fileName, uint32_t size) {
+  if (size == 0 || SD.exists(fileName)) return 0;
+  std::string hp = hostPath(fileName);
+  FILE* f = fopen(hp.c_str(), "wb");
+  if (!f) return 0;
+  fclose(f);
+  if (truncate(hp.c_str(), (off_t)size) != 0) return 0;  // 희소 파일 (0으로 읽힘)
+
+  uint32_t blocks = (size + 511) / 512;
+  bgn_ = g_nextFreeBlock;
+  end_ = bgn_ + blocks - 1;
+  g_nextFreeBlock = end_ + 1;
+  rawRegions().push_back({ bgn_, end_, hp });
+  sim::advanceUs(sim::sd().createUs);
+  return 1;
+}
+
+uint8_t SdFile::contiguousRange(uint32_t* bgnBlock, uint32_t* endBlock) {
+  if (end_ == 0) return 0;
+  *bgnBlock = bgn_;
+  *endBlock = end_;
+  return 1;
+}
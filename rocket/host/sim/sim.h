@@ -0,0 +1,103 @@
+#ifndef SIM_H
+#define SIM_H
+
+// ============================================================================
+// 호스트 시뮬레이터 제어 API
+//  - 스케치는 Arduino API(Arduino.h, Wire.h, SD.h ...)만 보고
+//    시나리오/도구 코드는 이 헤더로 가상 시계와 장치 모델을 조작
+// ============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+namespace sim {
+
+// ====== 가상 시계 ======
+// millis()/micros()/delay()는 전부 이 시계 기준. 실제 시간과 무관하게 진행
+uint64_t nowUs();
+void advanceUs(uint64_t us);   // 시간 진행 (UART 송신 드레인 등 장치 갱신 포함)
+void advanceToUs(uint64_t us);  // 절대 시각까지 진행 (과거면 무시)
+
+// ====== 설정 ======
+// 기본 위치는 빌드 디렉터리 (CMake가 SIM_STATE_DIR 정의). 실행한 곳(소스 트리)에 파일을 만들지 않음
+#ifndef SIM_STATE_DIR
+#define SIM_STATE_DIR "."
+#endif
+struct Config {
+  std::string sdDir = SIM_STATE_DIR "/sim_sd";            // SD 카드 = 이 디렉터리
+  std::string eepromPath = SIM_STATE_DIR "/sim_eeprom.bin";  // EEPROM = 이 파일 (4KB)
+  bool echoSerial = true;                  // Serial(USB) 출력을 stdout으로
+};
+Config& config();
+
+// ====== 디지털 핀 ======
+void setPin(uint8_t pin, bool high);  // 외부에서 핀 레벨 강제 (커넥트핀 등)
+bool pinLevel(uint8_t pin);           // 스케치가 digitalWrite한 값 포함 현재 레벨
+
+// ====== BMP280 (I2C 레지스터 모델) ======
+struct BaroModel {
+  bool present = true;
+  uint8_t address = 0x76;
+  float pressurePa = 101325.0f;
+  float temperatureC = 20.0f;
+};
+BaroModel& baro();
+
+// ====== ICM-20948 ======
+struct ImuModel {
+  bool present = true;
+  float odrHz = 1125.0f;              // 새 샘플 발생 주기
+  float accMg[3] = { 0.0f, 0.0f, 1000.0f };
+  float gyrDps[3] = { 0.0f, 0.0f, 0.0f };
+  float magUt[3] = { 30.0f, 0.0f, -40.0f };
+};
+ImuModel& imu();
+
+// ====== GPS (Serial1로 NMEA 트래픽 주입, TinyGPSPlus는 모델 값을 그대로 반영) ======
+struct GpsModel {
+  bool enabled = true;
+  bool fix = true;
+  double latDeg = 37.6320;
+  double lngDeg = 127.0776;
+  float altM = 40.0f;
+  float speedMps = 0.0f;
+  float courseDeg = 0.0f;
+  uint8_t sats = 9;
+  float hdop = 0.9f;
+  uint32_t periodMs = 200;            // 5Hz 출력
+};
+GpsModel& gps();
+
+// ====== I2C 버스 통계 ======
+struct I2cStats {
+  uint32_t transactions = 0;
+  uint32_t bytes = 0;
+  uint32_t nacks = 0;
+  uint64_t busyUs = 0;
+};
+I2cStats& i2cStats();
+
+// ====== SD 지연 모델 ======
+struct SdModel {
+  float usPerByte = 2.0f;      // SPI 전송
+  uint32_t sectorWriteUs = 800;  // 512B 섹터 경계마다 카드 쓰기
+  uint32_t flushUs = 4000;       // FAT/디렉터리 갱신
+  uint32_t openUs = 2000;
+  // 저수준 블록 쓰기 (Sd2Card)
+  uint32_t busySpikeEvery = 256;  // 이 블록 수마다 카드 내부 정리로 busy가 길어짐
+  uint32_t busySpikeUs = 40000;
+  uint32_t createUs = 30000;      // createContiguous (FAT 체인 기록)
+  uint32_t eraseUs = 100000;      // erase 한 번
+  // 통계
+  uint32_t blocksWritten = 0;
+  uint64_t busyUs = 0;            // 카드 프로그래밍 시간 합
+};
+SdModel& sd();
+
+// ====== PCA9685 채널 출력 (off tick) ======
+uint16_t pwmTicks(uint8_t channel);
+
+}  // namespace sim
+
+#endif
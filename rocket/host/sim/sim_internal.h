@@ -0,0 +1,33 @@
+#ifndef SIM_INTERNAL_H
+#define SIM_INTERNAL_H
+
+// 시뮬레이터 구현 파일끼리만 쓰는 내부 API
+
+#include <functional>
+#include "sim.h"
+
+class HardwareSerial;
+
+namespace sim {
+
+// advanceUs() 때마다 호출되는 장치 모델 (GPS NMEA 주입 등)
+void registerTicker(std::function<void(uint64_t nowUs)> fn);
+void registerUart(HardwareSerial* port);
+
+// ====== I2C 장치 ======
+// Wire가 주소로 찾아서 호출. write는 [reg, data...], read는 현재 레지스터 포인터부터
+struct I2cDevice {
+  virtual ~I2cDevice() {}
+  virtual bool present(uint8_t address) const { (void)address; return true; }
+  virtual void onWrite(const uint8_t* data, size_t n) = 0;
+  virtual void onRead(uint8_t* out, size_t n) = 0;
+};
+void registerI2c(uint8_t address, I2cDevice* dev);
+I2cDevice* findI2c(uint8_t address);
+
+// I2C 한 트랜잭션의 버스 점유 시간 반영 (start + addr + data + stop, 9bit/byte)
+void i2cTransaction(size_t dataBytes, bool acked);
+
+}  // namespace sim
+
+#endif
@@ -0,0 +1,115 @@
+// 호스트 시뮬레이터 실행기
+//  - 스케치의 setup()/loop()를 가상 시계 위에서 돌림
+//  - loop() 한 번이 끝날 때마다 --tick-us만큼 시간 진행 (MCU 실행 시간 근사)
+//
+//   sensorMain_sim --duration-ms 20000 --sd out_sd --quiet
+//   pinMain_sim --duration-ms 5000 --serial-at 4000 p     (4초에 USB 시리얼로 'p' 입력)
+//   sensorMain_sim --lora-at 6000 "+RCV=1,1,E,-40,11"      (6초에 LoRa 모듈 수신 줄, \r\n 붙음)
+//   groundMain_sim --lora-at 1000 "+RCV=0,84,<base64>,-60,9" (지상국은 LoRa가 Serial1)
+
+#include "Arduino.h"
+#include "sim.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+void setup();
+void loop();
+
+// LoRa 모듈이 붙은 UART (sensorMain = Serial2, groundMain_sim은 CMake에서 Serial1 + SIM_LORA_ON_SERIAL1)
+#ifndef SIM_LORA_PORT
+#define SIM_LORA_PORT Serial2
+#endif
+
+// RYLR998 최소 모델: AT 명령 한 줄이 끝나면 +OK 응답
+static void attachLoraModem() {
+  static std::string line;
+  SIM_LORA_PORT.onTx = [](uint8_t b) {
+    if (b != '\n') {
+      if (line.size() < 256) line += (char)b;
+      return;
+    }
+    if (line.compare(0, 3, "AT+") == 0) SIM_LORA_PORT.inject("+OK\r\n");
+    line.clear();
+  };
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr,
+          "usage: %s [--duration-ms N] [--tick-us N] [--sd DIR] [--eeprom FILE] [--quiet]\n"
+          "          [--serial-at MS TEXT]... [--lora-at MS LINE]...\n",
+          argv0);
+}
+
+int main(int argc, char** argv) {
+  uint64_t durationMs = 10000;
+  uint64_t tickUs = 100;
+  struct SerialInput {
+    HardwareSerial* port;
+    uint64_t atMs;
+    std::string text;
+  };
+  std::vector<SerialInput> serialIn;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    bool hasVal = (i + 1 < argc);
+    if (a == "--duration-ms" && hasVal) durationMs = strtoull(argv[++i], nullptr, 10);
+    else if (a == "--tick-us" && hasVal) tickUs = strtoull(argv[++i], nullptr, 10);
+    else if (a == "--sd" && hasVal) sim::config().sdDir = argv[++i];
+    else if (a == "--eeprom" && hasVal) sim::config().eepromPath = argv[++i];
+    else if (a == "--quiet") sim::config().echoSerial = false;
+    else if (a == "--serial-at" && i + 2 < argc) {
+      uint64_t atMs = strtoull(argv[++i], nullptr, 10);
+      serialIn.push_back({ &Serial, atMs, argv[++i] });
+    }
+    else if (a == "--lora-at" && i + 2 < argc) {
+      uint64_t atMs = strtoull(argv[++i], nullptr, 10);
+      serialIn.push_back({ &SIM_LORA_PORT, atMs, std::string(argv[++i]) + "\r\n" });
+    }
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  attachLoraModem();
+#ifdef SIM_LORA_ON_SERIAL1
+  sim::gps().enabled = false;  // GPS NMEA도 Serial1로 들어옴
+#endif
+
+  auto wall0 = std::chrono::steady_clock::now();
+  setup();
+  for (const SerialInput& in : serialIn)
+    in.port->injectAt(in.atMs * 1000ULL, (const uint8_t*)in.text.data(), in.text.size());
+
+  const uint64_t endUs = durationMs * 1000ULL;
+  uint64_t loops = 0;
+  while (sim::nowUs() < endUs) {
+    loop();
+    sim::advanceUs(tickUs);
+    loops++;
+  }
+  Serial.flush();
+  fflush(stdout);
+
+  double wallMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - wall0)
+                    .count();
+  const sim::I2cStats& i2c = sim::i2cStats();
+  fprintf(stderr, "[sim] %.3f s simulated in %.1f ms wall, loops=%llu (%.1f Hz)\n",
+          sim::nowUs() / 1e6, wallMs, (unsigned long long)loops,
+          loops / (sim::nowUs() / 1e6));
+  fprintf(stderr, "[sim] i2c tx=%u bytes=%u nack=%u busy=%.1f%%\n",
+          i2c.transactions, i2c.bytes, i2c.nacks,
+          100.0 * (double)i2c.busyUs / (double)sim::nowUs());
+  HardwareSerial* ports[] = { &Serial, &Serial1, &Serial2, &Serial3 };
+  for (HardwareSerial* p : ports) {
+    if (!p->baud()) continue;
+    fprintf(stderr, "[sim] %s tx=%u rx=%u rxOvf=%u txBlocked=%u (%.1f ms)\n",
+            p->name(), p->stats.txBytes, p->stats.rxBytes, p->stats.rxOverflow,
+            p->stats.txBlockedCalls, p->stats.txBlockedUs / 1000.0);
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+// I2C 버스: 장치 레지스트리 + 트랜잭션 시간 모델
+
+#include "Wire.h"
+#include "sim_internal.h"
+
+#include <map>
+
+TwoWire Wire;
+
+namespace sim {
+
+static uint32_t g_i2cHz = 100000;
+static const uint32_t I2C_SW_OVERHEAD_US = 20;  // AVR twi 드라이버 호출/인터럽트 처리
+
+static std::multimap<uint8_t, I2cDevice*>& devices() {
+  static std::multimap<uint8_t, I2cDevice*> m;
+  return m;
+}
+
+I2cStats& i2cStats() {
+  static I2cStats s;
+  return s;
+}
+
+void registerI2c(uint8_t address, I2cDevice* dev) { devices().insert({ address, dev }); }
+
+I2cDevice* findI2c(uint8_t address) {
+  auto range = devices().equal_range(address);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->present(address)) return it->second;
+  }
+  return nullptr;
+}
+
+void i2cTransaction(size_t dataBytes, bool acked) {
+  I2cStats& s = i2cStats();
+  s.transactions++;
+  s.bytes += (uint32_t)dataBytes;
+  if (!acked) s.nacks++;
+  size_t bits = 2 + 9 * (1 + (acked ? dataBytes : 0));
+  uint64_t us = (uint64_t)bits * 1000000ULL / g_i2cHz + I2C_SW_OVERHEAD_US;
+  s.busyUs += us;
+  advanceUs(us);
+}
+
+}  // namespace sim
+
+void TwoWire::setClock(uint32_t hz) {
+  if (hz) sim::g_i2cHz = hz;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddr_ = address;
+  txLen_ = 0;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if (txLen_ >= BUFFER_LENGTH) return 0;
+  txBuf_[txLen_++] = b;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buf, size_t n) {
+  size_t k = 0;
+  while (k < n && write(buf[k])) k++;
+  return k;
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+  (void)stop;
+  sim::I2cDevice* dev = sim::findI2c(txAddr_);
+  sim::i2cTransaction(txLen_, dev != nullptr);
+  if (!dev) return 2;  // address NACK
+  dev->onWrite(txBuf_, txLen_);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t stop) {
+  (void)stop;
+  if (quantity > BUFFER_LENGTH) quantity = BUFFER_LENGTH;
+  sim::I2cDevice* dev = sim::findI2c(address);
+  sim::i2cTransaction(quantity, dev != nullptr);
+  rxIdx_ = 0;
+  rxLen_ = 0;
+  if (!dev) return 0;
+  dev->onRead(rxBuf_, quantity);
+  rxLen_ = quantity;
+  return quantity;
+}
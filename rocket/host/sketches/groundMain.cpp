@@ -0,0 +1,3 @@
+// groundMain 스케치를 호스트에서 빌드하기 위한 묶음 (LoRa 모듈은 Serial1)
+#include <Arduino.h>
+#include "../../groundMain/groundMain.ino"
@@ -0,0 +1,3 @@
+// pinMain 스케치를 호스트에서 빌드하기 위한 묶음 (pin.cpp 등은 CMake에서 따로 컴파일)
+#include <Arduino.h>
+#include "../../pinMain/pinMain.ino"
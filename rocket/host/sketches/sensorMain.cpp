@@ -0,0 +1,6 @@
+// sensorMain 스케치를 호스트에서 빌드하기 위한 묶음
+// Arduino 빌더와 같은 순서로 .ino를 이어붙임 (스케치 파일은 수정하지 않음)
+#include <Arduino.h>
+#include "../../sensorMain/sensorMain.ino"
+#include "../../sensorMain/lora.ino"
+#include "../../sensorMain/parachute.ino"
@@ -0,0 +1,83 @@
+#ifndef BARO_ALTITUDE_H
+#define BARO_ALTITUDE_H
+
+// ============================================================================
+// 기압 -> 상대고도 (powf 없는 버전, 헤더 온리)
+//  - 기존 식: alt = K * (1 - (p/p0)^0.1903)
+//    (p/p0)^a = f(p) / f(p0),  f(p) = (p/1100)^a  로 나누면
+//    alt = K - (K / f(p0)) * f(p)   -> K/f(p0)는 p0 정할 때 한 번만 계산
+//  - f(p)는 300~1112.5 hPa를 12.5 hPa 간격 64칸으로 나눈 표 + 2차(3점) 보간
+//    (표 66개 float = 264B, AVR에서는 PROGMEM)
+//  - 최대 오차 (기준식 대비, 300~1100 hPa 전 구간, 0.01 hPa 간격 스윕):
+//      p0 = 1013.25 hPa : 0.04 m,  p0 = 300~1100 hPa 전체 : 0.06 m 이하
+//    BMP280 분해능(X16에서 약 0.12 m)보다 작음. host/bench/baro_alt_bench.cpp 로 확인
+//  - 호출당 float 곱셈/덧셈 10회 정도. powf(log+exp, AVR soft-float 수천 사이클)를 대체
+// ============================================================================
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define BARO_PGM_READ_F(p) pgm_read_float(p)
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define BARO_PGM_READ_F(p) (*(const float*)(p))
+#endif
+
+static const float BARO_ALT_K = 43561.54f;  // 기존 altitudeFromPressure() 상수 그대로
+static const float BARO_TAB_P_MIN = 300.0f;
+static const uint8_t BARO_TAB_N = 64;              // 구간 수
+static const float BARO_TAB_INV_STEP = 64.0f / 800.0f;  // 1 / 12.5 hPa
+
+// f(p) = (p / 1100)^0.1903,  p = 300 + 12.5*i  (i = 0..65, 2차 보간용으로 1칸 더)
+static const float BARO_POW_TAB[BARO_TAB_N + 2] PROGMEM = {
+  0.78094266f, 0.78703298f, 0.79292913f, 0.79864444f, 0.80419084f, 0.80957910f,
+  0.81481895f, 0.81991924f, 0.82488800f, 0.82973259f, 0.83445973f, 0.83907561f,
+  0.84358590f, 0.84799587f, 0.85231036f, 0.85653387f, 0.86067059f, 0.86472440f,
+  0.86869893f, 0.87259756f, 0.87642346f, 0.88017958f, 0.88386872f, 0.88749348f,
+  0.89105632f, 0.89455956f, 0.89800538f, 0.90139585f, 0.90473290f, 0.90801839f,
+  0.91125407f, 0.91444158f, 0.91758251f, 0.92067835f, 0.92373052f, 0.92674038f,
+  0.92970920f, 0.93263823f, 0.93552864f, 0.93838154f, 0.94119800f, 0.94397906f,
+  0.94672568f, 0.94943881f, 0.95211935f, 0.95476816f, 0.95738607f, 0.95997387f,
+  0.96253232f, 0.96506216f, 0.96756409f, 0.97003880f, 0.97248693f, 0.97490912f,
+  0.97730597f, 0.97967806f, 0.98202597f, 0.98435023f, 0.98665137f, 0.98892990f,
+  0.99118631f, 0.99342107f, 0.99563465f, 0.99782748f, 1.00000000f, 1.00215262f,
+};
+
+// f(p). 범위 밖이면 끝 구간으로 외삽 (호출 쪽에서 isValidPressure로 먼저 거름)
+static inline float baroPowP(float p_hPa) {
+  float u = (p_hPa - BARO_TAB_P_MIN) * BARO_TAB_INV_STEP;
+  int16_t i = (u <= 0.0f) ? 0 : (int16_t)u;
+  if (i > BARO_TAB_N - 1) i = BARO_TAB_N - 1;
+  float fr = u - (float)i;
+
+  float y0 = BARO_PGM_READ_F(&BARO_POW_TAB[i]);
+  float y1 = BARO_PGM_READ_F(&BARO_POW_TAB[i + 1]);
+  float y2 = BARO_PGM_READ_F(&BARO_POW_TAB[i + 2]);
+  // Newton 전진차분: y0 + fr*d1 + fr*(fr-1)/2*d2
+  float d1 = y1 - y0;
+  float d2 = y2 - 2.0f * y1 + y0;
+  return y0 + fr * (d1 + (fr - 1.0f) * 0.5f * d2);
+}
+
+// 기준압 p0에 묶인 상수
+struct BaroAltRef {
+  float p0_hPa;
+  float kOverF0;  // K / f(p0)
+};
+
+static inline BaroAltRef baroAltRef(float p0_hPa) {
+  BaroAltRef r;
+  r.p0_hPa = p0_hPa;
+  r.kOverF0 = BARO_ALT_K / baroPowP(p0_hPa);  // p0 바뀔 때만 나눗셈 1회
+  return r;
+}
+
+// 상대고도 (m)
+static inline float baroAltitude(const BaroAltRef& r, float p_hPa) {
+  return BARO_ALT_K - r.kOverF0 * baroPowP(p_hPa);
+}
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef BMP280_BURST_H
+#define BMP280_BURST_H
+
+// ============================================================================
+// BMP280 단일 버스트 읽기 + Bosch 정수 보상 (헤더 온리)
+//  - 0xF7~0xFC 6바이트를 트랜잭션 한 번에 읽음
+//    (Adafruit readTemperature()+readPressure()는 온도를 두 번 읽어 6 트랜잭션)
+//  - 보정계수(0x88~0x9F)는 부팅 때 한 번만 읽어서 캐시
+//  - 데이터시트의 정수 보상식: 온도 32bit, 압력 64bit (Pa, Q24.8)
+//    BMP280_PRESS_INT32 1 이면 32bit 압력식 (1Pa 분해능, AVR에서 더 빠름)
+//  - 새 샘플 판정: raw ADC가 직전과 같으면 아직 변환이 안 끝난 것으로 봄
+//    (normal 모드 측정 주기보다 자주 읽으면 같은 값이 반복됨)
+//    같은 값이 repeatMs 이상 계속되면 입력이 실제로 안 변한 것으로 보고 새 샘플로 처리
+//  - 칩 설정(모드/오버샘플/필터)은 기존대로 Adafruit_BMP280::setSampling()으로 함
+// ============================================================================
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#ifndef BMP280_PRESS_INT32
+#define BMP280_PRESS_INT32 0
+#endif
+
+static const uint8_t BMP280_REG_CALIB = 0x88;
+static const uint8_t BMP280_REG_DATA = 0xF7;  // press_msb ~ temp_xlsb
+
+struct Bmp280Calib {
+  uint16_t T1;
+  int16_t T2, T3;
+  uint16_t P1;
+  int16_t P2, P3, P4, P5, P6, P7, P8, P9;
+};
+
+enum Bmp280Result : uint8_t {
+  BMP280_FAIL = 0,  // I2C 오류 / 바이트 부족
+  BMP280_STALE,     // 직전과 같은 raw (새 변환 전)
+  BMP280_NEW
+};
+
+struct Bmp280Stats {
+  uint32_t reads;
+  uint32_t fresh;
+  uint32_t stale;
+  uint32_t fails;
+};
+
+struct Bmp280Burst {
+  TwoWire* wire;
+  uint8_t addr;
+  Bmp280Calib cal;
+  int32_t tFine;
+  uint32_t lastRawP, lastRawT;
+  bool haveRaw;
+  uint32_t lastNewMs;
+  uint16_t repeatMs;  // 이 시간 넘게 같은 raw면 새 샘플로 인정 (측정 주기의 2~3배)
+  Bmp280Stats st;
+
+  // 마지막 보상 결과
+  int32_t temp_c100;  // 0.01 degC
+  uint32_t press_q8;  // Pa * 256
+};
+
+static inline bool bmp280ReadRegs(TwoWire& w, uint8_t addr, uint8_t reg, uint8_t* buf, uint8_t n) {
+  w.beginTransmission(addr);
+  w.write(reg);
+  if (w.endTransmission(false) != 0) return false;  // repeated start
+  if (w.requestFrom(addr, n) != n) return false;
+  for (uint8_t i = 0; i < n; i++) buf[i] = (uint8_t)w.read();
+  return true;
+}
+
+static inline uint16_t bmp280U16(const uint8_t* c, uint8_t i) {  // little-endian
+  return (uint16_t)c[i] | ((uint16_t)c[i + 1] << 8);
+}
+
+// bmp.begin()이 성공한 주소로 호출 -> 보정계수 캐시
+static inline bool bmp280BurstInit(Bmp280Burst& b, TwoWire& w, uint8_t addr, uint16_t repeatMs = 250) {
+  memset(&b, 0, sizeof(b));
+  b.wire = &w;
+  b.addr = addr;
+  b.repeatMs = repeatMs;
+
+  uint8_t c[24];
+  if (!bmp280ReadRegs(w, addr, BMP280_REG_CALIB, c, sizeof(c))) return false;
+  Bmp280Calib& k = b.cal;
+  k.T1 = bmp280U16(c, 0);
+  k.T2 = (int16_t)bmp280U16(c, 2);
+  k.T3 = (int16_t)bmp280U16(c, 4);
+  k.P1 = bmp280U16(c, 6);
+  k.P2 = (int16_t)bmp280U16(c, 8);
+  k.P3 = (int16_t)bmp280U16(c, 10);
+  k.P4 = (int16_t)bmp280U16(c, 12);
+  k.P5 = (int16_t)bmp280U16(c, 14);
+  k.P6 = (int16_t)bmp280U16(c, 16);
+  k.P7 = (int16_t)bmp280U16(c, 18);
+  k.P8 = (int16_t)bmp280U16(c, 20);
+  k.P9 = (int16_t)bmp280U16(c, 22);
+  return k.T1 != 0 && k.P1 != 0;  // 0이면 보정계수 읽기 실패 (P1=0이면 압력식 0으로 나눔)
+}
+
+// ====== Bosch 보상식 (데이터시트 3.11.3) ======
+// 반환: 0.01 degC, t_fine 갱신
+static inline int32_t bmp280CompT(const Bmp280Calib& k, int32_t adcT, int32_t& tFine) {
+  int32_t var1 = ((((adcT >> 3) - ((int32_t)k.T1 << 1))) * ((int32_t)k.T2)) >> 11;
+  int32_t d = (adcT >> 4) - ((int32_t)k.T1);
+  int32_t var2 = (((d * d) >> 12) * ((int32_t)k.T3)) >> 14;
+  tFine = var1 + var2;
+  return (tFine * 5 + 128) >> 8;
+}
+
+#if BMP280_PRESS_INT32
+// 반환: Pa * 256 (32bit 식은 1Pa 단위라 하위 8bit는 0)
+static inline uint32_t bmp280CompP(const Bmp280Calib& k, int32_t adcP, int32_t tFine) {
+  int32_t var1 = (tFine >> 1) - (int32_t)64000;
+  int32_t var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)k.P6);
+  var2 = var2 + ((var1 * ((int32_t)k.P5)) << 1);
+  var2 = (var2 >> 2) + (((int32_t)k.P4) << 16);
+  var1 = ((((int32_t)k.P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t)k.P2) * var1) >> 1)) >> 18;
+  var1 = ((((32768 + var1)) * ((int32_t)k.P1)) >> 15);
+  if (var1 == 0) return 0;
+  uint32_t p = (((uint32_t)(((int32_t)1048576) - adcP) - (uint32_t)(var2 >> 12))) * 3125;
+  if (p < 0x80000000UL) p = (p << 1) / ((uint32_t)var1);
+  else p = (p / (uint32_t)var1) * 2;
+  var1 = (((int32_t)k.P9) * ((int32_t)(((p >> 3) * (p >> 3)) >> 13))) >> 12;
+  var2 = (((int32_t)(p >> 2)) * ((int32_t)k.P8)) >> 13;
+  p = (uint32_t)((int32_t)p + ((var1 + var2 + (int32_t)k.P7) >> 4));
+  return p << 8;
+}
+#else
+// 반환: Pa * 256
+static inline uint32_t bmp280CompP(const Bmp280Calib& k, int32_t adcP, int32_t tFine) {
+  int64_t var1 = ((int64_t)tFine) - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)k.P6;
+  var2 = var2 + ((var1 * (int64_t)k.P5) << 17);
+  var2 = var2 + (((int64_t)k.P4) << 35);
+  var1 = ((var1 * var1 * (int64_t)k.P3) >> 8) + ((var1 * (int64_t)k.P2) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)k.P1) >> 33;
+  if (var1 == 0) return 0;
+  int64_t p = 1048576 - adcP;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)k.P9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)k.P8) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (((int64_t)k.P7) << 4);
+  return (uint32_t)p;
+}
+#endif
+
+// 6바이트 버스트 읽기. BMP280_NEW일 때만 보상식을 돌려 temp_c100/press_q8 갱신
+static inline Bmp280Result bmp280BurstRead(Bmp280Burst& b, uint32_t nowMs) {
+  b.st.reads++;
+  uint8_t d[6];
+  if (b.wire == nullptr || !bmp280ReadRegs(*b.wire, b.addr, BMP280_REG_DATA, d, sizeof(d))) {
+    b.st.fails++;
+    return BMP280_FAIL;
+  }
+  uint32_t rawP = ((uint32_t)d[0] << 12) | ((uint32_t)d[1] << 4) | (d[2] >> 4);
+  uint32_t rawT = ((uint32_t)d[3] << 12) | ((uint32_t)d[4] << 4) | (d[5] >> 4);
+  if (rawP == 0x80000UL || rawT == 0x80000UL) {  // 리셋값 = 측정 전 / 측정 꺼짐
+    b.st.fails++;
+    return BMP280_FAIL;
+  }
+  if (b.haveRaw && rawP == b.lastRawP && rawT == b.lastRawT && (uint32_t)(nowMs - b.lastNewMs) < b.repeatMs) {
+    b.st.stale++;
+    return BMP280_STALE;
+  }
+  b.haveRaw = true;
+  b.lastNewMs = nowMs;
+  b.lastRawP = rawP;
+  b.lastRawT = rawT;
+
+  b.temp_c100 = bmp280CompT(b.cal, (int32_t)rawT, b.tFine);
+  b.press_q8 = bmp280CompP(b.cal, (int32_t)rawP, b.tFine);
+  b.st.fresh++;
+  return BMP280_NEW;
+}
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef GROUND_LINK_H
+#define GROUND_LINK_H
+
+// ============================================================================
+// 지상국(groundMain) -> PC USB 프레임 (헤더 온리)
+//  - 프레임: VER MSG SEQ(u16) | PAYLOAD | CRC16 (CCITT-FALSE, VER~PAYLOAD, linkProtocol.h)
+//  - 선로: COBS로 0x00을 없앤 뒤 끝에 0x00 -> PC는 0x00마다 자르면 프레임 하나 (길이 필드/SYNC 탐색 없음)
+//  - SEQ는 프레임마다 +1 (TEXT 포함) -> PC가 빠진 프레임 수를 정확히 셈
+//  - 값은 전부 정수 배율, little-endian
+//
+//  TELEM (LoRa 패킷 하나 = USB write 한 번)
+//    t0(u32 로켓 ms, 0 = 없음) | 간격(u8 10ms) | N(u8) | flags(u8)
+//    | lat lon(i32 E7) | temp(i16 0.01C) | 기압(u16 0.1hPa) | 속도(u16 cm/s) | connect(u8)
+//    | RSSI(i16 dBm) | SNR(i8 dB)
+//    | 샘플 x N { roll pitch yaw(i16 0.01deg) | alt(u16 0.1m) | phase*10+chute(u8) }
+//  POS  : 착지 후 위치 (로켓 0xAC). t(u32 로켓 ms) | lat lon(i32 E7) | GPS 고도(i16 m) | 위성 수(u8) | fix(u8)
+//         | connect(u8) | phase*10+chute(u8) | RSSI(i16 dBm) | SNR(i8 dB)
+//  TEXT : ASCII 한 줄 (RX READY, 디코딩 오류, STATS)
+//  CMD  : 업링크 명령 결과. 코드(u8 'E'/'C') | id(u8) | 결과(u8) | 송신 횟수(u8) | 지연(u32 ms, 첫 송신 -> 확인/포기)
+// ============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include "linkProtocol.h"
+
+static const uint8_t GL_VER = 1;
+static const uint8_t GL_MSG_TELEM = 0x01;
+static const uint8_t GL_MSG_TEXT  = 0x02;
+static const uint8_t GL_MSG_CMD   = 0x03;
+static const uint8_t GL_MSG_POS   = 0x04;
+static const uint8_t GL_HDR_LEN = 4;           // VER MSG SEQ(2)
+static const uint8_t GL_TELEM_HDR_LEN = 25;
+static const uint8_t GL_SAMPLE_LEN = 9;
+static const uint8_t GL_POS_LEN = 21;
+static const uint8_t GL_PAYLOAD_MAX = 200;     // TELEM 샘플 19개까지 (LoRa 묶음 최대 17)
+
+// flags: 지상국 버튼 (PC에서 예전 connect 2/3, para 2 표시로 바꿈)
+static const uint8_t GL_FLAG_EJECT_BTN = 0x01;
+static const uint8_t GL_FLAG_SOUND_BTN = 0x02;
+
+// CMD 결과
+static const uint8_t GL_CMD_ACKED    = 0;   // 로켓 텔레메트리 ack로 확인
+static const uint8_t GL_CMD_TIMEOUT  = 1;   // 제한 시간 안에 확인 못 함
+static const uint8_t GL_CMD_REPLACED = 2;   // 확인 전에 다른 명령으로 바뀜
+
+static const uint16_t GL_FRAME_MAX = GL_HDR_LEN + GL_PAYLOAD_MAX + 2;
+static const uint16_t GL_WIRE_MAX = GL_FRAME_MAX + GL_FRAME_MAX / 254 + 2;  // COBS + 0x00
+
+struct GlTx {
+  uint8_t frame[GL_FRAME_MAX];
+  uint8_t wire[GL_WIRE_MAX];
+  int n;
+  uint16_t seq;
+};
+
+static inline void glBegin(GlTx& t, uint8_t msg) {
+  t.n = 0;
+  t.frame[t.n++] = GL_VER;
+  t.frame[t.n++] = msg;
+  push_u16_le(t.frame, t.n, t.seq);
+}
+
+// in[0..n) -> out, 0x00 없음. 반환: 쓴 바이트 수 (최대 n + n/254 + 1)
+static inline size_t cobsEncode(const uint8_t* in, size_t n, uint8_t* out) {
+  size_t o = 1, codeAt = 0;
+  uint8_t code = 1;
+  for (size_t i = 0; i < n; i++) {
+    if (in[i] != 0) {
+      out[o++] = in[i];
+      code++;
+    }
+    if (in[i] == 0 || code == 0xFF) {
+      out[codeAt] = code;
+      code = 1;
+      codeAt = o++;
+    }
+  }
+  out[codeAt] = code;
+  return o;
+}
+
+// CRC 붙이고 COBS + 0x00. 반환: t.wire에 쓴 길이 (그대로 Serial.write)
+static inline size_t glFinish(GlTx& t) {
+  uint16_t crc = crc16_ccitt(t.frame, (size_t)t.n);
+  push_u16_le(t.frame, t.n, crc);
+  size_t w = cobsEncode(t.frame, (size_t)t.n, t.wire);
+  t.wire[w++] = 0x00;
+  t.seq++;
+  return w;
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef LINK_PROTOCOL_H
+#define LINK_PROTOCOL_H
+
+// ============================================================================
+// A보드(pinMain) <-> B보드(sensorMain) UART 링크 공용 정의
+//  - CRC16 CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflect, xorout 0)
+//  - little-endian pack/unpack 헬퍼
+//  - A2B / B2A 프레임 상수
+// 두 스케치가 같은 헤더를 쓰므로 프레임 포맷이 어긋날 일이 없음
+// ============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define LINK_PGM_READ_U16(p) pgm_read_word(p)
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define LINK_PGM_READ_U16(p) (*(const uint16_t*)(p))
+#endif
+
+// ====== 프레임 상수 ======
+// A2B: SYNC1 SYNC2 | VER MSG LEN SEQ(2) TIME(4) | PAYLOAD(LEN) | CRC(2)
+static const uint8_t A2B_SYNC1 = 0xA5;
+static const uint8_t A2B_SYNC2 = 0x5A;
+static const uint8_t A2B_VER   = 1;
+static const uint8_t A2B_MSG   = 0x21;   // IMU + 자세 메시지
+static const uint8_t A2B_LEN   = 20;     // 10 * int16
+static const uint8_t A2B_HDR_LEN = 9;    // VER(1) MSG(1) LEN(1) SEQ(2) TIME(4)
+
+// B2A: SYNC1 SYNC2 | VER MSG LEN reserved(2) | PAYLOAD(LEN) | CRC(2)
+static const uint8_t B2A_SYNC1 = 0xB5;
+static const uint8_t B2A_SYNC2 = 0x5B;
+static const uint8_t B2A_VER   = 1;
+static const uint8_t B2A_MSG   = 0x31;   // parachute status message
+static const uint8_t B2A_LEN   = 6;      // payload length
+static const uint8_t B2A_HDR_LEN = 5;    // VER(1) MSG(1) LEN(1) reserved(2)
+
+// ====== CRC16 CCITT-FALSE ======
+// 테이블은 컴파일 타임에 constexpr로 생성 -> 플래시(PROGMEM)에 512B
+// 바이트당 shift 8회 대신 테이블 조회 1회
+constexpr uint16_t crc16_step(uint16_t crc, uint8_t bits) {
+  return bits == 0 ? crc
+                   : crc16_step((crc & 0x8000) ? (uint16_t)((uint16_t)(crc << 1) ^ 0x1021)
+                                               : (uint16_t)(crc << 1),
+                                (uint8_t)(bits - 1));
+}
+constexpr uint16_t crc16_entry(unsigned i) { return crc16_step((uint16_t)(i << 8), 8); }
+
+#define LINK_CRC_T4(n)  crc16_entry(n), crc16_entry(n + 1), crc16_entry(n + 2), crc16_entry(n + 3)
+#define LINK_CRC_T16(n) LINK_CRC_T4(n), LINK_CRC_T4(n + 4), LINK_CRC_T4(n + 8), LINK_CRC_T4(n + 12)
+#define LINK_CRC_T64(n) LINK_CRC_T16(n), LINK_CRC_T16(n + 16), LINK_CRC_T16(n + 32), LINK_CRC_T16(n + 48)
+
+static const uint16_t CRC16_TABLE[256] PROGMEM = {
+  LINK_CRC_T64(0), LINK_CRC_T64(64), LINK_CRC_T64(128), LINK_CRC_T64(192)
+};
+
+#undef LINK_CRC_T4
+#undef LINK_CRC_T16
+#undef LINK_CRC_T64
+
+static_assert(crc16_entry(1) == 0x1021, "CRC16 table generator");
+static_assert(crc16_entry(255) == 0x1EF0, "CRC16 table generator");
+
+static const uint16_t CRC16_INIT = 0xFFFF;
+
+static inline uint16_t crc16_update(uint16_t crc, uint8_t b) {
+  return (uint16_t)((crc << 8) ^ LINK_PGM_READ_U16(&CRC16_TABLE[(uint8_t)((crc >> 8) ^ b)]));
+}
+
+// 바이트 단위로 들어오는 프레임용 (파서에서 수신 즉시 갱신)
+struct Crc16 {
+  uint16_t value;
+
+  Crc16() : value(CRC16_INIT) {}
+  void reset() { value = CRC16_INIT; }
+  void update(uint8_t b) { value = crc16_update(value, b); }
+  void update(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) value = crc16_update(value, data[i]);
+  }
+};
+
+// 한 번에 계산 (기존 crc16_ccitt와 동일한 결과)
+static inline uint16_t crc16_ccitt(const uint8_t* data, size_t len) {
+  uint16_t crc = CRC16_INIT;
+  for (size_t i = 0; i < len; i++) crc = crc16_update(crc, data[i]);
+  return crc;
+}
+
+// ====== 수신 측 링크 통계 ======
+// 손실/지연을 추측하지 않고 숫자로 보기 위한 카운터
+struct LinkStats {
+  uint32_t framesOk;      // CRC 통과 + 디스패치된 프레임
+  uint32_t crcFail;       // CRC 불일치
+  uint32_t resyncs;       // 헤더 불량(VER/MSG/LEN)으로 프레임 중간에 SYNC 재탐색
+  uint32_t unknownMsg;    // 테이블에 없는 MSG id
+  uint32_t bytesSkipped;  // SYNC 탐색 중 버린 바이트
+  uint32_t seqGaps;       // SEQ 불연속 발생 횟수
+  uint32_t framesLost;    // SEQ 불연속으로 추정한 누락 프레임 수
+  uint16_t lastSeq;
+  bool     haveSeq;
+  int32_t  ageLastMs;     // 수신시각(B) - 송신시각(A) (보드 간 시계 오프셋 포함)
+  int32_t  ageMinMs;      // 최소값 = 오프셋 기준선
+  int32_t  ageMaxMs;      // max - min = 최대 지연 지터
+};
+
+// SEQ 갱신: 첫 프레임 이후 (seq - lastSeq - 1)만큼 누락으로 집계
+// 차이가 반 바퀴 이상이면 송신 측 리셋/역순으로 보고 누락에 넣지 않음
+static inline void linkStatsOnSeq(LinkStats& s, uint16_t seq) {
+  if (s.haveSeq) {
+    uint16_t gap = (uint16_t)(seq - (uint16_t)(s.lastSeq + 1));
+    if (gap != 0) {
+      s.seqGaps++;
+      if (gap < 0x8000) s.framesLost += gap;
+    }
+  }
+  s.lastSeq = seq;
+  s.haveSeq = true;
+}
+
+static inline void linkStatsOnAge(LinkStats& s, int32_t ageMs) {
+  if (s.framesOk == 0 || ageMs < s.ageMinMs) s.ageMinMs = ageMs;
+  if (s.framesOk == 0 || ageMs > s.ageMaxMs) s.ageMaxMs = ageMs;
+  s.ageLastMs = ageMs;
+}
+
+// ====== little-endian 읽기 ======
+static inline uint16_t rd_u16_le(const uint8_t* p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+static inline int16_t rd_i16_le(const uint8_t* p) {
+  return (int16_t)rd_u16_le(p);
+}
+static inline uint32_t rd_u32_le(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ====== little-endian 쓰기 (고정 위치) ======
+static inline void wr_u16_le(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((v >> 8) & 0xFF);
+}
+static inline void wr_u32_le(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((v >> 8) & 0xFF);
+  p[2] = (uint8_t)((v >> 16) & 0xFF);
+  p[3] = (uint8_t)((v >> 24) & 0xFF);
+}
+
+// ====== little-endian 쓰기 (버퍼 뒤에 이어붙이기) ======
+static inline void push_u16_le(uint8_t* buf, int& idx, uint16_t v) {
+  wr_u16_le(&buf[idx], v);
+  idx += 2;
+}
+static inline void push_i16_le(uint8_t* buf, int& idx, int16_t v) { push_u16_le(buf, idx, (uint16_t)v); }
+static inline void push_u32_le(uint8_t* buf, int& idx, uint32_t v) {
+  wr_u32_le(&buf[idx], v);
+  idx += 4;
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+// ============================================================================
+// 단계별 루프 프로파일러 (헤더 온리)
+//  - PROF_SCOPE(stage) : 블록 시작~끝을 micros()로 재서 stage 히스토그램에 누적
+//  - 히스토그램은 log2 고정 버킷 16개 (나눗셈/부동소수 없음)
+//      bucket 0 : 0~1us, bucket k : 2^k ~ 2^(k+1)-1 us, bucket 15 : 32768us 이상
+//  - 출력: profPrint*() 사람용 표, profCsv*() SD 기록용 CSV 한 줄
+//  - LOOP_PROFILE 0 으로 빌드하면 PROF_SCOPE는 아무 코드도 만들지 않음
+// ============================================================================
+
+#include <Arduino.h>
+
+#ifndef LOOP_PROFILE
+#define LOOP_PROFILE 1
+#endif
+
+static const uint8_t PROF_BUCKETS = 16;
+
+struct ProfHist {
+  uint32_t count;
+  uint32_t maxUs;
+  uint32_t totalUs;  // 평균용 (약 71분에 한 번 넘침 -> 주기적으로 리셋)
+  uint16_t bucket[PROF_BUCKETS];  // 포화 카운터
+};
+
+struct ProfStage {
+  const char* name;
+  ProfHist h;
+};
+
+static inline uint8_t profBucket(uint32_t us) {
+  uint8_t b = 0;
+  while (us > 1 && b < PROF_BUCKETS - 1) {
+    us >>= 1;
+    b++;
+  }
+  return b;
+}
+
+static inline void profAdd(ProfHist& h, uint32_t us) {
+  h.count++;
+  h.totalUs += us;
+  if (us > h.maxUs) h.maxUs = us;
+  uint16_t& c = h.bucket[profBucket(us)];
+  if (c != 0xFFFF) c++;
+}
+
+static inline void profResetHist(ProfHist& h) {
+  memset(&h, 0, sizeof(h));
+}
+
+static inline void profReset(ProfStage* stages, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) profResetHist(stages[i].h);
+}
+
+class ProfScope {
+public:
+  explicit ProfScope(ProfHist& h) : h_(h), t0_(micros()) {}
+  explicit ProfScope(ProfStage& s) : h_(s.h), t0_(micros()) {}
+  ~ProfScope() { profAdd(h_, micros() - t0_); }
+
+private:
+  ProfHist& h_;
+  uint32_t t0_;
+};
+
+#define PROF_CAT2(a, b) a##b
+#define PROF_CAT(a, b) PROF_CAT2(a, b)
+#if LOOP_PROFILE
+#define PROF_SCOPE(stage) ProfScope PROF_CAT(profScope_, __LINE__)(stage)
+#else
+#define PROF_SCOPE(stage)
+#endif
+
+// ====== 출력 ======
+// 고정 크기 줄 버퍼 없이 out으로 바로 (이름 길이와 상관없이 잘리지 않음)
+static inline void profPrintNum(Print& out, uint32_t v, uint8_t width) {  // 오른쪽 정렬
+  uint8_t digits = 1;
+  for (uint32_t t = v; t >= 10; t /= 10) digits++;
+  for (; digits < width; digits++) out.print(' ');
+  out.print((unsigned long)v);
+}
+
+static inline void profPrintName(Print& out, const char* name, uint8_t width) {  // 왼쪽 정렬
+  out.print(name);
+  for (size_t len = strlen(name); len < width; len++) out.print(' ');
+}
+
+// 헤더: 버킷 하한 (us)
+static inline void profPrintHeader(Print& out) {
+  out.print(F("stage        n   avgUs   maxUs |"));
+  for (uint8_t k = 0; k < PROF_BUCKETS; k++) {
+    uint32_t lo = (k == 0) ? 0 : (1UL << k);
+    out.print(' ');
+    if (lo >= 1024) {
+      profPrintNum(out, lo >> 10, 4);
+      out.print('k');
+    } else {
+      profPrintNum(out, lo, 5);
+    }
+  }
+  out.println();
+}
+
+static inline void profPrintHist(Print& out, const char* name, const ProfHist& h) {
+  profPrintName(out, name, 8);
+  out.print(' ');
+  profPrintNum(out, h.count, 6);
+  out.print(' ');
+  profPrintNum(out, h.count ? h.totalUs / h.count : 0, 7);
+  out.print(' ');
+  profPrintNum(out, h.maxUs, 7);
+  out.print(F(" |"));
+  for (uint8_t k = 0; k < PROF_BUCKETS; k++) {
+    out.print(' ');
+    profPrintNum(out, h.bucket[k], 5);
+  }
+  out.println();
+}
+
+static inline void profPrint(Print& out, const ProfStage* stages, uint8_t n) {
+  profPrintHeader(out);
+  for (uint8_t i = 0; i < n; i++) profPrintHist(out, stages[i].name, stages[i].h);
+}
+
+// CSV: timeMs,stage,count,avgUs,maxUs,b0..b15
+static inline void profCsvHeader(Print& out) {
+  out.print(F("timeMs,stage,count,avgUs,maxUs"));
+  for (uint8_t k = 0; k < PROF_BUCKETS; k++) {
+    out.print(F(",b"));
+    out.print(k);
+  }
+  out.println();
+}
+
+static inline void profCsvHist(Print& out, uint32_t nowMs, const char* name, const ProfHist& h) {
+  out.print((unsigned long)nowMs);
+  out.print(',');
+  out.print(name);
+  out.print(',');
+  out.print((unsigned long)h.count);
+  out.print(',');
+  out.print((unsigned long)(h.count ? h.totalUs / h.count : 0));
+  out.print(',');
+  out.print((unsigned long)h.maxUs);
+  for (uint8_t k = 0; k < PROF_BUCKETS; k++) {
+    out.print(',');
+    out.print(h.bucket[k]);
+  }
+  out.println();
+}
+
+static inline void profCsv(Print& out, uint32_t nowMs, const ProfStage* stages, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) profCsvHist(out, nowMs, stages[i].name, stages[i].h);
+}
+
+#endif
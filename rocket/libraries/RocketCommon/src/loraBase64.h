@@ -0,0 +1,71 @@
+#ifndef LORA_BASE64_H
+#define LORA_BASE64_H
+
+// ============================================================================
+// LoRa 페이로드 base64 (헤더 온리, 보드/호스트 공용)
+//  - RYLR998 AT+SEND는 문자만 보낼 수 있어서 로켓은 바이너리 패킷을 base64로 보냄 (sensorMain/lora.ino)
+//  - 디코딩: 글자마다 strchr로 알파벳을 훑는 대신 256칸 역표 한 번 읽기
+//    표는 PROGMEM (Uno RAM 2KB), 알파벳 밖 글자는 0xFF -> 디코딩 실패
+//  - '=' 패딩은 마지막 4글자 묶음에서만 허용
+// ============================================================================
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#endif
+
+static const uint8_t B64_REV[256] PROGMEM = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+// in: n글자 (4의 배수), out: outMax 바이트
+// 반환: 디코딩한 바이트 수, 실패(길이/글자/패딩/공간 부족) -1
+static inline int b64Decode(const char* in, uint16_t n, uint8_t* out, uint16_t outMax) {
+  if (n % 4 != 0) return -1;
+  uint16_t o = 0;
+  for (uint16_t i = 0; i < n; i += 4) {
+    uint32_t v = 0;
+    uint8_t pad = 0;
+    for (uint8_t j = 0; j < 4; j++) {
+      char c = in[i + j];
+      uint8_t d;
+      if (c == '=' && i + 4 == n && j >= 2) {
+        d = 0;
+        pad++;
+      } else {
+        if (pad) return -1;  // '=' 뒤에 글자
+        d = pgm_read_byte(&B64_REV[(uint8_t)c]);
+        if (d == 0xFF) return -1;
+      }
+      v = (v << 6) | d;
+    }
+    uint8_t m = 3 - pad;
+    if (o + m > outMax) return -1;
+    out[o++] = (uint8_t)(v >> 16);
+    if (m > 1) out[o++] = (uint8_t)(v >> 8);
+    if (m > 2) out[o++] = (uint8_t)v;
+  }
+  return o;
+}
+
+#endif
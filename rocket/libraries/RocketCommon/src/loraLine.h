@@ -0,0 +1,112 @@
+#ifndef LORA_LINE_H
+#define LORA_LINE_H
+
+// ============================================================================
+// LoRa 모듈 수신 줄 조립 + +RCV 파싱 (헤더 온리, 힙 할당 없음, sensorMain/groundMain 공용)
+//  - readStringUntil('\n')은 줄이 덜 왔으면 Stream 타임아웃(1초)까지 루프를 멈추고 String을 여러 개 만듦
+//  - loraLineFeed: 들어온 바이트만 하나씩 넣고, '\n'에서 줄 완성 (\r 제거, NUL 종료)
+//    LORA_LINE_MAX보다 긴 줄은 '\n'까지 버리고 overflows로 셈
+//    로켓은 짧은 명령만 받으므로 64, 지상국은 텔레메트리 줄(최대 약 265자)을 받으므로 include 전에 크게 정의
+//  - +RCV=<addr>,<len>,<data>,<RSSI>,<SNR> : data는 len 글자 그대로 (쉼표가 있어도 안 깨짐)
+// ============================================================================
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef LORA_LINE_MAX
+#define LORA_LINE_MAX 64
+#endif
+
+struct LoraLine {
+  char buf[LORA_LINE_MAX];
+  uint16_t n;
+  bool overflow;       // 지금 줄이 넘침 -> '\n'까지 버림
+  uint32_t overflows;
+};
+
+struct LoraRcv {
+  uint16_t addr;
+  uint8_t len;
+  const char* data;    // line 안을 가리킴, NUL 종료
+  int16_t rssi;        // dBm
+  int8_t snr;          // dB
+};
+
+struct LoraRxStats {
+  uint32_t rcv;        // +RCV 받은 줄
+  uint32_t bad;        // 모양이 안 맞는 +RCV
+  uint32_t unknown;    // 명령 표에 없는 코드
+  int16_t lastRssi;
+  int8_t lastSnr;
+};
+
+static inline void loraLineInit(LoraLine& l) {
+  memset(&l, 0, sizeof(l));
+}
+
+// 반환: true = l.buf에 줄 하나 완성 (다음 호출에서 덮어씀)
+static inline bool loraLineFeed(LoraLine& l, char c) {
+  if (c == '\r') return false;
+  if (c == '\n') {
+    bool done = !l.overflow && l.n > 0;
+    l.buf[l.n] = '\0';
+    l.n = 0;
+    l.overflow = false;
+    return done;
+  }
+  if (l.overflow) return false;
+  if (l.n >= LORA_LINE_MAX - 1) {
+    l.overflow = true;
+    l.overflows++;
+    return false;
+  }
+  l.buf[l.n++] = c;
+  return false;
+}
+
+// 숫자 하나 읽고 뒤의 구분자를 확인. p는 다음 필드로
+static inline bool loraField(char*& p, long& v, char sep) {
+  char* end;
+  v = strtol(p, &end, 10);
+  if (end == p || *end != sep) return false;
+  p = end + (sep ? 1 : 0);
+  return true;
+}
+
+// line을 제자리에서 나눔 (data 뒤 쉼표를 NUL로)
+static inline bool loraParseRcv(char* line, LoraRcv& r) {
+  if (strncmp(line, "+RCV=", 5) != 0) return false;
+  char* p = line + 5;
+  long addr, len, rssi, snr;
+  if (!loraField(p, addr, ',') || !loraField(p, len, ',')) return false;
+  if (len < 0 || len > 240 || (long)strlen(p) < len + 1 || p[len] != ',') return false;
+  char* data = p;
+  p += len + 1;
+  data[len] = '\0';
+  if (!loraField(p, rssi, ',') || !loraField(p, snr, '\0')) return false;
+  r.addr = (uint16_t)addr;
+  r.len = (uint8_t)len;
+  r.data = data;
+  r.rssi = (int16_t)rssi;
+  r.snr = (int8_t)snr;
+  return true;
+}
+
+static inline void loraRxPrintStats(Print& out, const LoraLine& l, const LoraRxStats& st) {
+  out.print(F("lora rx rcv="));
+  out.print((unsigned long)st.rcv);
+  out.print(F(" bad="));
+  out.print((unsigned long)st.bad);
+  out.print(F(" unk="));
+  out.print((unsigned long)st.unknown);
+  out.print(F(" ovf="));
+  out.print((unsigned long)l.overflows);
+  out.print(F(" rssi="));
+  out.print((int)st.lastRssi);
+  out.print(F(" snr="));
+  out.println((int)st.lastSnr);
+}
+
+#endif
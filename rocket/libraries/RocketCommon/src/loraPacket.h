@@ -0,0 +1,80 @@
+#ifndef LORA_PACKET_H
+#define LORA_PACKET_H
+
+// ============================================================================
+// 로켓 -> 지상국 LoRa 텔레메트리 배치 (헤더 온리, sensorMain lora.ino가 만들고 groundMain이 읽음)
+//  - 값은 전부 정수 배율, big-endian. AT+SEND 한 번 = 패킷 하나 (base64라 최대 240자 = 180B)
+//  - 배치를 바꾸면 여기서만: 양쪽 길이/오프셋이 같이 바뀜
+//
+//  묶음 (0xAB): N | 간격(u8 10ms) | t0(u32 ms) | lat lon(i32 E7) | temp(i16 x100) | connect
+//               | 기압(u16 0.1hPa) | GPS 속도(u16 cm/s) | ack(u8 마지막으로 받은 업링크 명령 id, 0 = 없음)
+//               | 샘플 x N { roll pitch yaw(i16 x100) | alt(u16 0.1m) | phase*10+chute }
+//               i번째 샘플 시각 = t0 + i * 간격, lat/lon/temp/connect/기압/속도는 마지막 샘플 기준
+//  위치 (0xAC) : t(u32 ms) | lat lon(i32 E7) | GPS 고도(i16 m) | 위성 수 | fix | connect | phase*10+chute | ack
+//  단일 (0xAA) : 예전 로켓 펌웨어. roll pitch yaw(i16 x100) | lat lon | alt(u16 0.01m) | temp | connect | phase*10+chute
+//                지상국만 읽음 (로켓은 묶음 N=1로 대신)
+// ============================================================================
+
+#include <stdint.h>
+
+static const uint8_t LORA_PAYLOAD_MAX = 180;   // RYLR998 AT+SEND 240자
+
+static const uint8_t LORA_SYNC_BATCH  = 0xAB;
+static const uint8_t LORA_SYNC_POS    = 0xAC;
+static const uint8_t LORA_SYNC_LEGACY = 0xAA;
+
+// ---- 묶음 ----
+static const uint8_t LORA_BATCH_OFS_N       = 1;
+static const uint8_t LORA_BATCH_OFS_DT      = 2;
+static const uint8_t LORA_BATCH_OFS_T0      = 3;
+static const uint8_t LORA_BATCH_OFS_LAT     = 7;
+static const uint8_t LORA_BATCH_OFS_LON     = 11;
+static const uint8_t LORA_BATCH_OFS_TEMP    = 15;
+static const uint8_t LORA_BATCH_OFS_CONNECT = 17;
+static const uint8_t LORA_BATCH_OFS_PRESS   = 18;
+static const uint8_t LORA_BATCH_OFS_SPEED   = 20;
+static const uint8_t LORA_BATCH_OFS_ACK     = 22;
+static const uint8_t LORA_BATCH_HDR_LEN     = 23;
+
+// 샘플 안 오프셋
+static const uint8_t LORA_SAMPLE_OFS_ROLL  = 0;
+static const uint8_t LORA_SAMPLE_OFS_PITCH = 2;
+static const uint8_t LORA_SAMPLE_OFS_YAW   = 4;
+static const uint8_t LORA_SAMPLE_OFS_ALT   = 6;
+static const uint8_t LORA_SAMPLE_OFS_PHASE = 8;
+static const uint8_t LORA_BATCH_SAMPLE_LEN = 9;
+
+static const uint8_t LORA_BATCH_MAX = (LORA_PAYLOAD_MAX - LORA_BATCH_HDR_LEN) / LORA_BATCH_SAMPLE_LEN;
+
+// ---- 위치 ----
+static const uint8_t LORA_POS_OFS_T       = 1;
+static const uint8_t LORA_POS_OFS_LAT     = 5;
+static const uint8_t LORA_POS_OFS_LON     = 9;
+static const uint8_t LORA_POS_OFS_ALT     = 13;
+static const uint8_t LORA_POS_OFS_SATS    = 15;
+static const uint8_t LORA_POS_OFS_FIX     = 16;
+static const uint8_t LORA_POS_OFS_CONNECT = 17;
+static const uint8_t LORA_POS_OFS_PHASE   = 18;
+static const uint8_t LORA_POS_OFS_ACK     = 19;
+static const uint8_t LORA_POS_LEN         = 20;
+
+// ---- 단일 (예전) ----
+static const uint8_t LORA_LEGACY_OFS_ROLL    = 1;
+static const uint8_t LORA_LEGACY_OFS_PITCH   = 3;
+static const uint8_t LORA_LEGACY_OFS_YAW     = 5;
+static const uint8_t LORA_LEGACY_OFS_LAT     = 7;
+static const uint8_t LORA_LEGACY_OFS_LON     = 11;
+static const uint8_t LORA_LEGACY_OFS_ALT     = 15;
+static const uint8_t LORA_LEGACY_OFS_TEMP    = 17;
+static const uint8_t LORA_LEGACY_OFS_CONNECT = 19;
+static const uint8_t LORA_LEGACY_OFS_PHASE   = 20;
+static const uint8_t LORA_LEGACY_LEN         = 21;
+
+// 필드를 넣거나 빼면 오프셋과 길이가 같이 맞아야 함
+static_assert(LORA_BATCH_OFS_ACK + 1 == LORA_BATCH_HDR_LEN, "LoRa batch header: ack is the last byte");
+static_assert(LORA_SAMPLE_OFS_PHASE + 1 == LORA_BATCH_SAMPLE_LEN, "LoRa batch sample: phase is the last byte");
+static_assert(LORA_POS_OFS_ACK + 1 == LORA_POS_LEN, "LoRa pos: ack is the last byte");
+static_assert(LORA_LEGACY_OFS_PHASE + 1 == LORA_LEGACY_LEN, "LoRa legacy: phase is the last byte");
+static_assert(LORA_BATCH_MAX >= 1, "LoRa batch header > payload");
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef LORA_RADIO_H
+#define LORA_RADIO_H
+
+// ============================================================================
+// RYLR998 무선 설정 (헤더 온리, sensorMain/groundMain 공용)
+//  - 로켓과 지상국이 같은 SF/BW/CR/프리앰블이어야 서로 들림 -> 둘 다 setup에서 loraConfigure()
+//  - 모듈 기본은 SF9/BW125: 비행 중 묶음(base64 92자)이 약 0.51초 -> 500ms 주기를 꽉 채워 업링크를 못 들음
+//    SF7/BW125면 약 0.16초 (감도는 약 5dB 손해)
+//  - AT+PARAMETER=<SF>,<BW>,<CR>,<프리앰블>  BW 7 = 125kHz, CR 1 = 4/5, 프리앰블 12 (NETWORKID 18이 아니면 12 고정)
+// ============================================================================
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef LORA_SF
+#define LORA_SF 7
+#endif
+#define LORA_BW_CODE  7
+#define LORA_CR_CODE  1
+#define LORA_PREAMBLE 12
+
+#define LORA_STR_(x) #x
+#define LORA_STR(x) LORA_STR_(x)
+#define LORA_PARAMETER_AT \
+  "AT+PARAMETER=" LORA_STR(LORA_SF) "," LORA_STR(LORA_BW_CODE) "," LORA_STR(LORA_CR_CODE) "," LORA_STR(LORA_PREAMBLE) "\r\n"
+
+static_assert(LORA_SF >= 5 && LORA_SF <= 11, "RYLR998 BW125: SF5~11");
+
+// 저속 최적화(DE): 심볼이 16ms 이상이면 필수 -> BW125에서는 SF11부터 (모듈이 자동으로 켬)
+#define LORA_LDRO (LORA_SF >= 11 ? 1 : 0)
+
+// 공중 시간 (us). Semtech AN1200.13: 명시 헤더, CRC 켬
+//  심볼 = 2^SF / 125kHz = 2^SF x 8us, 프리앰블 + 4.25 심볼 + 8 + ceil((8PL - 4SF + 44) / 4(SF - 2DE)) x (CR + 4)
+//  PL = 무선 바이트 수 (AT+SEND는 글자 그대로 보냄 -> base64 글자 수)
+constexpr uint32_t loraPayloadSymbols(uint16_t pl) {
+  return 8 + (8 * (int32_t)pl - 4 * LORA_SF + 44 > 0
+                  ? (uint32_t)((8 * (int32_t)pl - 4 * LORA_SF + 44 + 4 * (LORA_SF - 2 * LORA_LDRO) - 1) /
+                               (4 * (LORA_SF - 2 * LORA_LDRO))) * (LORA_CR_CODE + 4)
+                  : 0);
+}
+constexpr uint32_t loraAirtimeUs(uint16_t pl) {
+  return ((uint32_t)LORA_PREAMBLE * 4 + 17 + loraPayloadSymbols(pl) * 4) * (8UL << LORA_SF) / 4;
+}
+
+// setup에서만 (막힘): 설정 한 줄 보내고 +OK까지 기다림. +ERR이나 시간 초과면 false (모듈 설정 그대로)
+//  그 사이 온 다른 줄(+READY 등)은 버림
+static inline bool loraConfigure(Stream& port, uint32_t timeoutMs = 1000) {
+  port.print(F(LORA_PARAMETER_AT));
+  char line[8];
+  uint8_t n = 0;
+  uint32_t t0 = millis();
+  while (millis() - t0 < timeoutMs) {
+    if (!port.available()) {
+      delay(1);
+      continue;
+    }
+    char c = (char)port.read();
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (n < sizeof(line) - 1) line[n++] = c;
+      continue;
+    }
+    line[n] = '\0';
+    n = 0;
+    if (strcmp(line, "+OK") == 0) return true;
+    if (strncmp(line, "+ERR", 4) == 0) return false;
+  }
+  return false;
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+// ============================================================================
+// 협조형 rate-monotonic 스케줄러 (헤더 온리)
+//  - 태스크 테이블: 이름 / 함수 / 주기 / 우선순위 / 마감
+//  - periodUs == 0 : 폴링 태스크. 매 패스마다 먼저 실행 (UART 수신 등)
+//  - periodUs  > 0 : 주기 태스크. 도래한 것 중 priority가 가장 작은 것 "하나만" 실행하고 리턴
+//                    -> 느린 태스크 하나 뒤에도 곧바로 폴링 태스크가 다시 돌게 됨
+//  - priority는 주기가 짧을수록 작게 (rate-monotonic)
+//  - 통계: 실행 횟수, 최악 실행시간(WCET), 시작 지연(jitter), 마감 초과, 건너뛴 주기
+//    폴링 태스크는 "직전 실행과의 간격"을 지연으로 보고, 간격이 마감을 넘으면 초과로 셈
+//  - 실행 시간 분포는 태스크별 log2 히스토그램 (loopProfiler.h, LOOP_PROFILE 0이면 제외)
+// ============================================================================
+
+#include <Arduino.h>
+#include "loopProfiler.h"
+
+typedef void (*TaskFn)(uint32_t nowMs);
+
+struct TaskStats {
+  uint32_t runs;
+  uint32_t overruns;     // 종료 시각 > release + deadline
+  uint32_t skipped;      // 밀려서 통째로 건너뛴 주기 수
+  uint32_t lastUs;       // 마지막 실행 시간
+  uint32_t wcetUs;       // 최악 실행 시간
+  uint32_t jitterMaxUs;  // release 대비 시작 지연 최대 (폴링: 최대 호출 간격)
+#if LOOP_PROFILE
+  ProfHist hist;         // 실행 시간 분포
+#endif
+};
+
+struct Task {
+  const char* name;
+  TaskFn fn;
+  uint32_t periodUs;    // 0 = 폴링
+  uint8_t priority;     // 작을수록 먼저
+  uint32_t deadlineUs;  // release 기준 마감 (폴링: 허용 호출 간격)
+
+  // ---- 실행 중 상태 (테이블에서는 0, {}로. schedInit이 채움) ----
+  uint32_t releaseUs;
+  TaskStats st;
+};
+
+static inline void schedResetStats(Task* tasks, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) memset(&tasks[i].st, 0, sizeof(TaskStats));
+}
+
+// setup() 마지막에 호출: 주기 태스크는 지금부터 release
+static inline void schedInit(Task* tasks, uint8_t n) {
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < n; i++) tasks[i].releaseUs = now;
+  schedResetStats(tasks, n);
+}
+
+static inline void schedRunTask(Task& t) {
+  uint32_t start = micros();
+  uint32_t lateUs = start - t.releaseUs;
+
+  t.fn(millis());
+
+  uint32_t end = micros();
+  uint32_t execUs = end - start;
+
+  TaskStats& s = t.st;
+  s.runs++;
+  s.lastUs = execUs;
+  if (execUs > s.wcetUs) s.wcetUs = execUs;
+  if (lateUs > s.jitterMaxUs) s.jitterMaxUs = lateUs;
+#if LOOP_PROFILE
+  profAdd(s.hist, execUs);
+#endif
+
+  if (t.periodUs == 0) {
+    if (lateUs > t.deadlineUs) s.overruns++;
+    t.releaseUs = start;
+    return;
+  }
+
+  if (end - t.releaseUs > t.deadlineUs) s.overruns++;
+
+  // 다음 release. 이미 여러 주기가 지났으면 건너뛴 만큼 세고 위상 유지
+  t.releaseUs += t.periodUs;
+  uint32_t behind = end - t.releaseUs;
+  if ((int32_t)behind >= (int32_t)t.periodUs) {
+    uint32_t missed = behind / t.periodUs;
+    s.skipped += missed;
+    t.releaseUs += missed * t.periodUs;
+  }
+}
+
+// loop()에서 호출
+static inline void schedRunOnce(Task* tasks, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+    if (tasks[i].periodUs == 0) schedRunTask(tasks[i]);
+  }
+
+  uint32_t now = micros();
+  Task* best = nullptr;
+  for (uint8_t i = 0; i < n; i++) {
+    Task& t = tasks[i];
+    if (t.periodUs == 0 || (int32_t)(now - t.releaseUs) < 0) continue;
+    if (best == nullptr || t.priority < best->priority) best = &t;
+  }
+  if (best) schedRunTask(*best);
+}
+
+// 태스크별 통계 + WCET 기준 CPU 점유율 (sum wcet/period, 폴링 제외)
+static inline void schedPrintStats(Print& out, const Task* tasks, uint8_t n) {
+  uint32_t utilPermille = 0;
+  out.println(F("task       periodUs prio   runs   wcetUs jitMaxUs  ovr   skip"));
+  for (uint8_t i = 0; i < n; i++) {
+    const Task& t = tasks[i];
+    profPrintName(out, t.name, 8);
+    out.print(' ');
+    profPrintNum(out, t.periodUs, 10);
+    out.print(' ');
+    profPrintNum(out, t.priority, 4);
+    out.print(' ');
+    profPrintNum(out, t.st.runs, 6);
+    out.print(' ');
+    profPrintNum(out, t.st.wcetUs, 8);
+    out.print(' ');
+    profPrintNum(out, t.st.jitterMaxUs, 8);
+    out.print(' ');
+    profPrintNum(out, t.st.overruns, 4);
+    out.print(' ');
+    profPrintNum(out, t.st.skipped, 6);
+    out.println();
+    if (t.periodUs) utilPermille += (uint32_t)((uint64_t)t.st.wcetUs * 1000ULL / t.periodUs);
+  }
+  out.print(F("U(wcet)="));
+  out.print(utilPermille / 10);
+  out.print('.');
+  out.print(utilPermille % 10);
+  out.println('%');
+}
+
+#if LOOP_PROFILE
+// 태스크별 실행 시간 히스토그램
+static inline void schedPrintHist(Print& out, const Task* tasks, uint8_t n) {
+  profPrintHeader(out);
+  for (uint8_t i = 0; i < n; i++) profPrintHist(out, tasks[i].name, tasks[i].st.hist);
+}
+
+static inline void schedCsvHist(Print& out, uint32_t nowMs, const Task* tasks, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) profCsvHist(out, nowMs, tasks[i].name, tasks[i].st.hist);
+}
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+#pragma once
+
+// ======================= 자세 융합 파이프라인 =======================
+//  예전: IMU 샘플마다 Mahony 6축 + 9축 둘 다 갱신, 둘 다 computeAngles (atan2f x2 + asinf)
+//  지금:
+//   - 제어(filterRoll)에 쓰는 6축 필터만 샘플마다, 각도는 yaw 하나만 (atan2f 1번)
+//   - 9축(지자기)은 지자기 갱신 주기(AK09916 연속 모드 100Hz)마다 한 번,
+//     그 사이 자이로/가속도 평균을 누적 dt로 (같은 회전량, 정규화/지자기 계산은 1/10)
+//   - 9축 오일러각은 A2B로 보낼 때만, 새 갱신이 있었을 때만 계산
+//  필터는 PIN_FUSION으로 컴파일 시 선택 (가상 함수 없음, 안 쓰는 필터는 링크에서 빠짐)
+//  필터 클래스 조건: updateIMU(g, a, dt), update(g, a, m, dt) (자이로 rad/s), q0~q3, computeAngles()
+
+#include <Arduino.h>
+#include "Adafruit_AHRS_Mahony.h"
+#include "Adafruit_AHRS_Madgwick.h"
+
+#define PIN_FUSION_MAHONY   0
+#define PIN_FUSION_MADGWICK 1
+#ifndef PIN_FUSION
+#define PIN_FUSION PIN_FUSION_MAHONY
+#endif
+
+static const uint32_t NAV_PERIOD_US = 10000;  // 9축 갱신 주기 = 지자기 100Hz
+
+template <class CtrlFilter, class NavFilter>
+class AttitudeFusion {
+public:
+  // IMU 샘플마다. 자이로 rad/s, 가속도 아무 단위(정규화됨), 지자기 uT, dt 초
+  void update(float gx, float gy, float gz, float ax, float ay, float az,
+              float mx, float my, float mz, float dt) {
+    ctrl_.updateIMU(gx, gy, gz, ax, ay, az, dt);
+
+    sum_[0] += gx; sum_[1] += gy; sum_[2] += gz;
+    sum_[3] += ax; sum_[4] += ay; sum_[5] += az;
+    sumDt_ += dt;
+    n_++;
+    if (sumDt_ * 1e6f < (float)NAV_PERIOD_US) return;
+
+    float k = 1.0f / n_;
+    nav_.update(sum_[0] * k, sum_[1] * k, sum_[2] * k, sum_[3] * k, sum_[4] * k, sum_[5] * k,
+                mx, my, mz, sumDt_);
+    for (uint8_t i = 0; i < 6; i++) sum_[i] = 0.0f;
+    sumDt_ = 0.0f;
+    n_ = 0;
+    navDirty_ = true;
+  }
+
+  // 제어용 yaw (deg). computeAngles의 yaw와 같은 식 (DMP 축 매핑 qx=q2, qy=q1, qz=-q3)
+  float ctrlYawDeg() const {
+    const CtrlFilter& f = ctrl_;
+    return atan2f(2.0f * (f.q1 * f.q2 - f.q0 * f.q3),
+                  1.0f - 2.0f * (f.q1 * f.q1 + f.q3 * f.q3)) * 57.29578f;
+  }
+
+  // 9축 오일러각 (deg). 마지막 호출 뒤 갱신이 없으면 false (값 그대로)
+  bool navAngles(float& roll, float& pitch, float& yaw) {
+    if (!navDirty_) return false;
+    navDirty_ = false;
+    nav_.computeAngles();
+    roll = nav_.roll;
+    pitch = nav_.pitch;
+    yaw = nav_.yaw;
+    return true;
+  }
+
+private:
+  CtrlFilter ctrl_;
+  NavFilter nav_;
+  float sum_[6] = {};
+  float sumDt_ = 0.0f;
+  uint16_t n_ = 0;
+  bool navDirty_ = false;
+};
+
+#if PIN_FUSION == PIN_FUSION_MADGWICK
+typedef AttitudeFusion<Adafruit_Madgwick, Adafruit_Madgwick> PinFusion;
+#else
+typedef AttitudeFusion<Adafruit_Mahony, Adafruit_Mahony> PinFusion;
+#endif
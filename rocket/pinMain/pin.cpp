@@ -1,9 +1,8 @@
 #include "pin.h"
-#include "Adafruit_AHRS_Mahony.h"
-#include "Adafruit_AHRS_Madgwick.h"
+#include "attitudeFusion.h"
 
-Adafruit_Mahony mahony6; 
-Adafruit_Mahony mahony9; 
+// 제어용 6축(샘플마다) + 9축(지자기 주기). 필터 종류는 PIN_FUSION
+static PinFusion g_fusion;
 
 // ======================= 자이로 캘리브레이션 변수 =======================
 static bool gyro_calibrating = false;
@@ -117,21 +116,26 @@ static inline float MAG_Z() { return myICM.magZ(); }
 }*/
 
 
-// ======================= 메인 IMU 처리 =======================
-void processIMU()
+// ======================= 9축 오일러각 (A2B 송신 직전) =======================
+void updateNavAngles()
 {
-    uint32_t nowUs = micros();
-    float dt = (nowUs - lastMicros) * 1e-6f;
-    lastMicros = nowUs;
-    if (dt <= 0.0f || dt > 0.2f) return;
+    if (!g_fusion.navAngles(earth_roll, earth_pitch, earth_yaw)) return;
+    flightData.roll  = earth_roll;
+    flightData.pitch = earth_pitch;
+    flightData.yaw   = earth_yaw;
+}
 
-    float ax = ACC_X();
-    float ay = ACC_Y();
-    float az = ACC_Z();
+// ======================= 메인 IMU 처리 =======================
+// FIFO 샘플마다. dt는 micros() 차이 대신 샘플 주기 (FIFO로 몰아 읽어도 적분 간격은 그대로)
+void processIMU(const ImuRaw& s, float dt)
+{
+    float ax = s.ax;
+    float ay = s.ay;
+    float az = s.az;
 
-    float gx = deg2rad(GYR_X_DPS());
-    float gy = deg2rad(GYR_Y_DPS());
-    float gz = deg2rad(GYR_Z_DPS());
+    float gx = deg2rad(s.gx - gx_bias);
+    float gy = deg2rad(s.gy - gy_bias);
+    float gz = deg2rad(s.gz - gz_bias);
 
     float mx = MAG_X();
     float my = -MAG_Y();
@@ -158,29 +162,14 @@ void processIMU()
     imuData.gz = rad2deg(gz);
 
     
-    mahony6.updateIMU(gx, gy, gz, ax, ay, az, dt);
-    mahony6.computeAngles();
- 
-    sensor_yaw   = mahony6.yaw   ;
+    g_fusion.update(gx, gy, gz, ax, ay, az, mx, my, mz, dt);
+
+    sensor_yaw   = g_fusion.ctrlYawDeg();
     flightData.filterRoll = sensor_yaw ;
     //Serial.print(sensor_yaw);Serial.print("//");
     //Serial.print( flightData.filterRoll);Serial.print("//");
-    //Serial.print(earth_roll, 2); Serial.print(F("//"));
-    //Serial.print(earth_pitch, 2);  Serial.print(F("//"));
-    //Serial.print(earth_yaw, 2); Serial.println(F("//"));
-
-    mahony9.update(gx, gy, gz, ax, ay, az, mx, my, mz, dt);
-    mahony9.computeAngles();
-    
-    earth_roll  = mahony9.roll  ;   // rad → deg
-    earth_pitch = mahony9.pitch ;
-    earth_yaw   = mahony9.yaw   ;
 
-    // flightData에 저장
-    flightData.roll  = earth_roll;
-    flightData.pitch = earth_pitch;
-    flightData.yaw   = earth_yaw;
- // Serial.println( earth_yaw);
+    // 9축 roll/pitch/yaw는 보낼 때만 (updateNavAngles)
   
 
     // Earth 각도 추출
@@ -295,6 +284,7 @@ if (gyro_calibrating) {
         //Serial.println(wGyro);
     }
       flightData.imu = imuData;
+      flightData.timeMs = s.tMs;
 
 
 
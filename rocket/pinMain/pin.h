@@ -19,6 +19,13 @@ struct ImuData {
     float gz;  // 각속도 Z
 };
 
+// FIFO에서 꺼낸 샘플 하나 (드라이버 단위, 자이로 바이어스 보정 전)
+struct ImuRaw {
+    float ax, ay, az;  // mg
+    float gx, gy, gz;  // dps
+    uint32_t tMs;      // 샘플 시각 (읽은 시각 - FIFO에 뒤에 쌓인 샘플 수 x 주기)
+};
+
 struct FlightData {
     // 원시 센서 데이터
     ImuData imu;         // IMU 센서 데이터
@@ -64,7 +71,8 @@ void scanI2C(void);
 bool initializeIMU(void);
 
 // 메인
-void processIMU(void);
+void processIMU(const ImuRaw& s, float dt);  // 샘플 하나, dt = 샘플 주기(초)
+void updateNavAngles(void);  // 9축 오일러각 -> flightData.roll/pitch/yaw (보낼 때만)
 
 // 유틸
 float deg2rad(float d);
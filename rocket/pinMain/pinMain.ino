@@ -4,6 +4,8 @@
 #include "pin.h"           // 상보필터/IMU 처리
 #include "PIDController.h" // PID compute
 #include "servo_driver.h"
+#include <linkProtocol.h>
+#include <loopProfiler.h>
 
 #define PIN_CONNECT_DETECT 2
 
@@ -49,25 +51,31 @@ static uint32_t lastResetAttemptMs = 0; // 마지막 리셋 시도 시간
 static bool     isImuHealthy = false;   // 센서 건강 상태
 
 // AtoB 데이터 UART송신(추가)
-// 패킷 내용
-static const uint8_t SYNC1 = 0xA5;
-static const uint8_t SYNC2 = 0x5A;
-static const uint8_t VER   = 1;
-static const uint8_t MSG   = 0x21;
-static const uint8_t LEN   = 20;
-
+// 패킷 구성/CRC16/LE 헬퍼는 linkProtocol.h (sensorMain과 공용)
 static uint16_t g_seq = 0;
 
-// ====== CRC16 CCITT-FALSE ======
-static uint16_t crc16_ccitt(const uint8_t* data, size_t len) {
-  uint16_t crc = 0xFFFF;
-  for (size_t i = 0; i < len; i++) {
-    crc ^= (uint16_t)data[i] << 8;
-    for (int b = 0; b < 8; b++) {
-      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+// ======================= 루프 프로파일 (loopProfiler.h) =======================
+// USB 시리얼로 p = 출력, r = 리셋
+enum { PF_LOOP, PF_IMU, PF_AHRS, PF_SERVO, PF_PRINT, PF_A2B, PF_COUNT };
+ProfStage g_prof[PF_COUNT] = {
+  { "loop", {} },   // loop() 한 번 전체
+  { "imu", {} },    // FIFO 카운트 + 버스트 (I2C), 지자기 주기마다 getAGMT
+  { "ahrs", {} },   // FIFO 샘플마다 processIMU (제어용 6축, 9축은 지자기 주기마다)
+  { "servo", {} },  // PCA9685 쓰기 2채널
+  { "print", {} },  // 디버그 Serial 출력 (PRINT_PERIOD_MS마다)
+  { "a2bTx", {} },  // sendAtoB (9축 오일러각 포함)
+};
+
+static void handleProfCommand() {
+  while (Serial.available()) {
+    char c = (char)Serial.read();
+    if (c == 'p') {
+      profPrint(Serial, g_prof, PF_COUNT);
+      Serial.print(F("imu fifo samples=")); Serial.print(g_imuFifoSamples);
+      Serial.print(F(" resets=")); Serial.println(g_imuFifoResets);
     }
+    else if (c == 'r') profReset(g_prof, PF_COUNT);
   }
-  return crc;
 }
 
 // 반올림
@@ -80,31 +88,21 @@ static inline int16_t s16_scale(float x, float scale) {
   return (int16_t)v;
 }
 
-static inline void push_u16_le(uint8_t* buf, int& idx, uint16_t v) {
-  buf[idx++] = (uint8_t)(v & 0xFF);
-  buf[idx++] = (uint8_t)((v >> 8) & 0xFF);
-}
-static inline void push_i16_le(uint8_t* buf, int& idx, int16_t v) { push_u16_le(buf, idx, (uint16_t)v); }
-static inline void push_u32_le(uint8_t* buf, int& idx, uint32_t v) {
-  buf[idx++] = (uint8_t)(v & 0xFF);
-  buf[idx++] = (uint8_t)((v >> 8) & 0xFF);
-  buf[idx++] = (uint8_t)((v >> 16) & 0xFF);
-  buf[idx++] = (uint8_t)((v >> 24) & 0xFF);
-}
-
 // ====== Send function ======
 void sendAtoB() {
+  updateNavAngles();  // 9축 오일러각은 보낼 때만 계산
+
   uint8_t buf[64];
   int idx = 0;
 
   // SYNC
-  buf[idx++] = SYNC1;
-  buf[idx++] = SYNC2;
+  buf[idx++] = A2B_SYNC1;
+  buf[idx++] = A2B_SYNC2;
 
   // Header
-  buf[idx++] = VER;
-  buf[idx++] = MSG;
-  buf[idx++] = LEN;
+  buf[idx++] = A2B_VER;
+  buf[idx++] = A2B_MSG;
+  buf[idx++] = A2B_LEN;
   push_u16_le(buf, idx, g_seq++);
   push_u32_le(buf, idx, flightData.timeMs);
 
@@ -201,16 +199,40 @@ void setup() {
 }
 
 void loop() {
+  PROF_SCOPE(g_prof[PF_LOOP]);
+  handleProfCommand();
+
   // ================= IMU 자동 복구 로직 =================
   
-  // 1. 데이터 읽기 시도
-  bool dataAvailable = false;
-  if (myICM.dataReady()) {
-    myICM.getAGMT();
-    dataAvailable = true;
-    lastImuDataMs = millis();
-    
+  // 1. FIFO에 쌓인 샘플 전부 읽어서 샘플마다 필터 (루프가 늦어도 샘플은 FIFO에 남아 있음)
+  //    IMU_FIFO_BATCH_MAX개씩 꺼내고, 꽉 채워 나왔으면 더 있을 수 있으니 다시
+  static ImuRaw imuBatch[IMU_FIFO_BATCH_MAX];
+  uint16_t nImu = 0;
+  bool isSpike = false;
+  for (;;) {
+    uint8_t n;
+    {
+      PROF_SCOPE(g_prof[PF_IMU]);
+      n = readImuFifo(imuBatch, IMU_FIFO_BATCH_MAX);
+    }
+    if (n == 0) break;
+    {
+      PROF_SCOPE(g_prof[PF_AHRS]);
+      for (uint8_t i = 0; i < n; i++)
+        processIMU(imuBatch[i], IMU_PERIOD_US * 1e-6f);  // 상보필터 업데이트 (샘플마다 제 간격으로)
+    }
+    for (uint8_t i = 0; i < n; i++) {
+      const ImuRaw& s = imuBatch[i];
+      if ((abs(s.ax) > ACCEL_AXIS_LIMIT) || (abs(s.ay) > ACCEL_AXIS_LIMIT) || (abs(s.az) > ACCEL_AXIS_LIMIT)) {
+        spikeCounter++;
+        isSpike = true;
+      }
+    }
+    nImu += n;
+    if (n < IMU_FIFO_BATCH_MAX) break;
   }
+  if (nImu > 0) lastImuDataMs = millis();
+  bool dataAvailable = nImu > 0;
 
   // 3. 타임아웃 감지 (선이 뽑힘)
   // 500ms 동안 데이터가 안 들어오면 연결끊김으로 판단
@@ -265,13 +287,7 @@ void loop() {
   if (dataAvailable) {
 
 
-    processIMU();  // 상보필터 업데이트
-
-    bool isSpike = (abs(myICM.accX()) > ACCEL_AXIS_LIMIT) || (abs(myICM.accY()) > ACCEL_AXIS_LIMIT) || (abs(myICM.accZ()) > ACCEL_AXIS_LIMIT);
-
       if (isSpike) {
-        spikeCounter++;
-        
         if (spikeCounter >= MAX_SPIKE_COUNT) {
           // [10회 이상 연속] -> 센서 고장으로 판단, 값을 100로 설정
             flightData.filterRoll = 0;
@@ -332,23 +348,31 @@ void loop() {
   
 
   // 서보 출력
-  writeServoDeg(MOTOR_CH1, servoDeg1);
-  writeServoDeg(MOTOR_CH2, servoDeg2);
+  {
+    PROF_SCOPE(g_prof[PF_SERVO]);
+    writeServoDeg(MOTOR_CH1, servoDeg1);
+    writeServoDeg(MOTOR_CH2, servoDeg2);
+  }
   
-  // 디버그 출력
-  Serial.print("Yaw: "); Serial.print(flightData.filterRoll, 1);
-  Serial.print(" Servo1: "); Serial.print(servoDeg1, 1);
-  Serial.print(" Servo2: "); Serial.println(servoDeg2, 1);
+  // 디버그 출력: 115200bps에서 줄 하나 약 1.7ms라 매 샘플 찍으면 제어 주기가 절반 이하로
+  //  -> PRINT_PERIOD_MS마다 한 줄, 남는 시간은 제어 루프로
+  if (millis() - lastDbgMs >= PRINT_PERIOD_MS) {
+    lastDbgMs = millis();
+    PROF_SCOPE(g_prof[PF_PRINT]);
+    Serial.print("Yaw: "); Serial.print(flightData.filterRoll, 1);
+    Serial.print(" Servo1: "); Serial.print(servoDeg1, 1);
+    Serial.print(" Servo2: "); Serial.println(servoDeg2, 1);
+  }
 
   }
 
 
-  // 센서, 통신, 낙하산보드로 데이터 전송
-  flightData.timeMs = millis();
+  // 센서, 통신, 낙하산보드로 데이터 전송 (timeMs = 마지막 샘플 시각, processIMU)
   static uint32_t lastTx = 0;
   uint32_t now = millis();
   if (now - lastTx >= 10) {
     lastTx += 10;
+    PROF_SCOPE(g_prof[PF_A2B]);
     sendAtoB();
   
   }
@@ -2,6 +2,7 @@
 #include <Adafruit_PWMServoDriver.h>
 #include "pin.h"
 #include "servo_driver.h"
+#include "attitudeFusion.h"
 
 // ======================= 유틸 =======================
 uint16_t usToTicks(uint16_t us){
@@ -76,20 +77,71 @@ bool configureIMU() {
   myDLPF.g = (ICM_20948_GYRO_CONFIG_1_DLPCFG_e)6;  
   myICM.enableDLPF(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, true);
   myICM.setDLPFcfg(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, myDLPF);
+
+  // 예전: DMP(펌웨어 약 14KB 로딩) + FIFO를 켜 놓고 루프는 dataReady/getAGMT로 샘플마다 폴링 (FIFO는 안 읽음)
+  // 지금: DMP 없이 가속도+자이로 원시값만 FIFO로. 자세는 attitudeFusion.h가 계산
+  //  DLPF 6(대역 약 12Hz)이라 225Hz면 충분, 1125Hz 전부를 필터에 넣기엔 Mega 부동소수 연산이 모자람
   bool success = true;
-  success &= (myICM.initializeDMP() == ICM_20948_Stat_Ok);
+  ICM_20948_smplrt_t mySmplrt;
+  mySmplrt.a = IMU_SMPLRT_DIV;
+  mySmplrt.g = IMU_SMPLRT_DIV;
+  success &= (myICM.setSampleRate(ICM_20948_Internal_Acc | ICM_20948_Internal_Gyr, mySmplrt) == ICM_20948_Stat_Ok);
+
+  uint8_t fifoEn2 = 0x1E;  // ACCEL | GYRO_Z | GYRO_Y | GYRO_X (온도 없음) -> 가속도 6B + 자이로 6B
+  success &= (myICM.setBank(0) == ICM_20948_Stat_Ok);
+  success &= (myICM.write(AGB0_REG_FIFO_EN_2, &fifoEn2, 1) == ICM_20948_Stat_Ok);
+  success &= (myICM.setFIFOmode(false) == ICM_20948_Stat_Ok);  // stream
+  success &= (myICM.enableFIFO() == ICM_20948_Stat_Ok);
+  success &= (myICM.resetFIFO() == ICM_20948_Stat_Ok);
+  return success;
+}
 
-  success &= (myICM.enableDMPSensor(INV_ICM20948_SENSOR_GAME_ROTATION_VECTOR) == ICM_20948_Stat_Ok);
-  success &= (myICM.enableDMPSensor(INV_ICM20948_SENSOR_ROTATION_VECTOR) == ICM_20948_Stat_Ok);
+// ======================= IMU FIFO =======================
+uint32_t g_imuFifoSamples = 0;
+uint32_t g_imuFifoResets = 0;
 
-  success &= (myICM.setDMPODRrate(DMP_ODR_Reg_Quat6, 0) == ICM_20948_Stat_Ok); // 6축 데이터 속도
-  success &= (myICM.setDMPODRrate(DMP_ODR_Reg_Quat9, 0) == ICM_20948_Stat_Ok); // 9축 데이터 속도
+static inline int16_t rd_i16_be(const uint8_t* p) { return (int16_t)((p[0] << 8) | p[1]); }
 
-  success &= (myICM.setDMPODRrate(DMP_ODR_Reg_Cpass, 0) == ICM_20948_Stat_Ok);
+// 쌓인 샘플을 오래된 것부터 out에 (최대 maxSamples, 나머지는 다음 루프에)
+//  I2C: FIFO_COUNT 1번 + 24B 버스트 (샘플 2개마다 1번). 예전엔 샘플마다 dataReady + getAGMT 23B
+//  지자기는 FIFO에 없으므로 9축 주기(NAV_PERIOD_US)마다 getAGMT로 myICM.magX() 등을 갱신
+uint8_t readImuFifo(ImuRaw* out, uint8_t maxSamples) {
+  static uint32_t lastMagUs = 0;
 
-  success &= (myICM.enableFIFO() == ICM_20948_Stat_Ok);
-  success &= (myICM.enableDMP() == ICM_20948_Stat_Ok);
-  success &= (myICM.resetDMP() == ICM_20948_Stat_Ok);
-  success &= (myICM.resetFIFO() == ICM_20948_Stat_Ok);
-  return true;
-}
\ No newline at end of file
+  uint16_t count = 0;
+  if (myICM.getFIFOcount(&count) != ICM_20948_Stat_Ok) return 0;
+  uint32_t nowMs = millis();
+
+  // 거의 가득 = 이미 덮어썼을 수 있음, 12B 단위가 아니면 경계가 어긋남 -> 비우고 다시
+  if (count > IMU_FIFO_BYTES - IMU_FIFO_SAMPLE_LEN || count % IMU_FIFO_SAMPLE_LEN != 0) {
+    myICM.resetFIFO();
+    g_imuFifoResets++;
+    return 0;
+  }
+
+  uint16_t queued = count / IMU_FIFO_SAMPLE_LEN;
+  uint8_t n = queued < maxSamples ? (uint8_t)queued : maxSamples;
+  uint8_t buf[IMU_FIFO_BURST_SAMPLES * IMU_FIFO_SAMPLE_LEN];
+  for (uint8_t i = 0; i < n; i += IMU_FIFO_BURST_SAMPLES) {
+    uint8_t k = (n - i) < IMU_FIFO_BURST_SAMPLES ? (n - i) : IMU_FIFO_BURST_SAMPLES;
+    if (myICM.readFIFO(buf, k * IMU_FIFO_SAMPLE_LEN) != ICM_20948_Stat_Ok) return i;
+    g_imuFifoSamples += k;
+    for (uint8_t j = 0; j < k; j++) {
+      const uint8_t* p = &buf[j * IMU_FIFO_SAMPLE_LEN];
+      ImuRaw& s = out[i + j];
+      s.ax = rd_i16_be(&p[0]) / 2.048f;   // gpm16: 2048 LSB/g -> mg
+      s.ay = rd_i16_be(&p[2]) / 2.048f;
+      s.az = rd_i16_be(&p[4]) / 2.048f;
+      s.gx = rd_i16_be(&p[6]) / 16.4f;    // dps2000: 16.4 LSB/dps
+      s.gy = rd_i16_be(&p[8]) / 16.4f;
+      s.gz = rd_i16_be(&p[10]) / 16.4f;
+      s.tMs = nowMs - (uint32_t)(queued - 1 - (i + j)) * IMU_PERIOD_US / 1000;
+    }
+  }
+
+  if (n > 0 && micros() - lastMagUs >= NAV_PERIOD_US) {
+    lastMagUs = micros();
+    myICM.getAGMT();
+  }
+  return n;
+}
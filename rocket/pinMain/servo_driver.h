@@ -25,4 +25,16 @@ void writeServoDeg(uint8_t ch, float deg);
 void sweepOnce(void);
 
 // ===== IMU 설정 =====
+//  가속도+자이로를 FIFO로 (12B/샘플), 루프마다 쌓인 것 전부 꺼냄
+static const uint8_t  IMU_SMPLRT_DIV = 4;                            // 1125 / (1 + 4) = 225Hz
+static const uint32_t IMU_PERIOD_US = 1000000UL * (1 + IMU_SMPLRT_DIV) / 1125;
+static const uint8_t  IMU_FIFO_SAMPLE_LEN = 12;
+static const uint16_t IMU_FIFO_BYTES = 512;
+static const uint8_t  IMU_FIFO_BURST_SAMPLES = 2;                    // AVR Wire 버퍼 32B -> 한 번에 24B
+static const uint8_t  IMU_FIFO_BATCH_MAX = 8;                        // 루프 한 번에 꺼내는 최대 (약 36ms치)
+
+extern uint32_t g_imuFifoSamples;  // FIFO에서 꺼낸 샘플 수 (225Hz x 시간과 같아야 함)
+extern uint32_t g_imuFifoResets;   // FIFO가 넘쳐서(또는 12B 단위가 어긋나서) 비운 횟수
+
 bool configureIMU(void);
+uint8_t readImuFifo(struct ImuRaw* out, uint8_t maxSamples);
@@ -0,0 +1,133 @@
+#ifndef ALT_ESTIMATOR_H
+#define ALT_ESTIMATOR_H
+
+// ============================================================================
+// 기압 + 가속도 칼만 필터 (고도 / 수직속도 / 가속도 바이어스, 3상태 고정 크기)
+//  - 예측: A2B로 들어오는 축방향 가속도(flight.imu.az)를 입력으로 logic 주기(10ms)마다
+//          h += v dt + (a - b) dt^2/2,  v += (a - b) dt
+//  - 보정: 새 기압 샘플(baroTimeMs 바뀜)마다 baro.altitude로 갱신
+//  - 가속도가 없거나(A2B 끊김/고장값) 오래되면 a = b (등속 모델) + 공정잡음 크게
+//  - 공분산은 대칭 3x3 -> 원소 6개만 직접 계산 (행렬 라이브러리/동적할당 없음)
+//  - 결과는 flight.est (고도, 속도, 각 분산). altVar <= 0 이면 아직 초기화 전
+//
+//  가정: 기체 z축 = 진행 방향, 거의 수직 비행 (기울기 보정 없음 -> 경사 비행이면 cos 만큼 과대)
+//        A2B 가속도 단위는 mg/100 (1g = 10.0) -> ALT_EST_ACC_SCALE 로 m/s^2 변환
+// ============================================================================
+
+#include <Arduino.h>
+#include "flightType.h"
+
+static const float ALT_EST_G = 9.80665f;
+static const float ALT_EST_ACC_SCALE = ALT_EST_G / 10.0f;  // A2B 가속도 -> m/s^2
+
+// 튜닝값 (표준편차)
+static const float ALT_EST_SIGMA_BARO = 1.0f;     // m, 기압 고도 잡음 (천음속/사출 충격 포함 여유)
+static const float ALT_EST_SIGMA_ACC = 1.0f;      // m/s^2, 가속도 입력 잡음 (연소 진동)
+static const float ALT_EST_SIGMA_ACC_NONE = 8.0f; // m/s^2, 가속도 없을 때 (등속 모델 오차)
+static const float ALT_EST_SIGMA_BIAS = 0.02f;    // m/s^2/sqrt(s), 바이어스 랜덤워크
+static const uint32_t ALT_EST_ACC_TIMEOUT_MS = 100;  // A2B 수신이 이보다 오래되면 가속도 미사용
+static const float ALT_EST_GATE_SQ = 25.0f;       // 혁신 게이트 (5 sigma)^2
+static const uint8_t ALT_EST_MAX_REJECT = 10;     // 연속 거부 후에는 강제 수용 (필터 발산 방지)
+
+struct AltEstimator {
+  bool init;
+  float h, v, b;                      // 고도 m, 속도 m/s, 가속도 바이어스 m/s^2
+  float p00, p01, p02, p11, p12, p22; // 공분산 (대칭)
+  uint32_t lastMs;                    // 마지막 예측 시각
+  uint32_t lastBaroMs;                // 마지막으로 반영한 baroTimeMs
+  uint8_t rejectRun;                  // 연속 게이트 거부 수
+  uint32_t rejects;                   // 누적 거부 수 (디버그)
+};
+
+static inline void altEstReset(AltEstimator& e, float h0) {
+  memset(&e, 0, sizeof(e));
+  e.init = true;
+  e.h = h0;
+  e.p00 = ALT_EST_SIGMA_BARO * ALT_EST_SIGMA_BARO;
+  e.p11 = 1.0f;
+  e.p22 = 0.5f * 0.5f;  // 초기 바이어스 불확실성
+}
+
+static inline void altEstPredict(AltEstimator& e, float dt, float aUp, bool haveAcc) {
+  float sa = haveAcc ? ALT_EST_SIGMA_ACC : ALT_EST_SIGMA_ACC_NONE;
+  float a = haveAcc ? (aUp - e.b) : 0.0f;
+  float hdt2 = 0.5f * dt * dt;
+
+  e.h += e.v * dt + a * hdt2;
+  e.v += a * dt;
+
+  // P = F P F' + Q,  F = [1 dt -dt^2/2; 0 1 -dt; 0 0 1]
+  float r00 = e.p00 + dt * e.p01 - hdt2 * e.p02;
+  float r01 = e.p01 + dt * e.p11 - hdt2 * e.p12;
+  float r02 = e.p02 + dt * e.p12 - hdt2 * e.p22;
+  float r11 = e.p11 - dt * e.p12;
+  float r12 = e.p12 - dt * e.p22;
+
+  float qa = sa * sa;
+  e.p00 = r00 + dt * r01 - hdt2 * r02 + qa * hdt2 * hdt2;
+  e.p01 = r01 - dt * r02 + qa * hdt2 * dt;
+  e.p02 = r02;
+  e.p11 = r11 - dt * r12 + qa * dt * dt;
+  e.p12 = r12;
+  e.p22 += ALT_EST_SIGMA_BIAS * ALT_EST_SIGMA_BIAS * dt;
+}
+
+// 반환: 측정 반영 여부 (게이트에 걸리면 false)
+static inline bool altEstUpdateBaro(AltEstimator& e, float z) {
+  float r = ALT_EST_SIGMA_BARO * ALT_EST_SIGMA_BARO;
+  float y = z - e.h;
+  float s = e.p00 + r;
+  if (y * y > ALT_EST_GATE_SQ * s && e.rejectRun < ALT_EST_MAX_REJECT) {
+    e.rejectRun++;
+    e.rejects++;
+    return false;
+  }
+  e.rejectRun = 0;
+
+  float k0 = e.p00 / s, k1 = e.p01 / s, k2 = e.p02 / s;
+  e.h += k0 * y;
+  e.v += k1 * y;
+  e.b += k2 * y;
+
+  // P = (I - K H) P,  H = [1 0 0]
+  float p00 = e.p00, p01 = e.p01, p02 = e.p02;
+  e.p00 -= k0 * p00;
+  e.p01 -= k0 * p01;
+  e.p02 -= k0 * p02;
+  e.p11 -= k1 * p01;
+  e.p12 -= k1 * p02;
+  e.p22 -= k2 * p02;
+  return true;
+}
+
+// logic 주기마다 호출: 예측 + (새 기압 샘플이면) 보정, 결과를 f.est에 기록
+static inline void altEstStep(AltEstimator& e, FlightData& f, uint32_t nowMs, bool baroOk, bool imuOk) {
+  bool newBaro = baroOk && f.baroTimeMs != 0 && f.baroTimeMs != e.lastBaroMs;
+
+  if (!e.init) {
+    if (!newBaro) return;  // 첫 기압 샘플로 초기화
+    altEstReset(e, f.baro.altitude);
+    e.lastMs = nowMs;
+    e.lastBaroMs = f.baroTimeMs;
+  } else {
+    float dt = (nowMs - e.lastMs) / 1000.0f;
+    e.lastMs = nowMs;
+    if (dt > 0.0f) {
+      if (dt > 0.5f) dt = 0.5f;  // 루프가 멈췄던 경우 (분산만 커지게)
+      bool haveAcc = imuOk && f.aRxTimeMs != 0 && (nowMs - f.aRxTimeMs) < ALT_EST_ACC_TIMEOUT_MS;
+      float aUp = f.imu.az * ALT_EST_ACC_SCALE - ALT_EST_G;
+      altEstPredict(e, dt, aUp, haveAcc);
+    }
+    if (newBaro) {
+      e.lastBaroMs = f.baroTimeMs;
+      altEstUpdateBaro(e, f.baro.altitude);
+    }
+  }
+
+  f.est.altitude = e.h;
+  f.est.velocity = e.v;
+  f.est.altVar = e.p00;
+  f.est.velVar = e.p11;
+}
+
+#endif
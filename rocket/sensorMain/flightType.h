@@ -26,6 +26,21 @@ struct __attribute__((packed)) GpsData {
   bool fix;
 };
 
+// 기압 + 가속도 칼만 추정 결과 (altEstimator.h)
+struct __attribute__((packed)) AltEstData {
+  float altitude;  // m (상대고도)
+  float velocity;  // m/s (위 +)
+  float altVar;    // m^2, 0 이하면 추정 전
+  float velVar;    // (m/s)^2
+};
+
+// 최고고도 예측 vs 카운터 판단 기록 (parachute.ino, 0 = 아직 없음)
+struct __attribute__((packed)) ApogeeLog {
+  uint32_t predMs;    // 예측한 최고고도 시각 (관성비행 중 판단 주기마다 갱신)
+  uint32_t armMs;     // 예측기가 사출 명령을 낸 시각
+  uint32_t detectMs;  // 카운터 로직(isAltitudeDown)이 하강을 확정한 시각
+};
+
 struct __attribute__((packed)) FlightData {
   ImuData imu;
   BaroData baro;
@@ -45,6 +60,9 @@ struct __attribute__((packed)) FlightData {
 
   FlightState state;
   uint32_t timeMs;       // B 기준 시간(=millis)
+
+  AltEstData est;        // 로그 호환을 위해 맨 뒤에 추가 (예전 로그는 recSize 103)
+  ApogeeLog apo;
 };
 
 struct JudgeCounters {            //카운터 초기화 위한 구조체
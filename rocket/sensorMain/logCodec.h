@@ -0,0 +1,259 @@
+#ifndef LOG_CODEC_H
+#define LOG_CODEC_H
+
+// ============================================================================
+// 압축 비행 로그 (RLG1 version 2) 인코더/디코더 (헤더 온리, 보드/호스트 공용)
+//  - 필드마다 정수로 양자화 (float는 고정 배율, 정수/시각은 그대로)
+//    배율은 원래 분해능 이상으로 잡음: A2B int16 값(mg/100, deg/s*10, deg*100)과
+//    BMP280 온도(0.01 C)는 그대로 복원, 압력 0.1 Pa, 고도/속도 1 cm
+//  - 키프레임 'K' : 모든 필드 절대값
+//    델타     'D' : 바뀐 필드 비트마스크 + 바뀐 필드만 (현재 - 직전)
+//    값은 zigzag + varint(LEB128, 7bit씩)
+//  - 레코드: TAG(1) LEN(1, 뒤따르는 바이트 수) BODY
+//    K : varint x LOGC_NFIELDS
+//    D : MASK(LOGC_MASK_BYTES, 필드 i = bit i) + 바뀐 필드 varint
+//  - keyEvery 레코드마다, 그리고 쓰기가 버려진 직후(logEncForceKey)에는 키프레임
+//    -> 디코더는 첫 키프레임 전 델타를 건너뜀 (어디서 잘려도 다음 키프레임부터 복원)
+//  - 100Hz에서 델타 레코드는 보통 30~40B (원래 131B)
+//  - NaN/범위 밖 float는 0 / int32 끝값으로 저장됨
+// ============================================================================
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "flightType.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define LOGC_PGM_READ_B(p) pgm_read_byte(p)
+#else
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define LOGC_PGM_READ_B(p) (*(const uint8_t*)(p))
+#endif
+
+static const uint16_t LOGC_VERSION = 2;  // LogHeader.version
+static const uint8_t LOGC_TAG_KEY = 'K';
+static const uint8_t LOGC_TAG_DELTA = 'D';
+
+// 필드 종류 (= 저장 방식)
+enum LogFieldType : uint8_t {
+  LF_U8 = 0,   // uint8_t / bool
+  LF_U32,      // uint32_t (시각)
+  LF_I32,      // int32_t
+  LF_F10,      // float * 10
+  LF_F100,     // float * 100
+  LF_F1000,    // float * 1000
+  LF_F10000,   // float * 10000
+};
+
+struct LogField {
+  uint8_t offset;  // offsetof(FlightData, ...)
+  uint8_t type;    // LogFieldType
+};
+
+#define LOGC_F(member, type) { (uint8_t)offsetof(FlightData, member), type }
+
+static const LogField LOGC_FIELDS[] PROGMEM = {
+  LOGC_F(imu.ax, LF_F100), LOGC_F(imu.ay, LF_F100), LOGC_F(imu.az, LF_F100),
+  LOGC_F(imu.gx, LF_F10), LOGC_F(imu.gy, LF_F10), LOGC_F(imu.gz, LF_F10),
+  LOGC_F(baro.pressure, LF_F1000), LOGC_F(baro.temperature, LF_F100),
+  LOGC_F(baro.altitude, LF_F100), LOGC_F(baro.climbRate, LF_F100),
+  LOGC_F(gps.latitudeE7, LF_I32), LOGC_F(gps.longitudeE7, LF_I32),
+  LOGC_F(gps.altitude, LF_F100), LOGC_F(gps.speed, LF_F100), LOGC_F(gps.heading, LF_F100),
+  LOGC_F(gps.sats, LF_U8), LOGC_F(gps.fix, LF_U8),
+  LOGC_F(roll, LF_F100), LOGC_F(filterRoll, LF_F100), LOGC_F(pitch, LF_F100), LOGC_F(yaw, LF_F100),
+  LOGC_F(servoDegree, LF_F100),
+  LOGC_F(baroTimeMs, LF_U32), LOGC_F(gpsTimeMs, LF_U32), LOGC_F(aTimeMs, LF_U32), LOGC_F(aRxTimeMs, LF_U32),
+  LOGC_F(state, LF_U8), LOGC_F(timeMs, LF_U32),
+  LOGC_F(est.altitude, LF_F100), LOGC_F(est.velocity, LF_F100),
+  LOGC_F(est.altVar, LF_F10000), LOGC_F(est.velVar, LF_F10000),
+  LOGC_F(apo.predMs, LF_U32), LOGC_F(apo.armMs, LF_U32), LOGC_F(apo.detectMs, LF_U32),
+};
+
+static const uint8_t LOGC_NFIELDS = sizeof(LOGC_FIELDS) / sizeof(LOGC_FIELDS[0]);
+static const uint8_t LOGC_MASK_BYTES = (LOGC_NFIELDS + 7) / 8;
+static const uint8_t LOGC_MAX_REC = 2 + LOGC_MASK_BYTES + LOGC_NFIELDS * 5;  // 키프레임보다 큼
+
+static inline float logcScale(uint8_t type) {
+  switch (type) {
+    case LF_F10: return 10.0f;
+    case LF_F100: return 100.0f;
+    case LF_F1000: return 1000.0f;
+    case LF_F10000: return 10000.0f;
+    default: return 1.0f;
+  }
+}
+
+// FlightData 필드 -> 양자화한 정수 (uint32로 들고 다님, 차이는 wrap 연산)
+static inline uint32_t logcGet(const FlightData& f, uint8_t i) {
+  uint8_t off = LOGC_PGM_READ_B(&LOGC_FIELDS[i].offset);
+  uint8_t type = LOGC_PGM_READ_B(&LOGC_FIELDS[i].type);
+  const uint8_t* p = (const uint8_t*)&f + off;
+  if (type == LF_U8) return *p;
+  uint32_t u;
+  memcpy(&u, p, 4);
+  if (type == LF_U32 || type == LF_I32) return u;
+
+  float v;
+  memcpy(&v, p, 4);
+  float x = v * logcScale(type);
+  if (!(x == x)) return 0;                             // NaN
+  if (x >= 2147483520.0f) return 0x7FFFFFFFUL;         // float로 표현되는 int32 최대 근처
+  if (x <= -2147483520.0f) return 0x80000000UL;
+  return (uint32_t)(int32_t)(x >= 0.0f ? x + 0.5f : x - 0.5f);
+}
+
+static inline void logcSet(FlightData& f, uint8_t i, uint32_t q) {
+  uint8_t off = LOGC_PGM_READ_B(&LOGC_FIELDS[i].offset);
+  uint8_t type = LOGC_PGM_READ_B(&LOGC_FIELDS[i].type);
+  uint8_t* p = (uint8_t*)&f + off;
+  if (type == LF_U8) {
+    *p = (uint8_t)q;
+  } else if (type == LF_U32 || type == LF_I32) {
+    memcpy(p, &q, 4);
+  } else {
+    float v = (float)(int32_t)q / logcScale(type);
+    memcpy(p, &v, 4);
+  }
+}
+
+// ====== zigzag varint ======
+static inline uint8_t logcPutVarint(uint8_t* out, uint32_t delta) {
+  uint32_t z = (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);  // zigzag: 0,-1,1,-2.. -> 0,1,2,3..
+  uint8_t n = 0;
+  while (z >= 0x80) {
+    out[n++] = (uint8_t)(z | 0x80);
+    z >>= 7;
+  }
+  out[n++] = (uint8_t)z;
+  return n;
+}
+
+// 반환: 읽은 바이트 수, 0 = 범위 초과/5바이트 넘음
+static inline uint8_t logcGetVarint(const uint8_t* p, const uint8_t* end, uint32_t& delta) {
+  uint32_t z = 0;
+  for (uint8_t n = 0; n < 5 && p + n < end; n++) {
+    z |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+    if (!(p[n] & 0x80)) {
+      delta = (z >> 1) ^ (0U - (z & 1));
+      return n + 1;
+    }
+  }
+  return 0;
+}
+
+// ====== 인코더 ======
+struct LogEncoder {
+  uint32_t prev[LOGC_NFIELDS];
+  uint16_t keyEvery;
+  uint16_t sinceKey;
+  bool needKey;
+  uint32_t records, keys;
+  uint32_t rawBytes, outBytes;  // 압축 전/후 누적 (통계)
+};
+
+static inline void logEncInit(LogEncoder& e, uint16_t keyEvery) {
+  memset(&e, 0, sizeof(e));
+  e.keyEvery = keyEvery;
+  e.needKey = true;
+}
+
+// 직전 레코드가 SD에 못 들어갔으면 호출 -> 다음은 키프레임
+static inline void logEncForceKey(LogEncoder& e) {
+  e.needKey = true;
+}
+
+// out은 LOGC_MAX_REC 이상. 반환: 레코드 길이
+static inline uint8_t logEncode(LogEncoder& e, const FlightData& f, uint8_t* out) {
+  bool key = e.needKey || e.sinceKey >= e.keyEvery;
+  uint8_t n = 2;
+  if (key) {
+    out[0] = LOGC_TAG_KEY;
+    for (uint8_t i = 0; i < LOGC_NFIELDS; i++) {
+      uint32_t q = logcGet(f, i);
+      n += logcPutVarint(&out[n], q);
+      e.prev[i] = q;
+    }
+    e.needKey = false;
+    e.sinceKey = 0;
+    e.keys++;
+  } else {
+    out[0] = LOGC_TAG_DELTA;
+    uint8_t* mask = &out[2];
+    memset(mask, 0, LOGC_MASK_BYTES);
+    n += LOGC_MASK_BYTES;
+    for (uint8_t i = 0; i < LOGC_NFIELDS; i++) {
+      uint32_t q = logcGet(f, i);
+      if (q == e.prev[i]) continue;
+      mask[i >> 3] |= (uint8_t)(1 << (i & 7));
+      n += logcPutVarint(&out[n], q - e.prev[i]);
+      e.prev[i] = q;
+    }
+  }
+  out[1] = (uint8_t)(n - 2);
+  e.sinceKey++;
+  e.records++;
+  e.rawBytes += sizeof(FlightData);
+  e.outBytes += n;
+  return n;
+}
+
+// ====== 디코더 ======
+struct LogDecoder {
+  uint32_t prev[LOGC_NFIELDS];
+  bool haveKey;
+};
+
+enum LogDecodeResult : uint8_t {
+  LOGC_OK = 0,     // f 채움
+  LOGC_NO_KEY,     // 키프레임 전 델타 (건너뜀)
+  LOGC_SHORT,      // 버퍼 끝에서 잘림
+  LOGC_BAD,        // 태그/길이/내용 이상
+};
+
+// p에서 레코드 하나. used = 레코드 전체 길이 (SHORT/BAD면 0)
+static inline LogDecodeResult logDecode(LogDecoder& d, const uint8_t* p, size_t avail, FlightData& f,
+                                        size_t& used) {
+  used = 0;
+  if (avail < 2) return LOGC_SHORT;
+  uint8_t tag = p[0];
+  if (tag != LOGC_TAG_KEY && tag != LOGC_TAG_DELTA) return LOGC_BAD;
+  size_t len = (size_t)p[1] + 2;
+  if (len > avail) return LOGC_SHORT;
+  const uint8_t* q = p + 2;
+  const uint8_t* end = p + len;
+
+  uint32_t v[LOGC_NFIELDS];
+  if (tag == LOGC_TAG_KEY) {
+    for (uint8_t i = 0; i < LOGC_NFIELDS; i++) {
+      uint8_t k = logcGetVarint(q, end, v[i]);
+      if (!k) return LOGC_BAD;
+      q += k;
+    }
+  } else {
+    if (len < 2u + LOGC_MASK_BYTES) return LOGC_BAD;
+    const uint8_t* mask = q;
+    q += LOGC_MASK_BYTES;
+    for (uint8_t i = 0; i < LOGC_NFIELDS; i++) {
+      v[i] = d.prev[i];
+      if (!(mask[i >> 3] & (1 << (i & 7)))) continue;
+      uint32_t delta;
+      uint8_t k = logcGetVarint(q, end, delta);
+      if (!k) return LOGC_BAD;
+      q += k;
+      v[i] += delta;
+    }
+  }
+  if (q != end) return LOGC_BAD;
+  used = len;
+  if (tag == LOGC_TAG_DELTA && !d.haveKey) return LOGC_NO_KEY;
+
+  d.haveKey = true;
+  memcpy(d.prev, v, sizeof(v));
+  memset(&f, 0, sizeof(f));
+  for (uint8_t i = 0; i < LOGC_NFIELDS; i++) logcSet(f, i, v[i]);
+  return LOGC_OK;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef LOG_FRAME_H
+#define LOG_FRAME_H
+
+// ============================================================================
+// 손상에 강한 로그 프레임 (RLG1 version 4 = v3 종류별 레코드 + 프레임) (헤더 온리, 보드/호스트 공용)
+//  - v1~v3는 레코드가 앞에서부터 이어 붙어 있을 뿐이라 섹터 하나가 깨지면 그 뒤를 전부 잃음
+//  - 프레임: SYNC1 SYNC2 | SEQ(u16) | 레코드(TAG LEN TIME BODY, logRecords.h) | CRC16(SEQ..레코드 끝)
+//    CRC는 linkProtocol.h CRC16 CCITT-FALSE, 레코드당 6B 추가
+//  - SEQ는 기록을 시도한 레코드마다 1씩 증가 (SD 버퍼가 차서 버린 레코드도 번호는 씀)
+//    -> 디코더가 빠진 레코드 수를 셈
+//  - 디코더는 한 번 훑으면서: 프레임 검사 실패 시 다음 SYNC 위치로 건너뛰어 다시 맞춤
+//    (SYNC 2B + LEN 범위 + CRC16이 모두 맞아야 하므로 쓰레기 데이터에서 잘못 맞을 확률은 무시할 수준)
+// ============================================================================
+
+#include <stddef.h>
+#include <string.h>
+#include <linkProtocol.h>
+#include "logRecords.h"
+
+static const uint16_t LF_VERSION = 4;  // LogHeader.version
+static const uint8_t LF_SYNC1 = 0xA5;
+static const uint8_t LF_SYNC2 = 0xC3;  // A2B(0xA5 0x5A)와 다르게
+static const uint8_t LF_HEAD = 4;      // SYNC(2) SEQ(2)
+static const uint8_t LF_OVERHEAD = LF_HEAD + 2;
+static const uint8_t LF_MAX_FRAME = LF_OVERHEAD + LR_MAX_REC;
+
+// 레코드는 이미 out + LF_HEAD에 인코딩돼 있어야 함 (lrEncode*(out + LF_HEAD, ...))
+// 반환: 프레임 전체 길이
+static inline uint8_t lfWrap(uint8_t* out, uint16_t seq, uint8_t recLen) {
+  out[0] = LF_SYNC1;
+  out[1] = LF_SYNC2;
+  out[2] = (uint8_t)seq;
+  out[3] = (uint8_t)(seq >> 8);
+  uint16_t crc = crc16_ccitt(out + 2, 2 + (size_t)recLen);
+  out[LF_HEAD + recLen] = (uint8_t)crc;
+  out[LF_HEAD + recLen + 1] = (uint8_t)(crc >> 8);
+  return (uint8_t)(LF_OVERHEAD + recLen);
+}
+
+enum LfResult : uint8_t {
+  LF_OK = 0,   // seq, recLen 채움. 레코드는 p + LF_HEAD
+  LF_SHORT,    // 버퍼 끝에서 잘림
+  LF_BAD,      // SYNC/길이/CRC 불일치
+};
+
+static inline LfResult lfCheck(const uint8_t* p, size_t avail, uint16_t& seq, uint8_t& recLen) {
+  if (avail < 2) return LF_SHORT;
+  if (p[0] != LF_SYNC1 || p[1] != LF_SYNC2) return LF_BAD;
+  if (avail < (size_t)LF_HEAD + 2) return LF_SHORT;
+  uint8_t len = p[LF_HEAD + 1];
+  if (len < sizeof(uint32_t)) return LF_BAD;  // TIME도 없는 레코드
+  size_t n = 2 + (size_t)len;
+  if (n > 255) return LF_BAD;
+  if ((size_t)LF_OVERHEAD + n > avail) return LF_SHORT;
+  uint16_t crc = crc16_ccitt(p + 2, 2 + n);
+  if (p[LF_HEAD + n] != (uint8_t)crc || p[LF_HEAD + n + 1] != (uint8_t)(crc >> 8)) return LF_BAD;
+  seq = (uint16_t)(p[2] | (p[3] << 8));
+  recLen = (uint8_t)n;
+  return LF_OK;
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef LOG_RECORDS_H
+#define LOG_RECORDS_H
+
+// ============================================================================
+// 종류별 로그 레코드 (RLG1 version 3) (헤더 온리, 보드/호스트 공용)
+//  - FlightData 통째 스냅샷 대신, 값이 새로 생길 때 그 종류만 기록
+//      'I' IMU    : A2B 프레임 받을 때마다 (100Hz)
+//      'B' 기압   : baroTimeMs 바뀔 때 (약 10Hz)
+//      'G' GPS    : 새 위치 수신 시 (5Hz 이하)
+//      'S' 상태   : 비행 상태/칼만 추정/서보 (LOG_STATUS_PERIOD_MS 주기)
+//      'V' 이벤트 : 상태 전이, 사출 명령, 예측/카운터 판단, LoRa 명령
+//  - 레코드: TAG(1) LEN(1, TIME부터 끝까지) TIME(u32, B millis) BODY (little-endian)
+//    값은 정수 배율 (A2B int16 그대로, 고도/속도 cm, 압력 0.1 Pa)
+//  - 디코더(lrApply)는 레코드를 FlightData에 덮어써서 복원 -> 기존 스냅샷 도구에 그대로 씀
+//  - 모르는 TAG는 LEN만큼 건너뜀 (레코드 종류 추가해도 옛 디코더가 안 깨짐)
+// ============================================================================
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "flightType.h"
+
+static const uint16_t LR_VERSION = 3;  // LogHeader.version
+
+static const uint8_t LR_TAG_IMU = 'I';
+static const uint8_t LR_TAG_BARO = 'B';
+static const uint8_t LR_TAG_GPS = 'G';
+static const uint8_t LR_TAG_STATUS = 'S';
+static const uint8_t LR_TAG_EVENT = 'V';
+
+enum LogEventCode : uint8_t {
+  EV_BOOT = 1,      // arg = 기준압 p0 (hPa x1000)
+  EV_STATE,         // arg = 새 FlightState
+  EV_DEPLOY,        // arg = 0 (g_parachuteDeployed 상승)
+  EV_APO_ARM,       // arg = 예측 최고고도 시각 (apo.predMs), TIME = apo.armMs
+  EV_APO_DETECT,    // arg = 0, TIME = apo.detectMs (카운터 하강 확정)
+  EV_LORA_CMD,      // arg = 명령 문자 | -RSSI(dBm) << 8 | SNR(int8) << 16 | 명령 id << 24 (0 = id 없음)
+};
+
+struct __attribute__((packed)) LrHead {
+  uint8_t tag;
+  uint8_t len;
+  uint32_t timeMs;
+};
+
+struct __attribute__((packed)) LrImu {   // TIME = aRxTimeMs
+  uint32_t aTimeMs;
+  int16_t ax, ay, az;     // A2B 단위 x100
+  int16_t gx, gy, gz;     // deg/s x10
+  int16_t roll, filterRoll, pitch, yaw;  // deg x100
+};
+
+struct __attribute__((packed)) LrBaro {  // TIME = baroTimeMs
+  uint32_t pressure;      // hPa x1000 (0.1 Pa)
+  int16_t temperature;    // C x100
+  int32_t altitude;       // cm
+  int16_t climbRate;      // cm/s
+};
+
+struct __attribute__((packed)) LrGps {   // TIME = gpsTimeMs
+  int32_t latitudeE7, longitudeE7;
+  int32_t altitude;       // cm
+  uint16_t speed;         // cm/s
+  uint16_t heading;       // deg x100
+  uint8_t sats;
+  uint8_t fix;
+};
+
+struct __attribute__((packed)) LrStatus {  // TIME = timeMs
+  uint8_t state;
+  int16_t servoDegree;    // deg x100
+  int32_t estAltitude;    // cm
+  int32_t estVelocity;    // cm/s
+  float altVar, velVar;
+};
+
+struct __attribute__((packed)) LrEvent {
+  uint8_t code;
+  uint32_t arg;
+};
+
+static const uint8_t LR_MAX_REC = sizeof(LrHead) + sizeof(LrImu);  // 가장 큰 레코드
+
+// ====== 정수화 ======
+static inline int32_t lrQ32(float v, float scale) {
+  float x = v * scale;
+  if (!(x == x)) return 0;
+  if (x >= 2147483520.0f) return 0x7FFFFFFFL;
+  if (x <= -2147483520.0f) return -0x7FFFFFFFL - 1;
+  return (int32_t)(x >= 0.0f ? x + 0.5f : x - 0.5f);
+}
+
+static inline int16_t lrQ16(float v, float scale) {
+  int32_t q = lrQ32(v, scale);
+  if (q > 32767) return 32767;
+  if (q < -32768) return -32768;
+  return (int16_t)q;
+}
+
+static inline uint8_t lrPut(uint8_t* out, uint8_t tag, uint32_t timeMs, const void* body, uint8_t n) {
+  LrHead h = { tag, (uint8_t)(sizeof(uint32_t) + n), timeMs };
+  memcpy(out, &h, sizeof(h));
+  memcpy(out + sizeof(h), body, n);
+  return (uint8_t)(sizeof(h) + n);
+}
+
+// ====== 인코더: out은 LR_MAX_REC 이상, 반환 = 레코드 길이 ======
+static inline uint8_t lrEncodeImu(uint8_t* out, const FlightData& f) {
+  LrImu r;
+  r.aTimeMs = f.aTimeMs;
+  r.ax = lrQ16(f.imu.ax, 100.0f);
+  r.ay = lrQ16(f.imu.ay, 100.0f);
+  r.az = lrQ16(f.imu.az, 100.0f);
+  r.gx = lrQ16(f.imu.gx, 10.0f);
+  r.gy = lrQ16(f.imu.gy, 10.0f);
+  r.gz = lrQ16(f.imu.gz, 10.0f);
+  r.roll = lrQ16(f.roll, 100.0f);
+  r.filterRoll = lrQ16(f.filterRoll, 100.0f);
+  r.pitch = lrQ16(f.pitch, 100.0f);
+  r.yaw = lrQ16(f.yaw, 100.0f);
+  return lrPut(out, LR_TAG_IMU, f.aRxTimeMs, &r, sizeof(r));
+}
+
+static inline uint8_t lrEncodeBaro(uint8_t* out, const FlightData& f) {
+  LrBaro r;
+  r.pressure = (uint32_t)lrQ32(f.baro.pressure, 1000.0f);
+  r.temperature = lrQ16(f.baro.temperature, 100.0f);
+  r.altitude = lrQ32(f.baro.altitude, 100.0f);
+  r.climbRate = lrQ16(f.baro.climbRate, 100.0f);
+  return lrPut(out, LR_TAG_BARO, f.baroTimeMs, &r, sizeof(r));
+}
+
+static inline uint8_t lrEncodeGps(uint8_t* out, const FlightData& f) {
+  LrGps r;
+  r.latitudeE7 = f.gps.latitudeE7;
+  r.longitudeE7 = f.gps.longitudeE7;
+  r.altitude = lrQ32(f.gps.altitude, 100.0f);
+  int32_t sp = lrQ32(f.gps.speed, 100.0f);
+  r.speed = (uint16_t)(sp < 0 ? 0 : (sp > 65535 ? 65535 : sp));
+  int32_t hd = lrQ32(f.gps.heading, 100.0f);
+  r.heading = (uint16_t)(hd < 0 ? 0 : (hd > 65535 ? 65535 : hd));
+  r.sats = f.gps.sats;
+  r.fix = f.gps.fix ? 1 : 0;
+  return lrPut(out, LR_TAG_GPS, f.gpsTimeMs, &r, sizeof(r));
+}
+
+static inline uint8_t lrEncodeStatus(uint8_t* out, const FlightData& f) {
+  LrStatus r;
+  r.state = (uint8_t)f.state;
+  r.servoDegree = lrQ16(f.servoDegree, 100.0f);
+  r.estAltitude = lrQ32(f.est.altitude, 100.0f);
+  r.estVelocity = lrQ32(f.est.velocity, 100.0f);
+  r.altVar = f.est.altVar;
+  r.velVar = f.est.velVar;
+  return lrPut(out, LR_TAG_STATUS, f.timeMs, &r, sizeof(r));
+}
+
+static inline uint8_t lrEncodeEvent(uint8_t* out, uint32_t timeMs, uint8_t code, uint32_t arg) {
+  LrEvent r = { code, arg };
+  return lrPut(out, LR_TAG_EVENT, timeMs, &r, sizeof(r));
+}
+
+// ====== 디코더 ======
+enum LrResult : uint8_t {
+  LR_OK = 0,     // f 갱신 (ev는 이벤트일 때만 채움)
+  LR_UNKNOWN,    // 모르는 TAG, 건너뜀
+  LR_SHORT,      // 버퍼 끝에서 잘림
+  LR_BAD,        // 길이가 종류와 안 맞음
+};
+
+struct LrEventOut {
+  bool valid;
+  uint8_t code;
+  uint32_t timeMs;
+  uint32_t arg;
+};
+
+// p에서 레코드 하나를 f에 반영. used = 레코드 전체 길이
+static inline LrResult lrApply(const uint8_t* p, size_t avail, FlightData& f, LrEventOut& ev, size_t& used) {
+  used = 0;
+  ev.valid = false;
+  if (avail < sizeof(LrHead)) return LR_SHORT;
+  LrHead h;
+  memcpy(&h, p, sizeof(h));
+  if (h.len < sizeof(uint32_t)) return LR_BAD;
+  size_t total = 2 + (size_t)h.len;
+  if (total > avail) return LR_SHORT;
+  const uint8_t* b = p + sizeof(h);
+  uint8_t n = h.len - sizeof(uint32_t);
+
+  switch (h.tag) {
+    case LR_TAG_IMU: {
+      if (n != sizeof(LrImu)) return LR_BAD;
+      LrImu r;
+      memcpy(&r, b, sizeof(r));
+      f.aRxTimeMs = h.timeMs;
+      f.aTimeMs = r.aTimeMs;
+      f.imu.ax = r.ax / 100.0f;
+      f.imu.ay = r.ay / 100.0f;
+      f.imu.az = r.az / 100.0f;
+      f.imu.gx = r.gx / 10.0f;
+      f.imu.gy = r.gy / 10.0f;
+      f.imu.gz = r.gz / 10.0f;
+      f.roll = r.roll / 100.0f;
+      f.filterRoll = r.filterRoll / 100.0f;
+      f.pitch = r.pitch / 100.0f;
+      f.yaw = r.yaw / 100.0f;
+      break;
+    }
+    case LR_TAG_BARO: {
+      if (n != sizeof(LrBaro)) return LR_BAD;
+      LrBaro r;
+      memcpy(&r, b, sizeof(r));
+      f.baroTimeMs = h.timeMs;
+      f.baro.pressure = r.pressure / 1000.0f;
+      f.baro.temperature = r.temperature / 100.0f;
+      f.baro.altitude = r.altitude / 100.0f;
+      f.baro.climbRate = r.climbRate / 100.0f;
+      break;
+    }
+    case LR_TAG_GPS: {
+      if (n != sizeof(LrGps)) return LR_BAD;
+      LrGps r;
+      memcpy(&r, b, sizeof(r));
+      f.gpsTimeMs = h.timeMs;
+      f.gps.latitudeE7 = r.latitudeE7;
+      f.gps.longitudeE7 = r.longitudeE7;
+      f.gps.altitude = r.altitude / 100.0f;
+      f.gps.speed = r.speed / 100.0f;
+      f.gps.heading = r.heading / 100.0f;
+      f.gps.sats = r.sats;
+      f.gps.fix = r.fix != 0;
+      break;
+    }
+    case LR_TAG_STATUS: {
+      if (n != sizeof(LrStatus)) return LR_BAD;
+      LrStatus r;
+      memcpy(&r, b, sizeof(r));
+      f.state = (FlightState)r.state;
+      f.servoDegree = r.servoDegree / 100.0f;
+      f.est.altitude = r.estAltitude / 100.0f;
+      f.est.velocity = r.estVelocity / 100.0f;
+      f.est.altVar = r.altVar;
+      f.est.velVar = r.velVar;
+      break;
+    }
+    case LR_TAG_EVENT: {
+      if (n != sizeof(LrEvent)) return LR_BAD;
+      LrEvent r;
+      memcpy(&r, b, sizeof(r));
+      ev.valid = true;
+      ev.code = r.code;
+      ev.timeMs = h.timeMs;
+      ev.arg = r.arg;
+      if (r.code == EV_STATE) f.state = (FlightState)r.arg;
+      else if (r.code == EV_APO_ARM) {
+        f.apo.armMs = h.timeMs;
+        f.apo.predMs = r.arg;
+      } else if (r.code == EV_APO_DETECT) {
+        f.apo.detectMs = h.timeMs;
+      }
+      break;
+    }
+    default:
+      used = total;
+      return LR_UNKNOWN;
+  }
+  f.timeMs = h.timeMs;
+  used = total;
+  return LR_OK;
+}
+
+#endif
@@ -3,16 +3,95 @@
 
 #include <Arduino.h>
 #include "flightType.h"
+#include "loraTxQueue.h"
+#include <loraLine.h>
+#include <loraRadio.h>
+#include <loraPacket.h>
 
 extern bool g_parachuteDeployed;
 
+// ====== 텔레메트리 묶음 전송 ======
+//  비행 단계별 표(LORA_RATES)의 간격으로 샘플을 모아 AT+SEND 한 번에
+//  패킷 배치(묶음 0xAB / 위치 0xAC)는 지상국과 같이 쓰는 loraPacket.h
+//  비행 중 기본 5 x 100ms: 500ms마다 68B(base64 92자) -> 샘플 10Hz
+//  공중 시간: initLora가 SF7/BW125로 설정 (loraRadio.h) -> 92자 약 0.16초 (주기의 1/3, 나머지는 업링크 수신)
+//             모듈 기본 SF9였다면 약 0.51초로 주기를 넘어 업링크를 못 들음
+#ifndef LORA_BATCH_SAMPLES
+#define LORA_BATCH_SAMPLES 5
+#endif
+static_assert(LORA_BATCH_SAMPLES >= 1 && LORA_BATCH_SAMPLES <= LORA_BATCH_MAX, "RYLR998 payload 240 chars");
+
+static const uint32_t LORA_PERIOD_MS = 100;  // 판단 주기 (태스크 테이블). 실제 샘플 간격은 LORA_RATES
+
+// ====== 비행 단계별 송신 표 ======
+//  발사대 : 2초마다 샘플 하나 (하트비트, 공중 시간 약 12%)
+//  비행   : LORA_BATCH_SAMPLES개씩 100ms 간격 (SF7에서 공중 시간 약 1/3)
+//          LORA_BATCH_SAMPLES 1이면 500ms마다 하나 (예전 단일 패킷 주기)
+//  착지 후 : 자세 없이 위치만 5초마다 (회수용, 공중 시간 약 3%)
+//  단계가 바뀌면 모인 샘플을 바로 보내고 새 간격으로 (발사/사출 전이를 다음 묶음까지 미루지 않음)
+enum LoraKind : uint8_t { LORA_KIND_BATCH, LORA_KIND_POS };
+
+struct LoraRate {
+  uint16_t sampleMs;   // 샘플 간격 (LORA_PERIOD_MS 배수, 묶음은 2550 이하)
+  uint8_t samples;     // 묶음 하나의 샘플 수 (위치는 1)
+  uint8_t kind;
+};
+
+static const uint16_t LORA_FLIGHT_SAMPLE_MS = LORA_BATCH_SAMPLES > 1 ? 100 : 500;
+
+static constexpr LoraRate LORA_RATES[] = {
+  { 2000, 1, LORA_KIND_BATCH },                                     // STANDBY
+  { LORA_FLIGHT_SAMPLE_MS, LORA_BATCH_SAMPLES, LORA_KIND_BATCH },   // LAUNCHED
+  { LORA_FLIGHT_SAMPLE_MS, LORA_BATCH_SAMPLES, LORA_KIND_BATCH },   // POWERED
+  { LORA_FLIGHT_SAMPLE_MS, LORA_BATCH_SAMPLES, LORA_KIND_BATCH },   // COASTING
+  { LORA_FLIGHT_SAMPLE_MS, LORA_BATCH_SAMPLES, LORA_KIND_BATCH },   // APOGEE
+  { LORA_FLIGHT_SAMPLE_MS, LORA_BATCH_SAMPLES, LORA_KIND_BATCH },   // DESCENT
+  { 5000, 1, LORA_KIND_POS },                                       // LANDED
+};
+static_assert(sizeof(LORA_RATES) / sizeof(LORA_RATES[0]) == LANDED + 1, "LORA_RATES: FlightState마다 한 줄");
+
+constexpr bool loraRatesOk(unsigned i) {
+  return i > LANDED ||
+         (LORA_RATES[i].sampleMs % LORA_PERIOD_MS == 0 && LORA_RATES[i].samples >= 1 &&
+          LORA_RATES[i].samples <= LORA_BATCH_MAX &&
+          (LORA_RATES[i].kind == LORA_KIND_POS || LORA_RATES[i].sampleMs / 10 <= 255) &&
+          loraRatesOk(i + 1));
+}
+static_assert(loraRatesOk(0), "LORA_RATES: 간격은 LORA_PERIOD_MS 배수, 묶음 간격 2550ms 이하, 샘플 1~LORA_BATCH_MAX");
+
+// 한 줄의 공중 시간이 송신 주기의 절반 이하 (나머지 절반은 업링크 수신, 반이중)
+constexpr uint16_t loraRateChars(unsigned i) {
+  return ((LORA_RATES[i].kind == LORA_KIND_POS ? LORA_POS_LEN
+                                               : LORA_BATCH_HDR_LEN + LORA_RATES[i].samples * LORA_BATCH_SAMPLE_LEN) + 2) / 3 * 4;
+}
+constexpr bool loraAirtimeOk(unsigned i) {
+  return i > LANDED ||
+         (loraAirtimeUs(loraRateChars(i)) * 2 <= (uint32_t)LORA_RATES[i].sampleMs * LORA_RATES[i].samples * 1000UL &&
+          loraAirtimeOk(i + 1));
+}
+static_assert(loraAirtimeOk(0), "LORA_RATES: 공중 시간이 송신 주기의 50% 초과 (LORA_SF를 낮추거나 샘플 수/간격 조정)");
+
 // LoRa 초기화
 void initLora();
 
 // FlightData를 LoRa로 송신
 void sendLoraFromFlight(const FlightData& f, bool parachuteDeployed, uint8_t connect);
 
+// 업링크 명령/AT 응답 수신. 와 있는 바이트만 읽고 바로 리턴 (loraLine.h)
 void handleLoraRxCommand();
+extern LoraLine g_loraLine;
+extern LoraRxStats g_loraRxSt;
+
+// 업링크 명령: data = <코드><id 16진 2자리> (예: "E07"), id 1~255
+//  같은 (코드, id)가 다시 오면(지상국 재전송) 실행하지 않고, 마지막 id를 텔레메트리마다 ack로 실어 보냄
+//  (id만 보면 지상국이 재시작해 id를 다시 1부터 쓸 때 다른 명령이 건너뛰어진 채 ack됨)
+//  id 없는 한 글자 명령("E")은 예전처럼 받을 때마다 실행
+extern uint8_t g_loraAckId;
+extern char g_loraAckCode;
+
+// 송신 큐: 매 루프 serviceLoraTx()로 UART 빈자리만큼만 내보냄 (loraTxQueue.h)
+extern LoraTxQueue g_loraTx;
+void serviceLoraTx();
 
 
 #endif
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include "lora.h"
+#include <loraRadio.h>
 
 
 
@@ -9,7 +10,10 @@
 #define LORA_PORT  Serial2
 static const uint32_t LORA_BAUD = 9600;
 static const uint8_t  LORA_ADDR = 0;            // AT+SEND=0,...
-static const uint32_t LORA_PERIOD_MS = 500;     //  송신 hz
+
+LoraTxQueue g_loraTx;
+uint8_t g_loraAckId = 0;
+char g_loraAckCode = 0;   // g_loraAckId로 실행한 명령 코드
 
 // ======================= base64 =======================
 static const char b64_tbl[] =
@@ -85,97 +89,209 @@ static inline uint8_t packPhaseChute(uint8_t phase, bool chute) {
 // ======================= LoRa init =======================
 void initLora() {
   LORA_PORT.begin(LORA_BAUD);
+  loraTxInit(g_loraTx);
+  loraLineInit(g_loraLine);
   delay(200);
+  // 모듈 기본 SF9로는 비행 묶음이 송신 주기를 다 씀 -> SF7 (지상국도 같은 설정, loraRadio.h)
+  if (!loraConfigure(LORA_PORT)) Serial.println("LORA PARAMETER FAIL");
 }
 
-// ======================= 핵심: FlightData -> LoRa 송신 =======================
-void sendLoraFromFlight(const FlightData& f, bool parachuteDeployed, uint8_t connect = 0) {
-  static uint32_t lastMs = 0;
-  uint32_t nowMs = millis();
-  if (nowMs - lastMs < LORA_PERIOD_MS) return;
-  lastMs = nowMs;
+// ======================= AT+SEND =======================
+static const int LORA_MAX_RAW = LORA_BATCH_HDR_LEN + LORA_BATCH_SAMPLES * LORA_BATCH_SAMPLE_LEN;
+static_assert(((LORA_MAX_RAW + 2) / 3) * 4 + 16 <= LORA_TXQ_CMD_MAX, "raise LORA_TXQ_CMD_MAX");
 
-  uint8_t buf[32];
-  int idx = 0;
+static void loraSendPayload(const uint8_t* buf, int len) {
+  char payload[((LORA_MAX_RAW + 2) / 3) * 4 + 1];
+  int payloadLen = base64Encode(buf, len, payload);
 
-  buf[idx++] = 0xAA; // sync
+  // RYLR998: AT+SEND=<addr>,<len>,<data>\r\n
+  char cmd[sizeof(payload) + 24];
+  int cmdLen = snprintf(cmd, sizeof(cmd),
+                        "AT+SEND=%d,%d,%s\r\n",
+                        LORA_ADDR,
+                        payloadLen,
+                        payload);
+
+  // 바로 write하면 64B UART 버퍼가 빌 때까지 루프가 멈춤 -> 큐에 넣고 serviceLoraTx가 나눠 보냄
+  loraTxEnqueue(g_loraTx, cmd, (uint8_t)cmdLen, millis());
+  serviceLoraTx();
+}
 
-  // roll/pitch/yaw: deg * 100 -> int16
-  push16_be_i(buf, idx, clamp_i16(iround(f.roll  * 100.0f)));
-  push16_be_i(buf, idx, clamp_i16(iround(f.pitch * 100.0f)));
-  push16_be_i(buf, idx, clamp_i16(iround(f.yaw   * 100.0f)));
+void serviceLoraTx() {
+  loraTxService(g_loraTx, LORA_PORT, millis());
+}
 
-  // lat/lon: int32 E7 그대로
+// ======================= 핵심: FlightData -> LoRa 송신 =======================
+// 묶음 헤더 채워서 송신 (lat/lon/temp/connect/기압/속도는 지금 값)
+static void loraSendBatch(uint8_t* buf, uint8_t n, uint16_t sampleMs, uint32_t t0,
+                          const FlightData& f, uint8_t connect) {
+  // 필드마다 loraPacket.h 오프셋에 (지상국 디코더와 같은 표)
+  int idx;
+  buf[0] = LORA_SYNC_BATCH;
+  buf[LORA_BATCH_OFS_N] = n;
+  buf[LORA_BATCH_OFS_DT] = (uint8_t)(sampleMs / 10);
+  idx = LORA_BATCH_OFS_T0;
+  push32_be(buf, idx, (int32_t)t0);
+  idx = LORA_BATCH_OFS_LAT;
   push32_be(buf, idx, f.gps.latitudeE7);
+  idx = LORA_BATCH_OFS_LON;
   push32_be(buf, idx, f.gps.longitudeE7);
+  idx = LORA_BATCH_OFS_TEMP;
+  push16_be_i(buf, idx, clamp_i16(iround(f.baro.temperature * 100.0f)));
+  buf[LORA_BATCH_OFS_CONNECT] = connect;
+  idx = LORA_BATCH_OFS_PRESS;
+  push16_be(buf, idx, clamp_u16(iround(f.baro.pressure * 10.0f)));  // 0.1hPa
+  idx = LORA_BATCH_OFS_SPEED;
+  push16_be(buf, idx, clamp_u16(iround(f.gps.speed * 100.0f)));     // cm/s
+  buf[LORA_BATCH_OFS_ACK] = g_loraAckId;
+  loraSendPayload(buf, LORA_BATCH_HDR_LEN + n * LORA_BATCH_SAMPLE_LEN);
+}
 
-  // alt: m * 10 -> uint16 (0.1m)
-  push16_be(buf, idx, clamp_u16(iround(f.baro.altitude * 100.0f)));
+// 착지 후: 자세/기압 없이 위치만
+static void loraSendPos(const FlightData& f, bool parachuteDeployed, uint8_t connect) {
+  uint8_t buf[LORA_POS_LEN];
+  int idx;
+  buf[0] = LORA_SYNC_POS;
+  idx = LORA_POS_OFS_T;
+  push32_be(buf, idx, (int32_t)millis());
+  idx = LORA_POS_OFS_LAT;
+  push32_be(buf, idx, f.gps.latitudeE7);
+  idx = LORA_POS_OFS_LON;
+  push32_be(buf, idx, f.gps.longitudeE7);
+  idx = LORA_POS_OFS_ALT;
+  push16_be_i(buf, idx, clamp_i16(iround(f.gps.altitude)));
+  buf[LORA_POS_OFS_SATS] = f.gps.sats;
+  buf[LORA_POS_OFS_FIX] = f.gps.fix ? 1 : 0;
+  buf[LORA_POS_OFS_CONNECT] = connect;
+  buf[LORA_POS_OFS_PHASE] = packPhaseChute((uint8_t)f.state, parachuteDeployed);
+  buf[LORA_POS_OFS_ACK] = g_loraAckId;
+  loraSendPayload(buf, LORA_POS_LEN);
+}
 
-  // temp: C * 100 -> int16
-  push16_be_i(buf, idx, clamp_i16(iround(f.baro.temperature * 100.0f)));
+void sendLoraFromFlight(const FlightData& f, bool parachuteDeployed, uint8_t connect = 0) {
+  // 태스크 테이블이 LORA_PERIOD_MS마다 부름. 샘플 간격/묶음 크기/내용은 단계별 표(LORA_RATES)
+  static uint8_t buf[LORA_MAX_RAW];
+  static uint8_t n = 0;
+  static uint32_t t0 = 0;
+  static uint16_t batchMs = 0;     // 모으는 중인 묶음의 샘플 간격
+  static uint32_t nextMs = 0;
+  static uint8_t lastState = STANDBY;
+
+  uint32_t now = millis();
+  uint8_t st = f.state <= LANDED ? (uint8_t)f.state : (uint8_t)LANDED;
+  const LoraRate& rate = LORA_RATES[st];
+
+  // 단계가 바뀌면 모인 것부터 보내고 지금 바로 새 간격으로
+  if (st != lastState) {
+    if (n) loraSendBatch(buf, n, batchMs, t0, f, connect);
+    n = 0;
+    lastState = st;
+    nextMs = now;
+  }
+  if ((int32_t)(now + LORA_PERIOD_MS / 2 - nextMs) < 0) return;  // 태스크 지터 허용
+  nextMs += rate.sampleMs;
+  if ((int32_t)(now - nextMs) >= 0) nextMs = now + rate.sampleMs;  // 오래 밀렸으면 다시 맞춤
 
-  // connect 1byte 연결되면 0, 아니면 1
-  buf[idx++] = connect;
+  if (rate.kind == LORA_KIND_POS) {
+    loraSendPos(f, parachuteDeployed, connect);
+    return;
+  }
 
-  // state + parachute
-  buf[idx++] = packPhaseChute((uint8_t)f.state, parachuteDeployed);
+  // 묶음: 샘플만 쌓다가 N개 차면 헤더 채워서 한 번에
+  if (n == 0) {
+    t0 = now;
+    batchMs = rate.sampleMs;
+  }
+  const int s = LORA_BATCH_HDR_LEN + n * LORA_BATCH_SAMPLE_LEN;
+  int idx = s + LORA_SAMPLE_OFS_ROLL;
+  push16_be_i(buf, idx, clamp_i16(iround(f.roll  * 100.0f)));
+  idx = s + LORA_SAMPLE_OFS_PITCH;
+  push16_be_i(buf, idx, clamp_i16(iround(f.pitch * 100.0f)));
+  idx = s + LORA_SAMPLE_OFS_YAW;
+  push16_be_i(buf, idx, clamp_i16(iround(f.yaw   * 100.0f)));
+  idx = s + LORA_SAMPLE_OFS_ALT;
+  push16_be(buf, idx, clamp_u16(iround(f.baro.altitude * 10.0f)));  // 0.1m
+  buf[s + LORA_SAMPLE_OFS_PHASE] = packPhaseChute((uint8_t)f.state, parachuteDeployed);
+  if (++n < rate.samples) return;
 
-  // base64
-  //String payload = base64Encode(buf, idx);
+  loraSendBatch(buf, n, batchMs, t0, f, connect);
+  n = 0;
+}
 
-  // RYLR998: AT+SEND=<addr>,<len>,<data>\r\n
-  //LORA_PORT.print("AT+SEND=1,1,1");
+// ======================= 업링크 명령 =======================
+//  +RCV data 첫 글자로 표에서 찾음. 뒤 2글자는 명령 id (lora.h)
+LoraLine g_loraLine;
+LoraRxStats g_loraRxSt;
 
-  // LORA_PORT.print("AT+SEND=");
-  // LORA_PORT.print(LORA_ADDR);
-  // LORA_PORT.print(",");
-  // LORA_PORT.print(payload.length());
-  // LORA_PORT.print(",");
-  // LORA_PORT.print(payload);
-  // LORA_PORT.print("\r\n");
+static void loraCmdDeploy(const LoraRcv&) {
+  g_parachuteDeployed = true;
+  deployCtl.state = DEPLOY_PUNCH;
+  //emergencyDeploy();
+  Serial.println("receive EEE");
+}
 
- // Serial.println("send");
+static void loraCmdCenter(const LoraRcv&) {
+  Serial.println("receive CCC");
+}
 
- char payload[64];
-int payloadLen = base64Encode(buf, idx, payload);
+struct LoraCmd {
+  char code;
+  void (*run)(const LoraRcv& r);
+};
+
+static const LoraCmd LORA_CMDS[] = {
+  { 'E', loraCmdDeploy },   // 비상 사출
+  { 'C', loraCmdCenter },   // 중앙 정렬
+};
+
+// data 2~3번째 글자 (16진). 없거나 형식이 틀리면 0
+static uint8_t loraCmdId(const LoraRcv& r) {
+  if (r.len != 3) return 0;
+  char hex[3] = { r.data[1], r.data[2], '\0' };
+  char* end;
+  unsigned long id = strtoul(hex, &end, 16);
+  return (*end == '\0' && id <= 0xFF) ? (uint8_t)id : 0;
+}
 
-char cmd[96];
-int cmdLen = snprintf(cmd, sizeof(cmd),
-                      "AT+SEND=%d,%d,%s\r\n",
-                      LORA_ADDR,
-                      payloadLen,
-                      payload);
+static void loraHandleLine(char* line) {
+  if (loraTxOnReply(g_loraTx, line, millis())) return;  // AT+SEND 응답 +OK/+ERR
+  if (strncmp(line, "+RCV=", 5) != 0) return;
 
-LORA_PORT.write((uint8_t*)cmd, cmdLen);
+  LoraRcv r;
+  if (!loraParseRcv(line, r)) {
+    g_loraRxSt.bad++;
+    return;
+  }
+  g_loraRxSt.rcv++;
+  g_loraRxSt.lastRssi = r.rssi;
+  g_loraRxSt.lastSnr = r.snr;
+  if (r.len == 0) return;
+
+  // arg: 명령 문자 | -RSSI << 8 | SNR << 16 | id << 24 (logRecords.h)
+  uint8_t code = (uint8_t)r.data[0];
+  uint8_t id = loraCmdId(r);
+  uint8_t rssi = (uint8_t)(r.rssi > 0 ? 0 : (r.rssi < -255 ? 255 : -r.rssi));
+  logEvent(EV_LORA_CMD, (uint32_t)code | ((uint32_t)rssi << 8) | ((uint32_t)(uint8_t)r.snr << 16) |
+                          ((uint32_t)id << 24));
+
+  for (uint8_t i = 0; i < sizeof(LORA_CMDS) / sizeof(LORA_CMDS[0]); i++) {
+    if (LORA_CMDS[i].code == (char)code) {
+      if (id != 0 && id == g_loraAckId && (char)code == g_loraAckCode) return;  // 재전송: 이미 실행, ack는 다음 텔레메트리에 그대로
+      if (id != 0) {
+        g_loraAckId = id;
+        g_loraAckCode = (char)code;
+      }
+      LORA_CMDS[i].run(r);
+      return;
+    }
+  }
+  g_loraRxSt.unknown++;
 }
 
-// Serial2(=LORA_PORT)에서 한 줄씩 받아서 +RCV 파싱
+// Serial2(=LORA_PORT)에 와 있는 바이트만 읽음. 줄이 덜 왔으면 다음 루프에 이어서
 void handleLoraRxCommand() {
   while (LORA_PORT.available()) {
-    //Serial.println("Serial2 available!");  // ← 이거 추가
-    String line = LORA_PORT.readStringUntil('\n');
-    //Serial.println(line);
-    line.trim();
-    if (!line.startsWith("+RCV=")) continue;
-    Serial.println("입력받음");
-
-    int p1 = line.indexOf(',');
-    int p2 = line.indexOf(',', p1 + 1);
-    int p3 = line.indexOf(',', p2 + 1);
-    if (p1 < 0 || p2 < 0 || p3 < 0) continue;
-
-    String data = line.substring(p2 + 1, p3);
-
-    if (data == "E") {
-      g_parachuteDeployed = true;
-      deployCtl.state = DEPLOY_PUNCH;
-      //emergencyDeploy();
-      Serial.println("receive EEE");
-    }
-    if (data == "C") {
-Serial.println("receive CCC");
-    }
+    if (loraLineFeed(g_loraLine, (char)LORA_PORT.read())) loraHandleLine(g_loraLine.buf);
   }
 }
 
@@ -0,0 +1,155 @@
+#ifndef LORA_TX_QUEUE_H
+#define LORA_TX_QUEUE_H
+
+// ============================================================================
+// LoRa AT 명령 송신 큐 (헤더 온리)
+//  - AVR UART 송신 버퍼는 64B, 9600bps면 1B에 약 1ms
+//    -> AT+SEND(약 100B)를 write() 한 번에 넣으면 버퍼가 빌 때까지 루프가 수십 ms 멈춤
+//  - loraTxService: availableForWrite()만큼만 써서 여러 루프에 나눠 보냄 (절대 블로킹 안 함)
+//  - 모듈(RYLR998)은 명령마다 +OK 또는 +ERR=n 으로 답함
+//    -> 한 번에 명령 하나만 보내고, 답(loraTxOnReply) 또는 LORA_TX_REPLY_MS 시간 초과 뒤 다음 명령
+//  - 슬롯이 다 차면 가장 최근에 넣은 (아직 안 보낸) 명령을 새 것으로 바꿈 -> dropped
+//    텔레메트리는 새 값이 더 중요하므로 오래된 것을 쌓아두지 않음
+// ============================================================================
+
+#include <Arduino.h>
+#include <string.h>
+
+#ifndef LORA_TXQ_SLOTS
+#define LORA_TXQ_SLOTS 2
+#endif
+#ifndef LORA_TXQ_CMD_MAX
+#define LORA_TXQ_CMD_MAX 128
+#endif
+static const uint32_t LORA_TX_REPLY_MS = 1000;  // +OK/+ERR 대기 한도
+static const uint32_t LORA_TX_DELAY_MS = 20;    // 이보다 오래 기다리면 delayed
+
+struct LoraTxStats {
+  uint32_t queued;     // 넣은 명령
+  uint32_t ok;         // +OK
+  uint32_t failed;     // +ERR
+  uint32_t timeouts;   // 답 없음
+  uint32_t dropped;    // 슬롯이 차서 / 너무 길어서 버림
+  uint32_t delayed;    // 첫 바이트까지 LORA_TX_DELAY_MS 넘게 기다림 (앞 명령 응답 대기 또는 버퍼 부족)
+  uint32_t waitMaxMs;  // 넣은 뒤 첫 바이트를 UART에 넘기기까지 최대 시간
+  uint32_t replyMaxMs; // 마지막 바이트를 넘긴 뒤 답이 오기까지 최대 시간
+  int16_t lastErr;     // 마지막 +ERR 번호
+};
+
+struct LoraTxQueue {
+  char cmd[LORA_TXQ_SLOTS][LORA_TXQ_CMD_MAX];
+  uint8_t len[LORA_TXQ_SLOTS];
+  uint32_t enqMs[LORA_TXQ_SLOTS];
+  uint8_t head;        // 보내는 중(또는 다음에 보낼) 슬롯
+  uint8_t count;
+  uint8_t wp;          // head에서 이미 쓴 바이트
+  bool awaiting;       // head를 다 쓰고 답을 기다리는 중
+  uint32_t sentMs;
+  LoraTxStats st;
+};
+
+static inline void loraTxInit(LoraTxQueue& q) {
+  memset(&q, 0, sizeof(q));
+}
+
+static inline bool loraTxIdle(const LoraTxQueue& q) {
+  return q.count == 0;
+}
+
+static inline void loraTxPop(LoraTxQueue& q) {
+  q.head = (uint8_t)((q.head + 1) % LORA_TXQ_SLOTS);
+  q.count--;
+  q.wp = 0;
+  q.awaiting = false;
+}
+
+// 반환: false = 버림. 슬롯이 차면 마지막 대기 명령을 새 것으로 대체 (dropped)
+static inline bool loraTxEnqueue(LoraTxQueue& q, const char* cmd, uint8_t len, uint32_t nowMs) {
+  if (len == 0 || len > LORA_TXQ_CMD_MAX) {
+    q.st.dropped++;
+    return false;
+  }
+  uint8_t slot;
+  if (q.count < LORA_TXQ_SLOTS) {
+    slot = (uint8_t)((q.head + q.count) % LORA_TXQ_SLOTS);
+    q.count++;
+  } else {
+    slot = (uint8_t)((q.head + q.count - 1) % LORA_TXQ_SLOTS);
+    q.st.dropped++;
+    if (slot == q.head && (q.wp > 0 || q.awaiting)) return false;  // 이미 나가기 시작한 명령은 그대로
+  }
+  memcpy(q.cmd[slot], cmd, len);
+  q.len[slot] = len;
+  q.enqMs[slot] = nowMs;
+  q.st.queued++;
+  return true;
+}
+
+// 매 루프 호출. UART 버퍼에 빈자리만큼만 씀
+static inline void loraTxService(LoraTxQueue& q, Stream& port, uint32_t nowMs) {
+  if (q.awaiting) {
+    if (nowMs - q.sentMs < LORA_TX_REPLY_MS) return;
+    q.st.timeouts++;
+    loraTxPop(q);
+  }
+  if (q.count == 0) return;
+
+  uint8_t left = q.len[q.head] - q.wp;
+  int room = port.availableForWrite();
+  if (room <= 0) return;
+  if (q.wp == 0) {  // 첫 바이트: 넣은 뒤 얼마나 기다렸나
+    uint32_t wait = nowMs - q.enqMs[q.head];
+    if (wait > q.st.waitMaxMs) q.st.waitMaxMs = wait;
+    if (wait > LORA_TX_DELAY_MS) q.st.delayed++;
+  }
+  uint8_t n = (uint16_t)room < left ? (uint8_t)room : left;
+  port.write((const uint8_t*)&q.cmd[q.head][q.wp], n);
+  q.wp += n;
+  if (n < left) return;
+
+  q.awaiting = true;
+  q.sentMs = nowMs;
+}
+
+// 모듈 응답 한 줄 (\r\n 제거된 것). 반환: true = 송신 응답이라 처리함
+static inline bool loraTxOnReply(LoraTxQueue& q, const char* line, uint32_t nowMs) {
+  bool ok = strcmp(line, "+OK") == 0;
+  bool err = strncmp(line, "+ERR=", 5) == 0;
+  if (!ok && !err) return false;
+  if (!q.awaiting) return true;  // 기다린 적 없는 답 (시간 초과 뒤 늦게 온 것)
+  uint32_t dt = nowMs - q.sentMs;
+  if (dt > q.st.replyMaxMs) q.st.replyMaxMs = dt;
+  if (ok) {
+    q.st.ok++;
+  } else {
+    q.st.failed++;
+    q.st.lastErr = (int16_t)atoi(line + 5);
+  }
+  loraTxPop(q);
+  return true;
+}
+
+static inline void loraTxPrintStats(Print& out, const LoraTxQueue& q) {
+  out.print(F("lora tx q="));
+  out.print((unsigned)q.count);
+  out.print(F(" in="));
+  out.print((unsigned long)q.st.queued);
+  out.print(F(" ok="));
+  out.print((unsigned long)q.st.ok);
+  out.print(F(" err="));
+  out.print((unsigned long)q.st.failed);
+  out.print('(');
+  out.print((int)q.st.lastErr);
+  out.print(F(") tmo="));
+  out.print((unsigned long)q.st.timeouts);
+  out.print(F(" drop="));
+  out.print((unsigned long)q.st.dropped);
+  out.print(F(" delay="));
+  out.print((unsigned long)q.st.delayed);
+  out.print(F(" waitMaxMs="));
+  out.print((unsigned long)q.st.waitMaxMs);
+  out.print(F(" replyMaxMs="));
+  out.println((unsigned long)q.st.replyMaxMs);
+}
+
+#endif
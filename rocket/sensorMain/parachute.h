@@ -11,6 +11,19 @@ const uint8_t DEPLOY_ARM_ANGLE = 180;    // 대기 10 180
 const uint8_t DEPLOY_PUNCH_ANGLE = 10;  // 사출 95 10
 const uint8_t DEPLOY_LOCK_ANGLE = 10;   // 유지 95 10
 
+// 판단/상태머신 실행 주기 (isPowered 등 카운터는 이 주기 기준으로 누적)
+const uint32_t FLIGHT_LOGIC_PERIOD_MS = 10;
+
+// 상승/하강 카운트에 칼만 수직속도(flight.est) 사용. false면 기존 baro.climbRate
+const bool USE_EST_VELOCITY = true;
+
+// 최고고도 예측 사출 (관성비행 중 탄도+항력 모델). 카운터 하강 판단은 백업으로 그대로 유지
+const bool USE_APOGEE_PREDICT = true;
+const uint32_t APO_MIN_FLIGHT_MS = 2000;  // T0 이후 이 시간 전에는 예측 사출 안 함
+const float APO_MIN_ALT_M = 30.0f;        // 추정 고도가 이보다 낮으면 예측 사출 안 함
+const float APO_MAX_VEL_SD = 3.0f;        // 추정 속도 표준편차(m/s)가 크면 예측 불신
+const float APO_DRAG_MIN_V = 20.0f;       // 항력계수 추정은 이 속도 이상에서만 (v^2로 나눔)
+
 
 //imu고장 판단
 
@@ -32,6 +45,8 @@ bool isAltitudeUp(const BaroData& baro);
 
 bool isAltitudeDown(const BaroData& baro);
 
+float verticalSpeed();  // 판단용 수직속도 (칼만 추정 또는 climbRate)
+
 bool isPowered(bool accelOver, bool altitudeUp, JudgeCounters& jc);  //카운터 초기화 기능 추가
 
 bool isMotorOver(bool isPoweredNow, JudgeCounters& jc);  //카운터 초기화 추가
@@ -52,6 +67,10 @@ void applyParachuteDeployState();  //상태 실행함수
 // //================업데이트함수==========================//
 
 void updateFlightState(FlightData& flight, bool startFlight, bool powered, bool motorOver, bool apogee, bool descent, JudgeCounters& jc);
+bool updateApogeePredictor();  // 관성비행 중 최고고도 도달 예측 -> 사출 시점이면 true
+void runFlightLogic();  // 발사 감지 ~ 상태머신 ~ 사출 명령 (loop에서 매번 호출)
+struct AltEstimator;
+void flightLogicStep(AltEstimator& est, uint32_t nowMs);  // logic 태스크 한 주기 (sensorMain, 호스트 리플레이 공용)
 const char* getStateName(FlightState state);
 
 
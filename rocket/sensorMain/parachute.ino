@@ -1,4 +1,5 @@
 #include "parachute.h"
+#include "altEstimator.h"
 // //낙하산 코드 시작
 
 // //imu고장 판단
@@ -34,15 +35,22 @@ bool isAccelOver(const ImuData& imu) {  //제곱값 비교로 바꿈
   return magSq >= THRESHOLD_SQ;
 }
 
+// 상승/하강 판단에 쓰는 수직속도
+//  칼만 추정값(flight.est, 초기화 후)이 있으면 그것, 없으면 기압 미분 + LPF (baro.climbRate)
+float verticalSpeed() {
+  if (USE_EST_VELOCITY && flight.est.altVar > 0.0f) return flight.est.velocity;
+  return flight.baro.climbRate;
+}
+
+// 카운트는 새 기압 샘플마다 한 번 (baroTimeMs 변화 기준)
+// 칼만 속도는 logic 주기마다 바뀌므로 값 변화로 세면 카운트 속도가 달라짐
 bool isAltitudeUp(const BaroData& baro) {
   static int countU = 0;
-  static float prevU = 0;
+  static uint32_t lastU = 0;
 
-  if(prevU !=  flight.baro.climbRate && launchTimeStarted) {
-    // Serial.print(flight.baro.climbRate);
-    // Serial.print(" ");
-    // Serial.println(prevU);
-    if(flight.baro.climbRate > 0) //상승 시 카운트 +1
+  if(lastU != flight.baroTimeMs && launchTimeStarted) {
+    float vz = verticalSpeed();
+    if(vz > 0) //상승 시 카운트 +1
       {countU++;
       //Serial.println(countU);
       }
@@ -50,7 +58,7 @@ bool isAltitudeUp(const BaroData& baro) {
       if(countU > 0) //하락중이면 count가 0이상일 때만 count 1 감소
       countU-=1;
     }
-    prevU = flight.baro.climbRate;
+    lastU = flight.baroTimeMs;
     }
   if(countU > 10)
   return true;
@@ -59,17 +67,17 @@ bool isAltitudeUp(const BaroData& baro) {
 }
 
 bool isAltitudeDown(const BaroData& baro) {
-  static float prevD = 0.0f;
+  static uint32_t lastD = 0;
   static int countD = 0;
 
-  if(prevD !=  flight.baro.climbRate && launchTimeStarted) {
-    if(flight.baro.climbRate < 0) //하강 시 카운트 +1
+  if(lastD != flight.baroTimeMs && launchTimeStarted) {
+    if(verticalSpeed() < 0) //하강 시 카운트 +1
       countD++;
     else{
       if(countD > 0) //하락중이면 count가 0이상일 때만 count 1 감소
       countD-=1;
     }
-    prevD = flight.baro.climbRate;
+    lastD = flight.baroTimeMs;
     }
   if(countD > 20)
   return true;
@@ -222,6 +230,164 @@ void updateFlightState(FlightData& flight, bool startFlight, bool powered, bool
   }
 }
 
+//================최고고도 예측==========================//
+// 관성비행 운동방정식 dv/dt = -g - k v^2 (상승 중)
+//  최고고도까지 남은 시간 t = atan(v sqrt(k/g)) / sqrt(k g)   (k -> 0 이면 v/g)
+//  k는 축방향 가속도계가 느끼는 비력(= 항력 감속)으로 추정: k = -a / v^2
+//  가속도가 없으면 k = 0 (항력 무시 -> 실제보다 늦게 예측, 안전한 쪽)
+// 예측 시각은 flight.apo.predMs 로 로그에 남김
+bool updateApogeePredictor()
+{
+  static float dragK = 0.0f;
+  static bool haveK = false;
+
+  if (!launchTimeStarted || flight.state < COASTING || flight.state >= DESCENT) return false;
+  if (flight.est.altVar <= 0.0f) return false;
+
+  uint32_t now = millis();
+  float v = flight.est.velocity;
+
+  bool haveAcc = !isOMGimu(flight.imu) && flight.aRxTimeMs != 0 && (now - flight.aRxTimeMs) < ALT_EST_ACC_TIMEOUT_MS;
+  if (haveAcc && v > APO_DRAG_MIN_V) {
+    float aDrag = flight.imu.az * ALT_EST_ACC_SCALE;  // 관성비행 중에는 항력만 느낌 (음수)
+    float k = (aDrag < 0.0f) ? -aDrag / (v * v) : 0.0f;
+    dragK = haveK ? dragK + 0.2f * (k - dragK) : k;  // 진동 잡음 LPF (첫 값은 그대로)
+    haveK = true;
+  }
+
+  float tApo = 0.0f;
+  if (v > 0.0f) {
+    float kg = dragK * ALT_EST_G;
+    if (kg > 1e-6f) tApo = atanf(v * sqrtf(dragK / ALT_EST_G)) / sqrtf(kg);
+    else tApo = v / ALT_EST_G;
+    flight.apo.predMs = now + (uint32_t)(tApo * 1000.0f);  // 최고고도 지나면 마지막 예측 유지
+  }
+
+  // 다음 판단 주기 안에 최고고도 -> 사출 시점
+  if (tApo * 1000.0f > FLIGHT_LOGIC_PERIOD_MS) return false;
+  if (now - launchTimeMs < APO_MIN_FLIGHT_MS) return false;
+  if (flight.est.altitude < APO_MIN_ALT_M) return false;
+  if (flight.est.velVar > APO_MAX_VEL_SD * APO_MAX_VEL_SD) return false;
+  return true;
+}
+
+//================logic 태스크 한 주기==========================//
+// 커넥트핀 -> 고도/수직속도 추정 -> 판단/전이 -> 사출 서보 FSM
+// sensorMain taskLogic과 호스트 리플레이가 둘 다 이 함수만 부름 (순서를 바꾸면 리플레이도 같이 바뀜)
+void flightLogicStep(AltEstimator& est, uint32_t nowMs)
+{
+  if (!pinDetached) {
+    pinDetached = isConnectOrDeteached(PIN_CONNECT_DETECT);
+  }
+  altEstStep(est, flight, nowMs, !isOMGbaro(flight.baro), !isOMGimu(flight.imu));  // 판단 전에 갱신
+  runFlightLogic();             // 판단 및 상태 전이
+  applyParachuteDeployState();  // 낙하산 서보 FSM
+}
+
+//================판단 + 상태 전이 + 사출 명령==========================//
+// loop()에서 센서 갱신 후 매번 호출. 호스트 리플레이(host/replay)도 이 함수를 그대로 돌림
+void runFlightLogic()
+{
+  // ==============시간 측정 시작(커넥트핀 분리 && imu 가속도값)==========
+  if (!launchTimeStarted && pinDetached 
+      && ((flight.imu.ax) * (flight.imu.ax) +
+         (flight.imu.ay) * (flight.imu.ay) + 
+         (flight.imu.az) * (flight.imu.az) >  
+         (9.8 * 1.2) * (9.8 * 1.2))) { //이거 나중에 수정해야 함
+    launchTimeStarted = true;
+    launchTimeMs = millis();  // T0
+    Serial.println("발사 시간 측정!");
+  }
+
+  // ========================센서 이상치 판단==========
+
+  bool imuOMG = isOMGimu(flight.imu);
+  bool baroOMG = isOMGbaro(flight.baro);
+
+  // 2) ⛔ 센서 고장 시 APOGEE 강제 전이 (여기!)
+  if ((imuOMG || baroOMG) && flight.state < APOGEE) {
+    flight.state = APOGEE;
+    Serial.println("센서 고장");
+
+    // 중요: 하강 판단 누적값 리셋(권장)
+    resetDecisionCounters(jc);
+  }
+
+  //================== 기본 판단 신호====================
+
+  bool accelOver = (!imuOMG) && isAccelOver(flight.imu);
+
+  bool altitudeUp = (!baroOMG) && isAltitudeUp(flight.baro);      // 상승 증거
+  bool altitudeDown = (!baroOMG) && isAltitudeDown(flight.baro);  // 하강 증거
+  bool powered = isPowered(accelOver, altitudeUp, jc);
+  bool motorOver = isMotorOver(powered, jc);
+  bool apogee = (flight.state < APOGEE) && altitudeUp;
+  bool descent = (flight.state == APOGEE) && altitudeDown;
+  // ========================
+
+  // 4) 상태머신 갱신
+
+  updateFlightState(
+    flight,
+    launchTimeStarted,
+    powered,
+    motorOver,
+    apogee,
+    descent,
+    jc);
+
+  /*===================== 낙하산 사출 함수=================
+      1. 발사 10초 뒤 낙하산 사출
+      2. 하강 30회 시 낙하산 사출(데이터 중복 가능성)
+      3. 예측 최고고도 도달 시 사출 (updateApogeePredictor, 1~2는 백업)
+      =================================================*/
+
+  if (descent && flight.apo.detectMs == 0) flight.apo.detectMs = millis();  // 예측 대비 지연 기록용
+  bool apogeeNow = USE_APOGEE_PREDICT && updateApogeePredictor();
+
+  if (launchTimeStarted && !deployCtl.deployed) {
+    bool isCount = false;
+    unsigned long flightTimeMs = millis() - launchTimeMs;
+
+    if (flightTimeMs >= 1000000 && !g_parachuteDeployed) {  // 1,000ms = 10초
+      Serial.println("낙하산 사출! - 10초 조건");
+      deployCtl.state = DEPLOY_PUNCH;
+      g_parachuteDeployed = true;
+    }
+
+    if (apogeeNow && !g_parachuteDeployed) {  // 예측 최고고도 (1순위)
+      deployCtl.state = DEPLOY_PUNCH;
+      g_parachuteDeployed = true;
+      flight.apo.armMs = millis();
+      Serial.print("낙하산 사출! - 예측 최고고도 h=");
+      Serial.println(flight.est.altitude, 1);
+    }
+
+    if(descent)  // 카운터 하강 판단 (백업)
+    {
+      deployCtl.state = DEPLOY_PUNCH;
+      g_parachuteDeployed = true;
+      Serial.println("낙하산 사출! - 고도 하강");
+    }
+    // if(prevClimbRate !=  flight.baro.climbRate) {
+    // if(flight.baro.climbRate < -2) //하강 시 카운트 +1
+    //   jc.count++;
+    // else{
+    //   if(jc.count > 0) //상승중이면 count가 0이상일 때만 count 1 감소
+    //   jc.count--;
+    // }
+    // prevClimbRate = flight.baro.climbRate;
+    // }
+
+    // if(jc.count > 20 && !g_parachuteDeployed ){ //낙하산 사출
+    //   deployCtl.state = DEPLOY_PUNCH;
+    //   g_parachuteDeployed = true;
+    //   Serial.println("낙하산 사출! - 고도 하강");
+    //   }
+
+  }
+}
+
 const char* getStateName(FlightState state) {
   switch (state) {
     case STANDBY: return "STANDBY";
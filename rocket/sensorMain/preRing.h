@@ -0,0 +1,93 @@
+#ifndef PRE_RING_H
+#define PRE_RING_H
+
+// ============================================================================
+// 발사 전 RAM 링 버퍼 (헤더 온리, 보드/호스트 공용)
+//  - 종류별 로그 레코드(logRecords.h, 프레임 전)를 [길이 1B][레코드] 로 이어서 보관
+//  - 대기 중(preRingPush)  : 자리가 없으면 가장 오래된 레코드부터 지움 -> 항상 최근 구간만 남음
+//    발사 후(preRingAppend): 오래된 것은 지우지 않고, 자리가 없으면 새 레코드를 버림 (dropped)
+//  - 꺼낼 때(preRingPop)는 넣은 순서 그대로
+//  - 크기는 PRE_RING_BYTES (Mega RAM 8KB 중 2KB). 100Hz IMU + 기압 기준 약 0.57초
+//    3KB였을 때 정적 RAM이 8KB에 거의 닿아 스택 여유가 없었음 -> 디버그 출력 stack margin=으로 확인하며 조정
+// ============================================================================
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef PRE_RING_BYTES
+#define PRE_RING_BYTES 2048
+#endif
+
+struct PreRing {
+  uint8_t buf[PRE_RING_BYTES];
+  uint16_t head;      // 다음에 쓸 위치
+  uint16_t tail;      // 가장 오래된 레코드
+  uint16_t used;
+  uint32_t evicted;   // 대기 중에 밀려난 레코드 (정상)
+  uint32_t dropped;   // 발사 후 링이 차서 버린 레코드
+};
+
+static inline void preRingInit(PreRing& r) {
+  memset(&r, 0, sizeof(r));
+}
+
+static inline bool preRingEmpty(const PreRing& r) {
+  return r.used == 0;
+}
+
+static inline uint8_t preRingFrontLen(const PreRing& r) {
+  return r.buf[r.tail];
+}
+
+static inline void preRingCopyIn(PreRing& r, const uint8_t* p, uint16_t n) {
+  uint16_t first = PRE_RING_BYTES - r.head;
+  if (first > n) first = n;
+  memcpy(&r.buf[r.head], p, first);
+  memcpy(&r.buf[0], p + first, n - first);
+  r.head = (uint16_t)((r.head + n) % PRE_RING_BYTES);
+  r.used += n;
+}
+
+static inline void preRingSkip(PreRing& r, uint16_t n) {
+  r.tail = (uint16_t)((r.tail + n) % PRE_RING_BYTES);
+  r.used -= n;
+}
+
+static inline void preRingPut(PreRing& r, const uint8_t* rec, uint8_t len) {
+  preRingCopyIn(r, &len, 1);
+  preRingCopyIn(r, rec, len);
+}
+
+// 대기 중: 가장 오래된 것부터 밀어냄
+static inline void preRingPush(PreRing& r, const uint8_t* rec, uint8_t len) {
+  if ((uint16_t)len + 1 > PRE_RING_BYTES) return;
+  while (PRE_RING_BYTES - r.used < (uint16_t)len + 1) {
+    preRingSkip(r, (uint16_t)1 + preRingFrontLen(r));
+    r.evicted++;
+  }
+  preRingPut(r, rec, len);
+}
+
+// 발사 후 내보내는 중: 남은 레코드는 지키고 새 것을 버림
+static inline bool preRingAppend(PreRing& r, const uint8_t* rec, uint8_t len) {
+  if (PRE_RING_BYTES - r.used < (uint16_t)len + 1) {
+    r.dropped++;
+    return false;
+  }
+  preRingPut(r, rec, len);
+  return true;
+}
+
+// out은 preRingFrontLen() 이상. 반환: 레코드 길이
+static inline uint8_t preRingPop(PreRing& r, uint8_t* out) {
+  uint8_t len = preRingFrontLen(r);
+  preRingSkip(r, 1);
+  uint16_t first = PRE_RING_BYTES - r.tail;
+  if (first > len) first = len;
+  memcpy(out, &r.buf[r.tail], first);
+  memcpy(out + first, &r.buf[0], len - first);
+  preRingSkip(r, len);
+  return len;
+}
+
+#endif
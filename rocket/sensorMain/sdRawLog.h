@@ -0,0 +1,169 @@
+#ifndef SD_RAW_LOG_H
+#define SD_RAW_LOG_H
+
+// ============================================================================
+// 연속 할당 파일 + 512B 핑퐁 버퍼 SD 로거 (헤더 온리)
+//  - 부팅 때 SdFile::createContiguous()로 FL####.BIN을 미리 크게 만들고 블록 범위만 기억
+//    -> 비행 중에는 Sd2Card::writeBlock()으로 블록 번호에 직접 씀 (FAT/디렉터리 접근 없음)
+//  - 버퍼 2개: 하나를 채우는 동안 다른 하나를 카드로 보냄. 항상 512B 정렬된 한 섹터씩
+//    writeBlock(..., blocking=0) : 전송만 하고 리턴, 카드 프로그래밍(busy)은 기다리지 않음
+//    카드가 busy면 다음 호출로 미룸 (sdRawService)
+//  - 두 버퍼가 모두 차 있으면 새 레코드는 버림 (루프를 멈추지 않음) -> dropped로 셈
+//  - 레코드는 섹터 경계를 넘어 연속으로 채움 (파일 내용 = 기존 RLG1 스트림과 동일)
+//    미리 할당한 뒤쪽은 erase 상태(0x00 또는 0xFF) -> 디코더는 전부 0/FF인 레코드에서 멈춤
+//  - sdRawFlush : 채우는 중인 버퍼를 0으로 채워 같은 블록에 미리 써둠 (전원 끊김 대비)
+//                 nextBlock은 그대로라 다 차면 같은 블록을 다시 씀
+// ============================================================================
+
+#include <Arduino.h>
+#include <SD.h>
+#include <loopProfiler.h>
+
+static const uint16_t SD_RAW_BLOCK = 512;
+
+struct SdRawStats {
+  uint32_t blocks;      // 쓴 섹터 수
+  uint32_t flushes;     // 부분 섹터 미리 쓰기
+  uint32_t busyDefer;   // 카드 busy로 미룬 횟수
+  uint32_t dropped;     // 버퍼가 모두 차서 버린 레코드
+  uint32_t errors;      // writeBlock 실패
+  uint32_t pendMaxUs;   // 버퍼가 찬 뒤 카드로 넘어가기까지 최대 시간
+  ProfHist wr;          // writeBlock 호출 시간 분포
+};
+
+struct SdRawLog {
+  Sd2Card* card;
+  uint32_t bgnBlock, endBlock;  // 파일이 차지하는 블록 (포함)
+  uint32_t nextBlock;           // 다음에 쓸 블록
+  uint8_t buf[2][SD_RAW_BLOCK];
+  uint8_t fillIdx;              // 채우는 중인 버퍼
+  uint16_t wp;
+  bool pending;                 // buf[fillIdx ^ 1]이 카드로 갈 차례
+  uint32_t pendSinceUs;
+  bool full;                    // 할당한 범위를 다 씀
+  SdRawStats st;
+};
+
+// 파일 생성 + 범위 지우기. 실패하면 크기를 반씩 줄여서 다시 시도
+static inline bool sdRawCreate(SdRawLog& lg, Sd2Card& card, SdFile& root, const char* name,
+                               uint32_t bytes, uint32_t minBytes) {
+  memset(&lg, 0, sizeof(lg));
+  lg.card = &card;
+
+  SdFile f;
+  while (!f.createContiguous(&root, name, bytes)) {
+    bytes /= 2;
+    if (bytes < minBytes) return false;
+  }
+  bool ok = f.contiguousRange(&lg.bgnBlock, &lg.endBlock);
+  f.close();  // 디렉터리 엔트리는 여기서 확정 (크기 = 할당 크기)
+  if (!ok) return false;
+
+  card.erase(lg.bgnBlock, lg.endBlock);  // 실패해도 진행 (미리 지우면 쓰기 지연이 줄어듦)
+  lg.nextBlock = lg.bgnBlock;
+  return true;
+}
+
+static inline uint32_t sdRawCapacityBytes(const SdRawLog& lg) {
+  return (lg.endBlock - lg.bgnBlock + 1) * (uint32_t)SD_RAW_BLOCK;
+}
+
+static inline uint32_t sdRawUsedBytes(const SdRawLog& lg) {
+  return (lg.nextBlock - lg.bgnBlock) * (uint32_t)SD_RAW_BLOCK + lg.wp;
+}
+
+// 대기 중인 버퍼를 카드로. 카드가 busy면 다음으로 미룸
+static inline void sdRawService(SdRawLog& lg) {
+  if (!lg.pending) return;
+  if (lg.card->isBusy()) {
+    lg.st.busyDefer++;
+    return;
+  }
+  uint32_t t0 = micros();
+  bool ok = lg.card->writeBlock(lg.nextBlock, lg.buf[lg.fillIdx ^ 1], 0);
+  uint32_t t1 = micros();
+  profAdd(lg.st.wr, t1 - t0);
+  if (t1 - lg.pendSinceUs > lg.st.pendMaxUs) lg.st.pendMaxUs = t1 - lg.pendSinceUs;
+
+  lg.pending = false;
+  if (!ok) {
+    lg.st.errors++;  // 이 섹터는 잃고 다음 블록으로
+  } else {
+    lg.st.blocks++;
+  }
+  if (++lg.nextBlock > lg.endBlock) lg.full = true;
+}
+
+// sdRawWrite가 len을 버리지 않고 받을지 (발사 전 링 내보낼 때 확인용)
+static inline bool sdRawCanWrite(const SdRawLog& lg, uint16_t len) {
+  if (lg.full || len > SD_RAW_BLOCK) return false;
+  return !(lg.wp + len >= SD_RAW_BLOCK && lg.pending);
+}
+
+// 반환: false = 레코드를 버림 (통째로, 일부만 들어가는 경우 없음)
+static inline bool sdRawWrite(SdRawLog& lg, const void* data, uint16_t len) {
+  sdRawService(lg);
+  if (lg.full || len > SD_RAW_BLOCK) {
+    lg.st.dropped++;
+    return false;
+  }
+  // 이번 레코드로 버퍼가 넘치는데 다른 버퍼가 아직 카드로 못 갔으면 버림
+  if (lg.wp + len >= SD_RAW_BLOCK && lg.pending) {
+    lg.st.dropped++;
+    return false;
+  }
+
+  const uint8_t* p = (const uint8_t*)data;
+  uint16_t n = SD_RAW_BLOCK - lg.wp;
+  if (n > len) n = len;
+  memcpy(&lg.buf[lg.fillIdx][lg.wp], p, n);
+  lg.wp += n;
+
+  if (lg.wp == SD_RAW_BLOCK) {  // 한 섹터 완성 -> 대기열로, 다른 버퍼로 전환
+    lg.pending = true;
+    lg.pendSinceUs = micros();
+    lg.fillIdx ^= 1;
+    lg.wp = len - n;
+    memcpy(lg.buf[lg.fillIdx], p + n, lg.wp);
+    sdRawService(lg);
+  }
+  return true;
+}
+
+// 채우는 중인 섹터를 0으로 채워 미리 기록 (블록 번호는 그대로)
+// 대기 중인 섹터가 먼저 나가야 하므로 그게 남아 있으면 이번엔 건너뜀
+static inline void sdRawFlush(SdRawLog& lg) {
+  sdRawService(lg);
+  if (lg.pending || lg.full || lg.wp == 0) return;
+  if (lg.card->isBusy()) {
+    lg.st.busyDefer++;
+    return;
+  }
+  memset(&lg.buf[lg.fillIdx][lg.wp], 0, SD_RAW_BLOCK - lg.wp);
+  uint32_t t0 = micros();
+  bool ok = lg.card->writeBlock(lg.nextBlock, lg.buf[lg.fillIdx], 0);
+  profAdd(lg.st.wr, micros() - t0);
+  if (ok) lg.st.flushes++;
+  else lg.st.errors++;
+}
+
+static inline void sdRawPrintStats(Print& out, const SdRawLog& lg) {
+  out.print(F("sd blk="));
+  out.print((unsigned long)(lg.nextBlock - lg.bgnBlock));
+  out.print('/');
+  out.print((unsigned long)(lg.endBlock - lg.bgnBlock + 1));
+  out.print(F(" flush="));
+  out.print((unsigned long)lg.st.flushes);
+  out.print(F(" busy="));
+  out.print((unsigned long)lg.st.busyDefer);
+  out.print(F(" drop="));
+  out.print((unsigned long)lg.st.dropped);
+  out.print(F(" err="));
+  out.print((unsigned long)lg.st.errors);
+  out.print(F(" pendMaxUs="));
+  out.print((unsigned long)lg.st.pendMaxUs);
+  out.print(F(" wrMaxUs="));
+  out.println((unsigned long)lg.st.wr.maxUs);
+}
+
+#endif
@@ -9,6 +9,17 @@
 #include "lora.h"
 #include "parachute.h"
 #include "flightType.h"
+#include "altEstimator.h"
+#include "sdRawLog.h"
+#include "logCodec.h"
+#include "logRecords.h"
+#include "logFrame.h"
+#include "preRing.h"
+#include "stackMargin.h"
+#include <linkProtocol.h>
+#include <taskScheduler.h>
+#include <bmp280Burst.h>
+#include <baroAltitude.h>
 
 
 #define PIN_CONNECT_DETECT 2
@@ -16,9 +27,23 @@
 
 static const int SD_CS_PIN = 10;
 const int EEPROM_ADDR_IDX = 0;          // EEPROM에 uint16_t 인덱스 저장 주소
-const uint32_t LOG_PERIOD_MS = 100;      // 20Hz
-const uint32_t FLUSH_PERIOD_MS = 10000;  // 1초
+const uint32_t LOG_PERIOD_MS = 10;       // 100Hz
+const uint32_t FLUSH_PERIOD_MS = 1000;   // 1초 (연속 파일: 부분 섹터 한 블록만 씀)
+const uint32_t FAT_FLUSH_PERIOD_MS = 10000;  // File 경로(연속 파일 실패 시): flush마다 FAT/디렉터리 갱신이라 예전 10초
+const uint32_t PROF_PERIOD_MS = 10000;   // 프로파일 CSV 기록 주기
+// 로그 포맷 (LogHeader.version)
+//  1: FlightData 그대로 LOG_PERIOD_MS마다
+//  2: 1과 같은 스냅샷을 델타/varint 압축 (logCodec.h)
+//  3: 종류별 레코드, 값이 새로 생길 때만 (logRecords.h) - IMU는 A2B 프레임마다, 기압/GPS는 갱신 시
+//  4: 3과 같은 레코드를 SYNC/SEQ/CRC16 프레임으로 감쌈 (logFrame.h) - 깨진 섹터 뒤에서 다시 맞춤
+#ifndef LOG_FORMAT
+#define LOG_FORMAT 4
+#endif
+const uint16_t LOG_KEYFRAME_EVERY = 100;   // v2: 1초마다 키프레임 (잘린 곳에서 최대 1초 손실)
+const uint32_t LOG_STATUS_PERIOD_MS = 20;  // v3/v4: 상태/칼만 추정 레코드 50Hz
+const uint32_t LOG_HEARTBEAT_MS = 1000;    // v3/v4 발사 전: SD에는 이 주기로 상태/기압/GPS만
 File logFile;
+File profFile;  // 루프 프로파일 CSV (PF####.CSV, 로그 파일과 같은 번호)
 
 JudgeCounters jc;
 float prevClimbRate = 0;
@@ -38,15 +63,78 @@ static uint32_t b2aBurstStartMs = 0;
 static uint32_t b2aLastSendMs = 0;
 
 FlightData flight;
+#if LOG_FORMAT == 2
+LogEncoder g_logEnc;    // 압축 로그 상태 (logCodec.h)
+#endif
+
+// ====== 종류별 로그 레코드 (LOG_FORMAT 3, 4) ======
+bool sdLogWrite(const void* data, uint16_t len);  // 아래 SD 로그 백엔드
+bool sdLogCanWrite(uint16_t len);
+uint16_t g_logSeq = 0;  // v4 프레임 번호 (버려진 레코드도 하나씩 씀)
+
+// 발사 전 링 (preRing.h)
+//  PRE  : 고속 레코드(IMU/기압/GPS)는 링에만, SD에는 LOG_HEARTBEAT_MS마다 상태/기압/GPS + 이벤트
+//  DRAIN: 발사 감지 -> 링을 SD로 내보내는 중. 새 레코드도 링 뒤에 붙여 순서 유지
+//  LIVE : 전부 바로 SD
+enum LogMode : uint8_t { LOG_PRE, LOG_DRAIN, LOG_LIVE };
+LogMode g_logMode = LOG_PRE;
+PreRing g_preRing;
+
+// 레코드는 frame + LF_HEAD에 인코딩된 상태
+static void logFrameWrite(uint8_t* frame, uint8_t recLen) {
+#if LOG_FORMAT == 4
+  sdLogWrite(frame, lfWrap(frame, g_logSeq++, recLen));
+#else
+  sdLogWrite(frame + LF_HEAD, recLen);
+#endif
+}
+
+// 링에 쌓인 레코드를 SD가 받는 만큼 내보냄 (다 비면 LIVE)
+static void logDrainRing() {
+  uint8_t frame[LF_MAX_FRAME];
+  while (!preRingEmpty(g_preRing)) {
+    if (!sdLogCanWrite((uint16_t)LF_OVERHEAD + preRingFrontLen(g_preRing))) return;
+    logFrameWrite(frame, preRingPop(g_preRing, frame + LF_HEAD));
+  }
+  g_logMode = LOG_LIVE;
+}
+
+// direct: 발사 전에도 SD로 바로 (하트비트, 이벤트)
+static void logRecord(uint8_t* frame, uint8_t recLen, bool direct) {
+  if (g_logMode == LOG_LIVE || (g_logMode == LOG_PRE && direct)) {
+    logFrameWrite(frame, recLen);
+  } else if (g_logMode == LOG_PRE) {
+    preRingPush(g_preRing, frame + LF_HEAD, recLen);
+  } else {
+    preRingAppend(g_preRing, frame + LF_HEAD, recLen);
+    logDrainRing();
+  }
+}
+
+static void logTyped(uint8_t (*encode)(uint8_t*, const FlightData&), const FlightData& f, bool direct = false) {
+#if LOG_FORMAT >= 3
+  uint8_t frame[LF_MAX_FRAME];
+  logRecord(frame, encode(frame + LF_HEAD, f), direct);
+#endif
+}
+
+void logEvent(uint8_t code, uint32_t arg) {
+#if LOG_FORMAT >= 3
+  uint8_t frame[LF_MAX_FRAME];
+  logRecord(frame, lrEncodeEvent(frame + LF_HEAD, millis(), code, arg), true);
+#endif
+}
+AltEstimator g_altEst;  // 기압 + 가속도 칼만 (altEstimator.h) -> flight.est
 // 1) BMP280
 // ============================================================================
-Adafruit_BMP280 bmp;
+Adafruit_BMP280 bmp;    // 칩 설정(begin/setSampling)만 사용
+Bmp280Burst g_bmpRd;    // 측정값 읽기: 6바이트 버스트 + 정수 보상 (bmp280Burst.h)
 
-static const uint32_t BARO_PERIOD_MS = 50;  // 20Hz
-static uint32_t g_baro_lastMs = 0;          // 마지막으로 updateBaro()가 실제로 센서를 읽은 시간을 저장하는 변수.
+static const uint32_t BARO_PERIOD_MS = 50;  // 20Hz (태스크 테이블 주기)
 
 // 상대고도 기준압 p0 (발사대에서 평균낸 압력)
 static float g_p0_hPa = 1013.25f;  // 기준 압력 p0
+static BaroAltRef g_altRef = baroAltRef(1013.25f);  // p0에 묶인 고도식 상수 (baroAltitude.h)
 
 // climbRate 계산
 static float g_alt_prev = 0.0f;         // 직전고도값
@@ -63,22 +151,25 @@ bool launchTimeStarted = false;  // 시간 시작 여부
 unsigned long launchTimeMs = 0;  // T0 (발사 시작 시각)
 
 // 표준대기 근사식: p0를 발사대 압력으로 잡으면 상대고도
-static float altitudeFromPressure(float p_hPa, float p0_hPa) {
-  if (p_hPa <= 0.0f || p0_hPa <= 0.0f) return 0.0f;          // 0이하값은 0으로
-  return 43561.54f * (1.0f - powf(p_hPa / p0_hPa, 0.1903f));  // 표준대기근사식으로 고도계산
+//  43561.54 * (1 - (p/p0)^0.1903) 를 표 보간으로 계산 (powf 없음, 300~1100hPa 오차 0.06m 이하)
+static float altitudeFromPressure(float p_hPa) {
+  if (p_hPa <= 0.0f || g_altRef.p0_hPa <= 0.0f) return 0.0f;  // 0이하값은 0으로
+  return baroAltitude(g_altRef, p_hPa);
 }
 
 bool initBaro() {
-  if (!bmp.begin(0x76)) {
-    if (!bmp.begin(0x77)) return false;
+  uint8_t addr = 0x76;
+  if (!bmp.begin(addr)) {
+    addr = 0x77;
+    if (!bmp.begin(addr)) return false;
   }
-  bmp.setSampling(  // BMP280 내부 설정값
+  bmp.setSampling(  // BMP280 내부 설정값 -> 측정 주기 약 100ms (37.5ms 변환 + 62.5ms standby)
     Adafruit_BMP280::MODE_NORMAL,
     Adafruit_BMP280::SAMPLING_X2,
     Adafruit_BMP280::SAMPLING_X16,
     Adafruit_BMP280::FILTER_X16,
     Adafruit_BMP280::STANDBY_MS_63);
-  return true;
+  return bmp280BurstInit(g_bmpRd, Wire, addr);  // 보정계수 캐시
 }
 
 // 부팅 직후 몇 초간 압력 평균, g_p0_hPa 설정 (상대고도 0 기준)
@@ -88,7 +179,11 @@ void calibrateBaroP0(uint32_t calibMs = 3000) {
   double sum = 0;          // 압력 합
 
   while (millis() - t0 < calibMs) {
-    float p = bmp.readPressure() / 100.0f;  // Pa를 hPa로
+    if (bmp280BurstRead(g_bmpRd, millis()) != BMP280_NEW) {  // 같은 샘플을 여러 번 더하지 않음
+      delay(20);
+      continue;
+    }
+    float p = g_bmpRd.press_q8 / 25600.0f;  // Pa*256를 hPa로
     if (isValidPressure_hPa(p)) {
       sum += p;
       n++;
@@ -96,18 +191,19 @@ void calibrateBaroP0(uint32_t calibMs = 3000) {
     delay(20);
   }
   if (n > 10) g_p0_hPa = (float)(sum / (double)n);
+  g_altRef = baroAltRef(g_p0_hPa);
 }
 
 void updateBaro(FlightData& f, uint32_t nowMs) {
-  if (nowMs - g_baro_lastMs < BARO_PERIOD_MS) return;  // 주기 유지(20Hz)
-  g_baro_lastMs = nowMs;                               // 마지막 실행시간 갱신
-
+  // 새 변환이 끝났을 때만 갱신 (태스크 20Hz > 센서 약 10Hz -> 절반은 이전 샘플)
+  // 같은 값을 다시 넣으면 상승률이 0과 2배 값을 오가므로 건너뜀
+  if (bmp280BurstRead(g_bmpRd, nowMs) != BMP280_NEW) return;
   prevClimbRate = f.baro.climbRate;
-  float tempC = bmp.readTemperature();
-  float press_hPa = bmp.readPressure() / 100.0f;
+  float tempC = g_bmpRd.temp_c100 / 100.0f;
+  float press_hPa = g_bmpRd.press_q8 / 25600.0f;
   if (!isValidPressure_hPa(press_hPa)) return;  // 이상치 스킵
 
-  float alt_m = altitudeFromPressure(press_hPa, g_p0_hPa);  // 고도계산
+  float alt_m = altitudeFromPressure(press_hPa);  // 고도계산
 
   // 상승률 계산 + 1차 LPF
   float climb = f.baro.climbRate;
@@ -133,7 +229,7 @@ void updateBaro(FlightData& f, uint32_t nowMs) {
 // ============================================================================
 TinyGPSPlus gps;
 
-static const uint32_t GPS_PERIOD_MS = 500;  // 구조체 업데이트 주기(5Hz)
+static const uint32_t GPS_PERIOD_MS = 500;  // 구조체 업데이트 주기 (태스크 테이블 주기, 모듈 출력은 5Hz)
 static uint32_t g_gps_lastMs = 0;           // 마지막 구조체 반영 시각
 static uint32_t g_lastGpsUpdateMs = 0;      // 위/경도 실제 갱신 시각
 // 위/경도 정수변환
@@ -233,172 +329,193 @@ void updateGps(FlightData& f, uint32_t nowMs) {
 //    IMU + roll/pitch/yaw + filterRoll 갱신
 // ============================================================================
 
-// 패킷 구성 (변경 요)
-static const uint8_t SYNC1 = 0xA5;
-static const uint8_t SYNC2 = 0x5A;
-static const uint8_t VER = 1;
-static const uint8_t MSG = 0x21;
-static const uint8_t LEN = 20;
-
-// ====== CRC16 CCITT-FALSE ======
-static uint16_t crc16_ccitt(const uint8_t* data, size_t len) {
-  uint16_t crc = 0xFFFF;
-  for (size_t i = 0; i < len; i++) {
-    crc ^= (uint16_t)data[i] << 8;
-    for (int b = 0; b < 8; b++) {
-      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
-    }
-  }
-  return crc;
+// 패킷 구성/CRC16/LE 헬퍼는 linkProtocol.h (pinMain과 공용)
+
+LinkStats a2bStats = {};  // 링크 손실/지연 통계 (디버그 출력에서 확인)
+
+// ====== MSG별 payload 처리 ======
+static void handleA2B_Imu(const uint8_t* payload, FlightData& f) {
+  int idx = 0;
+
+  // accel: (m/s^2*10) -> m/s^2
+  int16_t ax10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t ay10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t az10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+
+  // gyro: (deg/s*10) -> deg/s
+  int16_t gx10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t gy10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t gz10 = rd_i16_le(&payload[idx]);
+  idx += 2;
+
+  // angles: (deg*100) -> deg
+  int16_t roll100 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t froll100 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t pitch100 = rd_i16_le(&payload[idx]);
+  idx += 2;
+  int16_t yaw100 = rd_i16_le(&payload[idx]);
+  idx += 2;
+
+  f.imu.ax = ax10 / 100.0f;
+  f.imu.ay = ay10 / 100.0f;
+  f.imu.az = az10 / 100.0f;
+
+  f.imu.gx = gx10 / 10.0f;
+  f.imu.gy = gy10 / 10.0f;
+  f.imu.gz = gz10 / 10.0f;
+
+  f.roll = roll100 / 100.0f;
+  f.filterRoll = froll100 / 100.0f;
+  f.pitch = pitch100 / 100.0f;
+  f.yaw = yaw100 / 100.0f;
+
+  logTyped(lrEncodeImu, f);  // 받은 프레임마다 (100Hz)
 }
 
-static inline uint16_t rd_u16_le(const uint8_t* p) {
-  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
-}
-static inline int16_t rd_i16_le(const uint8_t* p) {
-  return (int16_t)rd_u16_le(p);
-}
-static inline uint32_t rd_u32_le(const uint8_t* p) {
-  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+// 새 메시지는 여기 한 줄 추가 (MSG id, payload 길이, 처리 함수)
+typedef void (*A2BHandler)(const uint8_t* payload, FlightData& f);
+struct A2BMsgDef {
+  uint8_t msg;
+  uint8_t len;
+  A2BHandler handler;
+};
+static const A2BMsgDef A2B_MSG_TABLE[] = {
+  { A2B_MSG, A2B_LEN, handleA2B_Imu },
+};
+static const uint8_t A2B_MAX_LEN = 32;  // 테이블의 최대 payload 길이 이상
+
+static const A2BMsgDef* findA2BMsg(uint8_t msg) {
+  for (uint8_t i = 0; i < sizeof(A2B_MSG_TABLE) / sizeof(A2B_MSG_TABLE[0]); i++) {
+    if (A2B_MSG_TABLE[i].msg == msg) return &A2B_MSG_TABLE[i];
+  }
+  return nullptr;
 }
 
 // ====== Parser: call very often ======
+// 바이트가 들어오는 즉시 CRC 갱신 -> 마지막 CRC 2바이트 도착 시 바로 비교 (버퍼 복사 없음)
 void parseAtoB(Stream& link, FlightData& f, uint32_t nowB_ms) {
   enum { WAIT_S1,
          WAIT_S2,
          READ_HDR,
-         READ_BODY } static st = WAIT_S1;
+         READ_BODY,
+         READ_CRC } static st = WAIT_S1;
 
   // Header: VER(1) MSG(1) LEN(1) SEQ(2) TIME(4) = 9
-  static uint8_t hdr[9];
-  static uint8_t payload[LEN];
+  static uint8_t hdr[A2B_HDR_LEN];
+  static uint8_t payload[A2B_MAX_LEN];
   static uint8_t crcBytes[2];
+  static Crc16 crc;
+  static const A2BMsgDef* def = nullptr;
 
   static uint8_t hdrIdx = 0;
-  static uint16_t bodyIdx = 0;
+  static uint8_t bodyIdx = 0;
 
   while (link.available()) {
     uint8_t b = (uint8_t)link.read();
 
     switch (st) {
       case WAIT_S1:
-        if (b == SYNC1) st = WAIT_S2;
+        if (b == A2B_SYNC1) st = WAIT_S2;
+        else a2bStats.bytesSkipped++;
         break;
 
       case WAIT_S2:
-        if (b == SYNC2) {
+        if (b == A2B_SYNC2) {
           st = READ_HDR;
           hdrIdx = 0;
-        } else st = WAIT_S1;
+          crc.reset();
+        } else if (b != A2B_SYNC1) {  // A5 A5 5A 처럼 SYNC1이 반복되면 그대로 대기
+          a2bStats.bytesSkipped += 2;
+          st = WAIT_S1;
+        } else {
+          a2bStats.bytesSkipped++;
+        }
         break;
 
       case READ_HDR:
         hdr[hdrIdx++] = b;
+        crc.update(b);
         if (hdrIdx >= sizeof(hdr)) {
           uint8_t ver = hdr[0], msg = hdr[1], len = hdr[2];
-          if (ver != VER || msg != MSG || len != LEN) {
+          def = (ver == A2B_VER) ? findA2BMsg(msg) : nullptr;
+          if (def == nullptr || len != def->len) {
+            if (ver == A2B_VER && def == nullptr) a2bStats.unknownMsg++;
+            a2bStats.resyncs++;
             st = WAIT_S1;
             break;
           }
-          st = READ_BODY;
           bodyIdx = 0;
+          st = (len > 0) ? READ_BODY : READ_CRC;
         }
         break;
 
       case READ_BODY:
-        if (bodyIdx < LEN) {
-          payload[bodyIdx++] = b;
-        } else if (bodyIdx < (LEN + 2)) {
-          crcBytes[bodyIdx - LEN] = b;
-          bodyIdx++;
+        payload[bodyIdx++] = b;
+        crc.update(b);
+        if (bodyIdx >= def->len) {
+          bodyIdx = 0;
+          st = READ_CRC;
         }
+        break;
 
-        if (bodyIdx >= (LEN + 2)) {
-          // CRC buffer = hdr(9) + payload(LEN)
-          uint8_t crcBuf[9 + LEN];
-          memcpy(crcBuf, hdr, 9);
-          memcpy(crcBuf + 9, payload, LEN);
-
-          uint16_t crcCalc = crc16_ccitt(crcBuf, sizeof(crcBuf));
-          uint16_t crcRecv = rd_u16_le(crcBytes);
-
-          if (crcCalc == crcRecv) {
-            uint32_t timeA_ms = rd_u32_le(&hdr[5]);
-            f.aTimeMs = timeA_ms;
-            f.aRxTimeMs = nowB_ms;
-
-            int idx = 0;
-
-            // accel: (m/s^2*10) -> m/s^2
-            int16_t ax10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t ay10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t az10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-
-            // gyro: (deg/s*10) -> deg/s
-            int16_t gx10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t gy10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t gz10 = rd_i16_le(&payload[idx]);
-            idx += 2;
-
-            // angles: (deg*100) -> deg
-            int16_t roll100 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t froll100 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t pitch100 = rd_i16_le(&payload[idx]);
-            idx += 2;
-            int16_t yaw100 = rd_i16_le(&payload[idx]);
-            idx += 2;
-
-            f.imu.ax = ax10 / 100.0f;
-            f.imu.ay = ay10 / 100.0f;
-            f.imu.az = az10 / 100.0f;
-
-            f.imu.gx = gx10 / 10.0f;
-            f.imu.gy = gy10 / 10.0f;
-            f.imu.gz = gz10 / 10.0f;
-
-            f.roll = roll100 / 100.0f;
-            f.filterRoll = froll100 / 100.0f;
-            f.pitch = pitch100 / 100.0f;
-            f.yaw = yaw100 / 100.0f;
-          }
+      case READ_CRC:
+        crcBytes[bodyIdx++] = b;
+        if (bodyIdx < 2) break;
 
-          st = WAIT_S1;
+        st = WAIT_S1;
+        if (crc.value != rd_u16_le(crcBytes)) {
+          a2bStats.crcFail++;
+          break;
         }
+
+        linkStatsOnSeq(a2bStats, rd_u16_le(&hdr[3]));
+
+        f.aTimeMs = rd_u32_le(&hdr[5]);
+        f.aRxTimeMs = nowB_ms;
+        linkStatsOnAge(a2bStats, (int32_t)(f.aRxTimeMs - f.aTimeMs));
+        a2bStats.framesOk++;
+
+        def->handler(payload, f);
         break;
     }
   }
 }
 
+void printA2BStats() {
+  Serial.print(F(" | A2B ok="));
+  Serial.print(a2bStats.framesOk);
+  Serial.print(F(" crcErr="));
+  Serial.print(a2bStats.crcFail);
+  Serial.print(F(" resync="));
+  Serial.print(a2bStats.resyncs);
+  Serial.print(F(" unkMsg="));
+  Serial.print(a2bStats.unknownMsg);
+  Serial.print(F(" skip="));
+  Serial.print(a2bStats.bytesSkipped);
+  Serial.print(F(" gaps="));
+  Serial.print(a2bStats.seqGaps);
+  Serial.print(F(" lost="));
+  Serial.print(a2bStats.framesLost);
+  Serial.print(F(" age="));
+  Serial.print(a2bStats.ageLastMs);
+  Serial.print(F(" jitter="));
+  Serial.print(a2bStats.ageMaxMs - a2bStats.ageMinMs);
+  Serial.println();
+}
+
 // ============================================================================
 // 4) B2A UART 패킷 송신 (g_parachuteDeployed 전송)
 //    - Serial3로 핀보드(A보드)에 상태 전달
-//    - 프레임 + CRC16 CCITT-FALSE 사용(기존 crc16_ccitt 재사용)
+//    - 프레임 + CRC16 CCITT-FALSE 사용(linkProtocol.h)
 // ============================================================================
 
-static const uint8_t B2A_SYNC1 = 0xB5;
-static const uint8_t B2A_SYNC2 = 0x5B;
-static const uint8_t B2A_VER   = 1;
-static const uint8_t B2A_MSG   = 0x31;   // parachute status message
-static const uint8_t B2A_LEN   = 6;      // payload length
-
-static inline void wr_u16_le(uint8_t* p, uint16_t v) {
-  p[0] = (uint8_t)(v & 0xFF);
-  p[1] = (uint8_t)((v >> 8) & 0xFF);
-}
-static inline void wr_u32_le(uint8_t* p, uint32_t v) {
-  p[0] = (uint8_t)(v & 0xFF);
-  p[1] = (uint8_t)((v >> 8) & 0xFF);
-  p[2] = (uint8_t)((v >> 16) & 0xFF);
-  p[3] = (uint8_t)((v >> 24) & 0xFF);
-}
-
 // payload (6B):
 //  [0] deployed(1: true / 0: false)
 //  [1] reserved
@@ -406,7 +523,6 @@ static inline void wr_u32_le(uint8_t* p, uint32_t v) {
 void sendBtoA_ParachuteStatus(Stream& link, bool deployed, uint32_t nowMs) {
   uint8_t hdr[5];                 // VER(1) MSG(1) LEN(1) reserved(2) = 5
   uint8_t payload[B2A_LEN];
-  uint8_t crcBuf[5 + B2A_LEN];
 
   hdr[0] = B2A_VER;
   hdr[1] = B2A_MSG;
@@ -418,10 +534,11 @@ void sendBtoA_ParachuteStatus(Stream& link, bool deployed, uint32_t nowMs) {
   payload[1] = 0;
   wr_u32_le(&payload[2], nowMs);
 
-  memcpy(crcBuf, hdr, sizeof(hdr));
-  memcpy(crcBuf + sizeof(hdr), payload, sizeof(payload));
-
-  uint16_t crc = crc16_ccitt(crcBuf, sizeof(crcBuf));
+  // CRC over [VER..PAYLOAD] (복사 없이 이어서 계산)
+  Crc16 crc16;
+  crc16.update(hdr, sizeof(hdr));
+  crc16.update(payload, sizeof(payload));
+  uint16_t crc = crc16.value;
   uint8_t crcLe[2];
   wr_u16_le(crcLe, crc);
 
@@ -441,37 +558,54 @@ struct LogHeader {
 };
 #pragma pack(pop)
 
-// ================== 512B 버퍼링 ==================
-static uint8_t sdBuf[512];
-static uint16_t sdWp = 0;
+// ================== SD 로그 백엔드 ==================
+//  기본: 부팅 때 연속 할당한 파일에 512B 섹터를 블록 번호로 직접 씀 (sdRawLog.h)
+//        -> 비행 중 FAT/디렉터리 갱신 없음, 카드 busy를 기다리지 않음
+//  할당 실패(카드 용량/단편화) 시: 기존 File 경로. 단 512B가 다 찼을 때만 써서 섹터 정렬 유지
+//        (버퍼는 g_sdLog.buf[0]을 같이 씀)
+static const uint32_t SD_PREALLOC_BYTES = 64UL * 1024UL * 1024UL;     // 100Hz x 131B 기준 약 85분
+static const uint32_t SD_PREALLOC_MIN_BYTES = 4UL * 1024UL * 1024UL;  // 이보다 작게는 안 줄임
+
+Sd2Card g_sdCard;
+SdVolume g_sdVolume;
+SdFile g_sdRoot;
+SdRawLog g_sdLog;
+bool g_sdRaw = false;  // true: 연속 파일 블록 쓰기, false: File 경로
+
+// sdLogWrite가 len을 버리지 않고 받을 수 있는지 (File 경로는 항상 받음)
+bool sdLogCanWrite(uint16_t len) {
+  if (!g_sdRaw) return true;
+  sdRawService(g_sdLog);
+  return sdRawCanWrite(g_sdLog, len);
+}
 
-void sdLogWrite(const void* data, uint16_t len) {
-  const uint8_t* p = (const uint8_t*)data;
+// 반환: false = 버퍼가 다 차서 버림 (연속 파일 경로만)
+bool sdLogWrite(const void* data, uint16_t len) {
+  if (g_sdRaw) return sdRawWrite(g_sdLog, data, len);
 
-  if (len > sizeof(sdBuf)) {  // 안전장치
-    if (sdWp) {
-      logFile.write(sdBuf, sdWp);
-      sdWp = 0;
+  const uint8_t* p = (const uint8_t*)data;
+  uint8_t* buf = g_sdLog.buf[0];
+  while (len) {
+    uint16_t n = SD_RAW_BLOCK - g_sdLog.wp;
+    if (n > len) n = len;
+    memcpy(&buf[g_sdLog.wp], p, n);
+    g_sdLog.wp += n;
+    p += n;
+    len -= n;
+    if (g_sdLog.wp == SD_RAW_BLOCK) {
+      logFile.write(buf, SD_RAW_BLOCK);
+      g_sdLog.wp = 0;
     }
-    logFile.write(p, len);
-    return;
-  }
-
-  if (sdWp + len > sizeof(sdBuf)) {
-    logFile.write(sdBuf, sdWp);
-    sdWp = 0;
   }
-
-  memcpy(&sdBuf[sdWp], p, len);
-  sdWp += len;
+  return true;
 }
 
 void sdLogFlush() {
-  if (sdWp) {
-    logFile.write(sdBuf, sdWp);
-    sdWp = 0;
+  if (g_sdRaw) {
+    sdRawFlush(g_sdLog);
+    return;
   }
-  logFile.flush();
+  logFile.flush();  // 다 찬 섹터까지만 (부분 섹터는 버퍼에 남김)
 }
 
 // ================== 부팅마다 새 파일 생성(삭제 없음) ==================
@@ -501,24 +635,345 @@ bool openNewLogFile() {
   }
   if (!found) return false;
 
-  logFile = SD.open(name, FILE_WRITE);
-  if (!logFile) return false;
+  // SD.begin()과 같은 카드를 저수준 클래스로 한 번 더 엶 (SdVolume 캐시는 공유)
+  g_sdRaw = g_sdCard.init(SPI_FULL_SPEED, SD_CS_PIN) && g_sdVolume.init(&g_sdCard) &&
+            g_sdRoot.openRoot(&g_sdVolume) &&
+            sdRawCreate(g_sdLog, g_sdCard, g_sdRoot, name, SD_PREALLOC_BYTES, SD_PREALLOC_MIN_BYTES);
+  if (!g_sdRaw) {
+    memset(&g_sdLog, 0, sizeof(g_sdLog));
+    logFile = SD.open(name, FILE_WRITE);
+    if (!logFile) return false;
+  }
 
   writeBootIndex((idx + 1) % 10000);
 
-  LogHeader hdr{ { 'R', 'L', 'G', '1' }, 1, (uint16_t)sizeof(FlightData) };
-  logFile.write((uint8_t*)&hdr, sizeof(hdr));
-  logFile.flush();
+  // 헤더도 같은 버퍼로 -> 이후 섹터가 전부 512B 정렬
+  static const uint16_t LOG_VERSIONS[] = { 1, LOGC_VERSION, LR_VERSION, LF_VERSION };
+  LogHeader hdr{ { 'R', 'L', 'G', '1' }, LOG_VERSIONS[LOG_FORMAT - 1], (uint16_t)sizeof(FlightData) };
+  sdLogWrite(&hdr, sizeof(hdr));
+  sdLogFlush();
 
   Serial.print("LOG FILE: ");
-  Serial.println(name);
+  Serial.print(name);
+  if (g_sdRaw) {
+    Serial.print(" contiguous ");
+    Serial.print(sdRawCapacityBytes(g_sdLog) >> 20);
+    Serial.println("MB");
+  } else {
+    Serial.println(" (FAT fallback)");
+  }
+
+  // 프로파일 기록은 없어도 비행에는 지장 없음
+  snprintf(name, sizeof(name), "PF%04u.CSV", idx);
+  profFile = SD.open(name, FILE_WRITE);
+  if (profFile) {
+    profCsvHeader(profFile);
+    profFile.flush();
+  }
 
   return true;
 }
 
 
 
+// ============================================================================
+// 5) 1Hz 디버그 출력
+// ============================================================================
+void printDebugStatus(uint32_t nowMs) {
+  uint32_t ageA = (flight.aRxTimeMs == 0) ? 0xFFFFFFFFUL : (nowMs - flight.aRxTimeMs);
+
+  Serial.print(F("ageA_ms="));
+  Serial.print(ageA);
+  Serial.print(F(" roll="));
+  Serial.print(flight.roll, 2);
+  Serial.print(F(" fRoll="));
+  Serial.print(flight.filterRoll, 2);
+  Serial.print(F(" pitch="));
+  Serial.print(flight.pitch, 2);
+  Serial.print(F(" yaw="));
+  Serial.print(flight.yaw, 2);
+
+  Serial.print(F(" | ax="));
+  Serial.print(flight.imu.ax, 1);
+  Serial.print(F(" ay="));
+  Serial.print(flight.imu.ay, 1);
+  Serial.print(F(" az="));
+  Serial.print(flight.imu.az, 1);
+
+  Serial.print(F(" | gx="));
+  Serial.print(flight.imu.gx, 1);
+  Serial.print(F(" gy="));
+  Serial.print(flight.imu.gy, 1);
+  Serial.print(F(" gz="));
+  Serial.print(flight.imu.gz, 1);
+
+  Serial.println();
+
+  Serial.print(F(" | Connect ="));
+  Serial.print(pinDetached);
+  Serial.print(F(" parachute ="));
+  Serial.print(g_parachuteDeployed);
+
+  Serial.print(F(" | Baro Alt="));
+  Serial.print(flight.baro.altitude, 2);
+  Serial.print(F(" climbRate ="));
+  Serial.print(flight.baro.climbRate, 2);
+  Serial.print(F(" | KF h="));
+  Serial.print(flight.est.altitude, 2);
+  Serial.print(F(" v="));
+  Serial.print(flight.est.velocity, 2);
+  Serial.print(F(" sdV="));
+  Serial.print(sqrt(flight.est.velVar), 2);
+  Serial.print(F(" | bmp new="));
+  Serial.print(g_bmpRd.st.fresh);
+  Serial.print(F(" stale="));
+  Serial.print(g_bmpRd.st.stale);
+  Serial.print(F(" fail="));
+  Serial.print(g_bmpRd.st.fails);
+
+  Serial.print(F(" | GPS fix="));
+  Serial.print(flight.gps.fix);
+  Serial.print(F(" sats="));
+  Serial.print(flight.gps.sats);
+  Serial.print(F(" latE7="));
+  Serial.print(flight.gps.latitudeE7);
+  Serial.print(F(" lonE7="));
+  Serial.print(flight.gps.longitudeE7);
+  Serial.println();
+
+  printA2BStats();
+  if (g_sdRaw) sdRawPrintStats(Serial, g_sdLog);
+  loraTxPrintStats(Serial, g_loraTx);
+  loraRxPrintStats(Serial, g_loraLine, g_loraRxSt);
+#if LOG_FORMAT >= 3
+  Serial.print(F("log mode="));
+  Serial.print(g_logMode == LOG_PRE ? F("PRE") : (g_logMode == LOG_DRAIN ? F("DRAIN") : F("LIVE")));
+  Serial.print(F(" ring="));
+  Serial.print(g_preRing.used);
+  Serial.print('/');
+  Serial.print(PRE_RING_BYTES);
+  Serial.print(F(" evict="));
+  Serial.print(g_preRing.evicted);
+  Serial.print(F(" drop="));
+  Serial.println(g_preRing.dropped);
+#endif
+#if LOG_FORMAT == 2
+  Serial.print(F("log rec="));
+  Serial.print(g_logEnc.records);
+  Serial.print(F(" key="));
+  Serial.print(g_logEnc.keys);
+  Serial.print(F(" avgB="));
+  Serial.print(g_logEnc.records ? (float)g_logEnc.outBytes / g_logEnc.records : 0.0f, 1);
+  Serial.print(F(" ratio="));
+  Serial.println(g_logEnc.outBytes ? (float)g_logEnc.rawBytes / g_logEnc.outBytes : 0.0f, 2);
+#endif
+#if defined(__AVR__)
+  Serial.print(F("stack margin="));
+  Serial.println(stackMarginBytes());
+#endif
+}
+
+// ============================================================================
+// 6) 태스크 테이블 (taskScheduler.h)
+//    - 주기 0 : 폴링. 매 패스 먼저 실행 -> UART 수신 버퍼(64B)가 넘치기 전에 비움
+//               마감 = 허용 호출 간격 (버퍼가 차는 시간보다 짧게)
+//    - 주기 태스크 : 도래한 것 중 우선순위 가장 높은 것 하나만 돌고 다시 폴링으로
+//    - 우선순위는 rate-monotonic (주기 짧을수록 높음)
+// ============================================================================
+static void taskGpsRx(uint32_t) {
+  while (Serial1.available()) gps.encode(Serial1.read());
+}
+static void taskA2B(uint32_t nowMs) {
+  parseAtoB(Serial3, flight, nowMs);  // A2B 패킷은 가능한 자주 파싱
+}
+static void taskLoraRx(uint32_t) {
+  handleLoraRxCommand();  // 지상국 명령 수신 + AT 응답
+  serviceLoraTx();        // 송신 큐 (블로킹 없이 빈자리만큼)
+}
+// 발사 감지 -> 링 내보내기 시작. A2B가 죽어 launchTimeStarted가 안 켜져도
+// 커넥트핀 분리나 상태 전이(센서 고장 포함)면 바로 전체 기록으로
+static void logModeUpdate() {
+  if (g_logMode != LOG_PRE) return;
+  if (launchTimeStarted || pinDetached || flight.state != STANDBY) g_logMode = LOG_DRAIN;
+}
+
+// 상태 전이 / 사출 / 최고고도 판단을 이벤트 레코드로 (LoRa 사출 명령도 여기서 잡힘)
+static void logFlightEvents() {
+  static FlightState lastState = STANDBY;
+  static bool deployLogged = false, armLogged = false, detectLogged = false;
+  if (flight.state != lastState) {
+    lastState = flight.state;
+    logEvent(EV_STATE, flight.state);
+  }
+  if (g_parachuteDeployed && !deployLogged) {
+    deployLogged = true;
+    logEvent(EV_DEPLOY, 0);
+  }
+  if (flight.apo.armMs && !armLogged) {
+    armLogged = true;
+    logEvent(EV_APO_ARM, flight.apo.predMs);
+  }
+  if (flight.apo.detectMs && !detectLogged) {
+    detectLogged = true;
+    logEvent(EV_APO_DETECT, 0);
+  }
+}
+
+static void taskLogic(uint32_t nowMs) {
+  flightLogicStep(g_altEst, nowMs);  // 커넥트핀, 고도 추정, 판단/전이, 사출 FSM (parachute.ino)
+
+  // // ========================
+  // // B -> A : parachute 상태 전송 (변화 시 버스트)
+  // // ========================
+  // // if (!lastParachute && g_parachuteDeployed) {
+  // //   // false -> true 변화를 감지
+  // //   b2aBurst = true;
+  // //   b2aBurstStartMs = nowMs;
+  // //   b2aLastSendMs = 0; // 즉시 한 번 보내기 위해 리셋
+  // // }
+
+  // // lastParachute = g_parachuteDeployed;
+
+  // // // 버스트 재전송: 0.5초 동안 10Hz로만
+  // // if (b2aBurst) {
+  // //   if (b2aLastSendMs == 0 || (nowMs - b2aLastSendMs) >= 100) { // 100ms = 10Hz
+  // //     b2aLastSendMs = nowMs;
+  // //     sendBtoA_ParachuteStatus(Serial3, true, millis());
+  // //   }
+  // //   if (nowMs - b2aBurstStartMs >= 500) { // 0.5초 후 종료 (대략 5회)
+  // //     b2aBurst = false;
+  // //   }
+  // // }
+
+  logModeUpdate();  // 발사 감지한 그 주기부터 이벤트도 링 뒤로 (시간 순서 유지)
+  logFlightEvents();
+}
+static void taskBaro(uint32_t nowMs) {
+  uint32_t prevMs = flight.baroTimeMs;
+  updateBaro(flight, nowMs);
+  if (flight.baroTimeMs != prevMs) logTyped(lrEncodeBaro, flight);  // 새 샘플만
+}
+static void taskLog(uint32_t nowMs) {
+  if (g_sdRaw) sdRawService(g_sdLog);  // 쓸 레코드가 없어도 대기 중인 섹터는 내보냄
+#if LOG_FORMAT >= 3
+  logModeUpdate();
+  if (g_logMode == LOG_DRAIN) logDrainRing();
+  static uint32_t lastStatusMs = 0;
+  if (g_logMode == LOG_PRE) {
+    if (nowMs - lastStatusMs < LOG_HEARTBEAT_MS) return;
+    lastStatusMs = nowMs;
+    logTyped(lrEncodeStatus, flight, true);  // 하트비트
+    if (flight.baroTimeMs) logTyped(lrEncodeBaro, flight, true);
+    if (flight.gps.fix) logTyped(lrEncodeGps, flight, true);
+    return;
+  }
+  if (nowMs - lastStatusMs < LOG_STATUS_PERIOD_MS) return;
+  lastStatusMs = nowMs;
+  logTyped(lrEncodeStatus, flight);
+#elif LOG_FORMAT == 2
+  uint8_t rec[LOGC_MAX_REC];
+  uint8_t n = logEncode(g_logEnc, flight, rec);
+  if (!sdLogWrite(rec, n)) logEncForceKey(g_logEnc);  // 델타 사슬이 끊김 -> 다음은 키프레임
+#else
+  sdLogWrite((const void*)&flight, (uint16_t)sizeof(FlightData));
+#endif
+}
+static void taskGps(uint32_t nowMs) {
+  bool newLoc = gps.location.isUpdated();  // updateGps()가 lat()을 읽으면 지워짐
+  updateGps(flight, nowMs);
+  if (newLoc && flight.gps.fix) logTyped(lrEncodeGps, flight);
+}
+static void taskLoraTx(uint32_t) {
+  sendLoraFromFlight(flight, g_parachuteDeployed, pinDetached);
+}
+static void taskDebug(uint32_t nowMs);
+static void taskFlush(uint32_t nowMs) {
+  // File 경로는 flush마다 FAT/디렉터리 엔트리까지 다시 써서 수십 ms 멈춤 -> 예전 주기대로
+  static uint32_t lastFatFlushMs = 0;
+  if (!g_sdRaw) {
+    if (nowMs - lastFatFlushMs < FAT_FLUSH_PERIOD_MS) return;
+    lastFatFlushMs = nowMs;
+  }
+  sdLogFlush();
+}
+static void taskProf(uint32_t nowMs);
+static void taskUsbCmd(uint32_t);
+
+Task g_tasks[] = {
+  // name      fn          periodUs                         prio  deadlineUs                       releaseUs st
+  { "gpsRx",   taskGpsRx,  0,                               0,    50000,                           0, {} },  // 9600bps: 64B = 66ms
+  { "a2b",     taskA2B,    0,                               0,    5000,                            0, {} },  // 115200bps: 64B = 5.5ms
+  { "loraRx",  taskLoraRx, 0,                               0,    50000,                           0, {} },  // 9600bps
+  { "logic",   taskLogic,  FLIGHT_LOGIC_PERIOD_MS * 1000UL, 1,    FLIGHT_LOGIC_PERIOD_MS * 1000UL, 0, {} },
+  { "log",     taskLog,    LOG_PERIOD_MS * 1000UL,          2,    LOG_PERIOD_MS * 1000UL,          0, {} },
+  { "baro",    taskBaro,   BARO_PERIOD_MS * 1000UL,         3,    BARO_PERIOD_MS * 1000UL,         0, {} },
+  { "loraTx",  taskLoraTx, LORA_PERIOD_MS * 1000UL,         4,    LORA_PERIOD_MS * 1000UL,         0, {} },
+  { "usbCmd",  taskUsbCmd, 200000UL,                        5,    200000UL,                        0, {} },
+  { "gps",     taskGps,    GPS_PERIOD_MS * 1000UL,          6,    GPS_PERIOD_MS * 1000UL,          0, {} },
+  { "debug",   taskDebug,  1000000UL,                       7,    1000000UL,                       0, {} },
+  { "flush",   taskFlush,  FLUSH_PERIOD_MS * 1000UL,        8,    FLUSH_PERIOD_MS * 1000UL,        0, {} },
+  { "prof",    taskProf,   PROF_PERIOD_MS * 1000UL,         9,    PROF_PERIOD_MS * 1000UL,         0, {} },
+};
+static const uint8_t NUM_TASKS = sizeof(g_tasks) / sizeof(g_tasks[0]);
+
+// ====== 루프 프로파일 (loopProfiler.h) ======
+// 태스크별 실행 시간은 스케줄러가 히스토그램으로 누적, 여기선 loop() 한 패스 전체
+ProfStage g_loopProf = { "loop", {} };
+
+static void printProfile() {
+  schedPrintStats(Serial, g_tasks, NUM_TASKS);
+#if LOOP_PROFILE
+  schedPrintHist(Serial, g_tasks, NUM_TASKS);
+  profPrintHist(Serial, g_loopProf.name, g_loopProf.h);
+  if (g_sdRaw) profPrintHist(Serial, "sdWr", g_sdLog.st.wr);
+#endif
+}
+
+static void resetProfile() {
+  for (uint8_t i = 0; i < NUM_TASKS; i++) {
+#if LOOP_PROFILE
+    profResetHist(g_tasks[i].st.hist);
+#endif
+  }
+  profResetHist(g_loopProf.h);
+}
+
+// PROF_PERIOD_MS마다 지난 구간의 히스토그램을 SD에 남기고 새 구간 시작
+// CSV는 FAT 파일이라 발사 후~착지 전에는 쓰지 않음 (히스토그램은 계속 누적)
+static void taskProf(uint32_t nowMs) {
+#if LOOP_PROFILE
+  bool inFlight = flight.state != STANDBY && flight.state != LANDED;
+  if (inFlight) return;
+  if (profFile) {
+    schedCsvHist(profFile, nowMs, g_tasks, NUM_TASKS);
+    profCsvHist(profFile, nowMs, g_loopProf.name, g_loopProf.h);
+    profFile.flush();
+  }
+#endif
+  resetProfile();
+}
+
+// USB 시리얼 한 글자 명령: p = 프로파일 출력, r = 리셋
+static void taskUsbCmd(uint32_t) {
+  while (Serial.available()) {
+    char c = (char)Serial.read();
+    if (c == 'p') printProfile();
+    else if (c == 'r') resetProfile();
+  }
+}
+
+static void taskDebug(uint32_t nowMs) {
+  printDebugStatus(nowMs);
+
+  static uint8_t n = 0;  // 스케줄러 통계는 10초마다
+  if (++n >= 10) {
+    n = 0;
+    schedPrintStats(Serial, g_tasks, NUM_TASKS);
+  }
+}
+
 void setup() {
+  stackPaint();  // 부팅 후 최소 스택 여유 측정용 (디버그 출력 stack margin=)
 
   Serial.begin(115200);
   // A2B 링크: Serial3 (B: RX3=15, TX3=14)
@@ -561,12 +1016,17 @@ void setup() {
       ;
   }
 
+#if LOG_FORMAT == 2
+  logEncInit(g_logEnc, LOG_KEYFRAME_EVERY);
+#endif
+  preRingInit(g_preRing);
   if (!openNewLogFile()) {
     Serial.println("log file open failed!");
     while (1)
       ;
   }
 
+  logEvent(EV_BOOT, (uint32_t)(g_p0_hPa * 1000.0f));  // 기준압 p0 (hPa x1000)
   Serial.println("SD logging started.");
 
   //낙하산
@@ -575,233 +1035,14 @@ void setup() {
 
   flight.state = STANDBY;
   //jc = {};
+
+  schedInit(g_tasks, NUM_TASKS);
 }
 
 void loop() {
-  uint32_t nowMs = millis();
-  flight.timeMs = nowMs;
-  while (Serial1.available())
-      gps.encode(Serial1.read());
-
-  handleLoraRxCommand();  // 지상국 명령 수신
-  // // if(Serial2.available())
-  // //   Serial.println("asdfasdf");
-
-  // // 1) A2B 패킷은 가능한 자주 파싱
- parseAtoB(Serial3, flight, nowMs);
-
-  // // 2) 센서 갱신
-   updateBaro(flight, nowMs);
-   updateGps(flight, nowMs);
-  // //Serial2.print("AT+SEND=1,1,1");
-
-  // // if(Serial2.available())
-  // // Serial.write(Serial2.read());
-  // // if(Serial.available())
-  // // Serial2.write(Serial.read());
-
-   sendLoraFromFlight(flight, g_parachuteDeployed, pinDetached);
-
-  if (!pinDetached) {
-    pinDetached = isConnectOrDeteached(PIN_CONNECT_DETECT);
-  }
-
-  // ========================
-  // // 4. 판단 및 상태 전이
-  // // ========================
-  // ==============시간 측정 시작(커넥트핀 분리 && imu 가속도값)==========
-  if (!launchTimeStarted && pinDetached 
-      && ((flight.imu.ax) * (flight.imu.ax) +
-         (flight.imu.ay) * (flight.imu.ay) + 
-         (flight.imu.az) * (flight.imu.az) >  
-         (9.8 * 1.2) * (9.8 * 1.2))) { //이거 나중에 수정해야 함
-    launchTimeStarted = true;
-    launchTimeMs = millis();  // T0
-    Serial.println("발사 시간 측정!");
-  }
-
-  // ========================센서 이상치 판단==========
-
-  bool imuOMG = isOMGimu(flight.imu);
-  bool baroOMG = isOMGbaro(flight.baro);
-
-  // 2) ⛔ 센서 고장 시 APOGEE 강제 전이 (여기!)
-  if ((imuOMG || baroOMG) && flight.state < APOGEE) {
-    flight.state = APOGEE;
-    Serial.println("센서 고장");
-
-    // 중요: 하강 판단 누적값 리셋(권장)
-    resetDecisionCounters(jc);
-  }
-
-  //================== 기본 판단 신호====================
-
-  bool accelOver = (!imuOMG) && isAccelOver(flight.imu);
-
-  bool altitudeUp = (!baroOMG) && isAltitudeUp(flight.baro);      // 상승 증거
-  bool altitudeDown = (!baroOMG) && isAltitudeDown(flight.baro);  // 하강 증거
-  bool powered = isPowered(accelOver, altitudeUp, jc);
-  bool motorOver = isMotorOver(powered, jc);
-  bool apogee = (flight.state < APOGEE) && altitudeUp;
-  bool descent = (flight.state == APOGEE) && altitudeDown;
-  // ========================
-
-  // 4) 상태머신 갱신
-
-  updateFlightState(
-    flight,
-    launchTimeStarted,
-    powered,
-    motorOver,
-    apogee,
-    descent,
-    jc);
-
-  /*===================== 낙하산 사출 함수=================
-      1. 발사 10초 뒤 낙하산 사출
-      2. 하강 30회 시 낙하산 사출(데이터 중복 가능성)
-      =================================================*/
-
-  if (launchTimeStarted && !deployCtl.deployed) {
-    bool isCount = false;
-    unsigned long flightTimeMs = millis() - launchTimeMs;
-
-    if (flightTimeMs >= 1000000 && !g_parachuteDeployed) {  // 1,000ms = 10초
-      Serial.println("낙하산 사출! - 10초 조건");
-      deployCtl.state = DEPLOY_PUNCH;
-      g_parachuteDeployed = true;
-    }
-
-    if(descent)
-    {
-      deployCtl.state = DEPLOY_PUNCH;
-      g_parachuteDeployed = true;
-      Serial.println("낙하산 사출! - 고도 하강");
-    }
-    // if(prevClimbRate !=  flight.baro.climbRate) {
-    // if(flight.baro.climbRate < -2) //하강 시 카운트 +1
-    //   jc.count++;
-    // else{
-    //   if(jc.count > 0) //상승중이면 count가 0이상일 때만 count 1 감소
-    //   jc.count--;
-    // }
-    // prevClimbRate = flight.baro.climbRate;
-    // }
-
-    // if(jc.count > 20 && !g_parachuteDeployed ){ //낙하산 사출
-    //   deployCtl.state = DEPLOY_PUNCH;
-    //   g_parachuteDeployed = true;
-    //   Serial.println("낙하산 사출! - 고도 하강");
-    //   }
-
-  }
-
-  // // ========================
-  // // B -> A : parachute 상태 전송 (변화 시 버스트)
-  // // ========================
-  // // if (!lastParachute && g_parachuteDeployed) {
-  // //   // false -> true 변화를 감지
-  // //   b2aBurst = true;
-  // //   b2aBurstStartMs = nowMs;
-  // //   b2aLastSendMs = 0; // 즉시 한 번 보내기 위해 리셋
-  // // }
-
-  // // lastParachute = g_parachuteDeployed;
-
-  // // // 버스트 재전송: 0.5초 동안 10Hz로만
-  // // if (b2aBurst) {
-  // //   if (b2aLastSendMs == 0 || (nowMs - b2aLastSendMs) >= 100) { // 100ms = 10Hz
-  // //     b2aLastSendMs = nowMs;
-  // //     sendBtoA_ParachuteStatus(Serial3, true, millis());
-  // //   }
-  // //   if (nowMs - b2aBurstStartMs >= 500) { // 0.5초 후 종료 (대략 5회)
-  // //     b2aBurst = false;
-  // //   }
-  // // }
-
-  // // ========= 낙하산 서보 FSM 실행 ========================
-
-   applyParachuteDeployState();
-
-  static uint32_t lastLog = 0;
-  static uint32_t lastFlush = 0;
-  static uint32_t lastDebugPrint = 0;
-
-  
-
-  //   //sd
-    static uint32_t lastLogMs = 0;
-
-    if (nowMs - lastLog >= LOG_PERIOD_MS) {
-      lastLog = nowMs;
-
-      // memcpy(버퍼로 복사) 동안만 인터럽트 잠깐 막아서 레코드 찢김 방지
-      sdLogWrite((const void*)&flight, (uint16_t)sizeof(FlightData));
-    }
-
-    // 1초마다 flush
-
-    if (nowMs - lastFlush >= FLUSH_PERIOD_MS) {
-      lastFlush = nowMs;
-      sdLogFlush();
-    }
-
-  //   // while (Serial1.available())
-  //   //   gps.encode(Serial1.read());
-  
-
-    if (nowMs - lastDebugPrint >= 1000) {
-      lastDebugPrint = nowMs;
-
-      uint32_t ageA = (flight.aRxTimeMs == 0) ? 0xFFFFFFFFUL : (nowMs - flight.aRxTimeMs);
-
-      Serial.print("ageA_ms=");
-      Serial.print(ageA);
-      Serial.print(" roll=");
-      Serial.print(flight.roll, 2);
-      Serial.print(" fRoll=");
-      Serial.print(flight.filterRoll, 2);
-      Serial.print(" pitch=");
-      Serial.print(flight.pitch, 2);
-      Serial.print(" yaw=");
-      Serial.print(flight.yaw, 2);
-
-      Serial.print(" | ax=");
-      Serial.print(flight.imu.ax, 1);
-      Serial.print(" ay=");
-      Serial.print(flight.imu.ay, 1);
-      Serial.print(" az=");
-      Serial.print(flight.imu.az, 1);
-
-      Serial.print(" | gx=");
-      Serial.print(flight.imu.gx, 1);
-      Serial.print(" gy=");
-      Serial.print(flight.imu.gy, 1);
-      Serial.print(" gz=");
-      Serial.print(flight.imu.gz, 1);
-
-      Serial.println();
-
-      Serial.print(" | Connect =");
-      Serial.print(pinDetached);
-      Serial.print(" parachute =");
-      Serial.print(g_parachuteDeployed);
-
-      Serial.print(" | Baro Alt=");
-      Serial.print(flight.baro.altitude, 2);
-      Serial.print(" climbRate =");
-      Serial.print(flight.baro.climbRate, 2);
-
-      Serial.print(" | GPS fix=");
-      Serial.print(flight.gps.fix);
-      Serial.print(" sats=");
-      Serial.print(flight.gps.sats);
-      Serial.print(" latE7=");
-      Serial.print(flight.gps.latitudeE7);
-      Serial.print(" lonE7=");
-      Serial.print(flight.gps.longitudeE7);
-      Serial.println();
-    }
+  PROF_SCOPE(g_loopProf);
+  flight.timeMs = millis();
+  schedRunOnce(g_tasks, NUM_TASKS);
 
   //   static unsigned long lastPrint = 0;
   // if (millis() - lastPrint > 1000) {   // 1초마다 출력
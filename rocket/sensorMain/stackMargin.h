@@ -0,0 +1,42 @@
+#ifndef STACK_MARGIN_H
+#define STACK_MARGIN_H
+
+// ============================================================================
+// 스택 여유 측정 (헤더 온리, AVR)
+//  - setup 처음에 stackPaint(): 힙 끝 ~ 지금 스택 사이를 STACK_PAINT로 칠함
+//  - stackMarginBytes(): 힙 끝부터 칠이 그대로 남은 바이트 수
+//    = 부팅 후 스택(과 힙)이 한 번도 닿지 않은 최소 여유. 수백 B 아래면 링/버퍼를 줄일 것
+//  - 호스트 시뮬레이터엔 없는 값이라 0xFFFF
+// ============================================================================
+
+#include <Arduino.h>
+#include <stdint.h>
+
+static const uint8_t STACK_PAINT = 0xA5;
+
+#if defined(__AVR__)
+extern char __heap_start;
+extern char* __brkval;
+
+static inline uint8_t* stackHeapEnd() {
+  return (uint8_t*)(__brkval ? __brkval : &__heap_start);
+}
+
+static inline void stackPaint() {
+  uint8_t here;
+  for (uint8_t* p = stackHeapEnd(); p < &here - 32; p++) *p = STACK_PAINT;  // 지금 프레임 근처는 남김
+}
+
+static inline uint16_t stackMarginBytes() {
+  const uint8_t* p = stackHeapEnd();
+  const uint8_t* sp = (const uint8_t*)SP;
+  uint16_t n = 0;
+  while (p + n < sp && p[n] == STACK_PAINT) n++;
+  return n;
+}
+#else
+static inline void stackPaint() {}
+static inline uint16_t stackMarginBytes() { return 0xFFFF; }
+#endif
+
+#endif